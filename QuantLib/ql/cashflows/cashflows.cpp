@@ -523,6 +523,178 @@ namespace QuantLib {
         bps = basisPoint_ * bps / d;
     }
 
+    // compiled legs
+
+    Size CashFlows::compiledDiscounts(const CompiledLeg& leg,
+                                      const YieldTermStructure& discountCurve,
+                                      bool includeSettlementDateFlows,
+                                      const Date& settlementDate) {
+        leg.calculate();
+
+        // same logic as CashFlow::hasOccurred and
+        // CashFlow::tradingExCoupon, applied to the compiled dates
+        bool includeRefDate = includeSettlementDateFlows;
+        if (settlementDate == Settings::instance().evaluationDate()) {
+            boost::optional<bool> includeToday =
+                Settings::instance().includeTodaysCashFlows();
+            if (includeToday)
+                includeRefDate = *includeToday;
+        }
+
+        // the alive cash flows and their times are collected...
+        Size n = 0;
+        for (Size i=0; i<leg.size(); ++i) {
+            const Date& d = leg.dates_[i];
+            bool occurred = d < settlementDate ||
+                            (d == settlementDate && !includeRefDate);
+            const Date& ecd = leg.exCouponDates_[i];
+            bool exCoupon = ecd != Date() && ecd <= settlementDate;
+            if (!occurred && !exCoupon) {
+                leg.alive_[n] = i;
+                leg.times_[n] = discountCurve.timeFromReference(d);
+                ++n;
+            }
+        }
+        // ...and discounted together
+        if (n > 0)
+            discountCurve.discount(&leg.times_[0], &leg.discounts_[0], n);
+        return n;
+    }
+
+    Real CashFlows::npv(const CompiledLeg& leg,
+                        const YieldTermStructure& discountCurve,
+                        bool includeSettlementDateFlows,
+                        Date settlementDate,
+                        Date npvDate) {
+
+        if (leg.empty())
+            return 0.0;
+
+        if (settlementDate == Date())
+            settlementDate = Settings::instance().evaluationDate();
+
+        if (npvDate == Date())
+            npvDate = settlementDate;
+
+        Size n = compiledDiscounts(leg, discountCurve,
+                                   includeSettlementDateFlows,
+                                   settlementDate);
+        Real totalNPV = 0.0;
+        for (Size k=0; k<n; ++k) {
+            Size i = leg.alive_[k];
+            Real amount = leg.amounts_[i] != Null<Real>() ?
+                          leg.amounts_[i] : leg.leg_[i]->amount();
+            totalNPV += amount * leg.discounts_[k];
+        }
+
+        return totalNPV/discountCurve.discount(npvDate);
+    }
+
+    Real CashFlows::bps(const CompiledLeg& leg,
+                        const YieldTermStructure& discountCurve,
+                        bool includeSettlementDateFlows,
+                        Date settlementDate,
+                        Date npvDate) {
+
+        if (leg.empty())
+            return 0.0;
+
+        if (settlementDate == Date())
+            settlementDate = Settings::instance().evaluationDate();
+
+        if (npvDate == Date())
+            npvDate = settlementDate;
+
+        Size n = compiledDiscounts(leg, discountCurve,
+                                   includeSettlementDateFlows,
+                                   settlementDate);
+        Real bps = 0.0;
+        for (Size k=0; k<n; ++k) {
+            Size i = leg.alive_[k];
+            if (leg.isCoupon_[i])
+                bps += leg.nominals_[i] * leg.accrualPeriods_[i] *
+                       leg.discounts_[k];
+        }
+
+        return basisPoint_*bps/discountCurve.discount(npvDate);
+    }
+
+    void CashFlows::npvbps(const CompiledLeg& leg,
+                           const YieldTermStructure& discountCurve,
+                           bool includeSettlementDateFlows,
+                           Date settlementDate,
+                           Date npvDate,
+                           Real& npv,
+                           Real& bps) {
+
+        npv = 0.0;
+        bps = 0.0;
+        if (leg.empty())
+            return;
+
+        if (settlementDate == Date())
+            settlementDate = Settings::instance().evaluationDate();
+
+        if (npvDate == Date())
+            npvDate = settlementDate;
+
+        Size n = compiledDiscounts(leg, discountCurve,
+                                   includeSettlementDateFlows,
+                                   settlementDate);
+        for (Size k=0; k<n; ++k) {
+            Size i = leg.alive_[k];
+            Real df = leg.discounts_[k];
+            Real amount = leg.amounts_[i] != Null<Real>() ?
+                          leg.amounts_[i] : leg.leg_[i]->amount();
+            npv += amount * df;
+            if (leg.isCoupon_[i])
+                bps += leg.nominals_[i] * leg.accrualPeriods_[i] * df;
+        }
+        DiscountFactor d = discountCurve.discount(npvDate);
+        npv /= d;
+        bps = basisPoint_ * bps / d;
+    }
+
+    void CashFlows::npvbps(
+                    const std::vector<boost::shared_ptr<CompiledLeg> >& legs,
+                    const YieldTermStructure& discountCurve,
+                    bool includeSettlementDateFlows,
+                    Date settlementDate,
+                    Date npvDate,
+                    std::vector<Real>& npvs,
+                    std::vector<Real>& bps) {
+
+        npvs.resize(legs.size());
+        bps.resize(legs.size());
+
+        if (settlementDate == Date())
+            settlementDate = Settings::instance().evaluationDate();
+
+        if (npvDate == Date())
+            npvDate = settlementDate;
+
+        DiscountFactor d = discountCurve.discount(npvDate);
+        for (Size j=0; j<legs.size(); ++j) {
+            const CompiledLeg& leg = *legs[j];
+            Real npv = 0.0, legBps = 0.0;
+            Size n = leg.empty() ? 0 :
+                compiledDiscounts(leg, discountCurve,
+                                  includeSettlementDateFlows,
+                                  settlementDate);
+            for (Size k=0; k<n; ++k) {
+                Size i = leg.alive_[k];
+                Real df = leg.discounts_[k];
+                Real amount = leg.amounts_[i] != Null<Real>() ?
+                              leg.amounts_[i] : leg.leg_[i]->amount();
+                npv += amount * df;
+                if (leg.isCoupon_[i])
+                    legBps += leg.nominals_[i] * leg.accrualPeriods_[i] * df;
+            }
+            npvs[j] = npv/d;
+            bps[j] = basisPoint_ * legBps / d;
+        }
+    }
+
     Rate CashFlows::atmRate(const Leg& leg,
                             const YieldTermStructure& discountCurve,
                             bool includeSettlementDateFlows,
@@ -28,6 +28,7 @@
 #define quantlib_cashflows_hpp
 
 #include <ql/cashflows/duration.hpp>
+#include <ql/cashflows/compiledleg.hpp>
 #include <ql/cashflow.hpp>
 #include <ql/interestrate.hpp>
 #include <boost/shared_ptr.hpp>
@@ -42,6 +43,10 @@ namespace QuantLib {
       private:
         CashFlows();
         CashFlows(const CashFlows&);
+        static Size compiledDiscounts(const CompiledLeg& leg,
+                                      const YieldTermStructure& discountCurve,
+                                      bool includeSettlementDateFlows,
+                                      const Date& settlementDate);
       public:
         //! \name Date functions
         //@{
@@ -185,6 +190,42 @@ namespace QuantLib {
                             Real npv = Null<Real>());
         //@}
 
+        //! \name Compiled-leg functions
+        /*! These functions return the same results as the
+            corresponding ones for the original leg; they read the
+            cash-flow data from the flat arrays of the compiled leg and
+            retrieve all the needed discount factors in a single call
+            to the term structure.
+        */
+        //@{
+        static Real npv(const CompiledLeg& leg,
+                        const YieldTermStructure& discountCurve,
+                        bool includeSettlementDateFlows,
+                        Date settlementDate = Date(),
+                        Date npvDate = Date());
+        static Real bps(const CompiledLeg& leg,
+                        const YieldTermStructure& discountCurve,
+                        bool includeSettlementDateFlows,
+                        Date settlementDate = Date(),
+                        Date npvDate = Date());
+        static void npvbps(const CompiledLeg& leg,
+                           const YieldTermStructure& discountCurve,
+                           bool includeSettlementDateFlows,
+                           Date settlementDate,
+                           Date npvDate,
+                           Real& npv,
+                           Real& bps);
+        //! NPVs and BPSs of a set of legs discounted on the same curve
+        static void npvbps(
+                    const std::vector<boost::shared_ptr<CompiledLeg> >& legs,
+                    const YieldTermStructure& discountCurve,
+                    bool includeSettlementDateFlows,
+                    Date settlementDate,
+                    Date npvDate,
+                    std::vector<Real>& npvs,
+                    std::vector<Real>& bps);
+        //@}
+
         //! \name Yield (a.k.a. Internal Rate of Return, i.e. IRR) functions
         /*! The IRR is the interest rate at which the NPV of the cash
             flows equals the dirty price.
@@ -0,0 +1,82 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/cashflows/compiledleg.hpp>
+#include <ql/cashflows/floatingratecoupon.hpp>
+#include <ql/utilities/null.hpp>
+
+namespace QuantLib {
+
+    CompiledLeg::CompiledLeg(const Leg& leg)
+    : leg_(leg) {
+        for (Size i=0; i<leg_.size(); ++i) {
+            QL_REQUIRE(leg_[i], "null cash flow in leg");
+            registerWith(leg_[i]);
+        }
+    }
+
+    void CompiledLeg::performCalculations() const {
+        Size n = leg_.size();
+        dates_.resize(n);
+        exCouponDates_.resize(n);
+        amounts_.resize(n);
+        nominals_.resize(n);
+        accrualPeriods_.resize(n);
+        fixingDates_.resize(n);
+        spreads_.resize(n);
+        isCoupon_.resize(n);
+        alive_.resize(n);
+        times_.resize(n);
+        discounts_.resize(n);
+
+        for (Size i=0; i<n; ++i) {
+            const CashFlow& cf = *leg_[i];
+            dates_[i] = cf.date();
+            exCouponDates_[i] = cf.exCouponDate();
+            // the amounts of past coupons might not be available
+            // (e.g., for missing fixings); in that case, they are
+            // required from the cash flow if and when they are used.
+            try {
+                amounts_[i] = cf.amount();
+            } catch (std::exception&) {
+                amounts_[i] = Null<Real>();
+            }
+
+            const Coupon* coupon = dynamic_cast<const Coupon*>(&cf);
+            isCoupon_[i] = (coupon != 0);
+            if (coupon) {
+                nominals_[i] = coupon->nominal();
+                accrualPeriods_[i] = coupon->accrualPeriod();
+            } else {
+                nominals_[i] = Null<Real>();
+                accrualPeriods_[i] = Null<Time>();
+            }
+
+            const FloatingRateCoupon* floating =
+                dynamic_cast<const FloatingRateCoupon*>(&cf);
+            if (floating) {
+                fixingDates_[i] = floating->fixingDate();
+                spreads_[i] = floating->spread();
+            } else {
+                fixingDates_[i] = Date();
+                spreads_[i] = Null<Spread>();
+            }
+        }
+    }
+
+}
+
@@ -0,0 +1,139 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file compiledleg.hpp
+    \brief leg with its cash-flow data stored in flat arrays
+*/
+
+#ifndef quantlib_compiled_leg_hpp
+#define quantlib_compiled_leg_hpp
+
+#include <ql/cashflow.hpp>
+#include <ql/patterns/lazyobject.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    //! leg with its cash-flow data stored in flat arrays
+    /*! The payment dates, amounts and coupon data of the cash flows
+        of a leg are read once and stored in contiguous arrays, which
+        are used by the corresponding CashFlows functions instead of
+        calling the cash flows one at a time.  The results of those
+        functions are the same as for the original leg.
+
+        The amounts of floating-rate coupons are calculated by their
+        pricers when the leg is compiled; the compiled leg observes
+        its cash flows and is compiled again when any of them
+        notifies a change (e.g., when its forecast curve moves).
+
+        For coupons, nominals and accrual periods are stored for the
+        calculation of the BPS; the fixing dates and spreads of
+        floating-rate coupons are also available for inspection.
+        Their values are null for the other cash flows.
+
+        \warning Like other lazy objects, a compiled leg must not be
+                 used concurrently from different threads.
+
+        \test the NPV and BPS of compiled legs are checked against
+              those of the original legs.
+    */
+    class CompiledLeg : public LazyObject {
+      public:
+        explicit CompiledLeg(const Leg& leg);
+        //! \name Inspectors
+        //@{
+        const Leg& leg() const;
+        Size size() const;
+        bool empty() const;
+        const std::vector<Date>& dates() const;
+        const std::vector<Date>& exCouponDates() const;
+        //! null for cash flows whose amount couldn't be calculated
+        const std::vector<Real>& amounts() const;
+        const std::vector<Real>& nominals() const;
+        const std::vector<Time>& accrualPeriods() const;
+        const std::vector<Date>& fixingDates() const;
+        const std::vector<Spread>& spreads() const;
+        //@}
+      private:
+        void performCalculations() const;
+        Leg leg_;
+        mutable std::vector<Date> dates_, exCouponDates_, fixingDates_;
+        mutable std::vector<Real> amounts_, nominals_;
+        mutable std::vector<Time> accrualPeriods_;
+        mutable std::vector<Spread> spreads_;
+        mutable std::vector<bool> isCoupon_;
+        // work arrays for the CashFlows functions
+        friend class CashFlows;
+        mutable std::vector<Size> alive_;
+        mutable std::vector<Time> times_;
+        mutable std::vector<DiscountFactor> discounts_;
+    };
+
+
+    // inline definitions
+
+    inline const Leg& CompiledLeg::leg() const {
+        return leg_;
+    }
+
+    inline Size CompiledLeg::size() const {
+        return leg_.size();
+    }
+
+    inline bool CompiledLeg::empty() const {
+        return leg_.empty();
+    }
+
+    inline const std::vector<Date>& CompiledLeg::dates() const {
+        calculate();
+        return dates_;
+    }
+
+    inline const std::vector<Date>& CompiledLeg::exCouponDates() const {
+        calculate();
+        return exCouponDates_;
+    }
+
+    inline const std::vector<Real>& CompiledLeg::amounts() const {
+        calculate();
+        return amounts_;
+    }
+
+    inline const std::vector<Real>& CompiledLeg::nominals() const {
+        calculate();
+        return nominals_;
+    }
+
+    inline const std::vector<Time>& CompiledLeg::accrualPeriods() const {
+        calculate();
+        return accrualPeriods_;
+    }
+
+    inline const std::vector<Date>& CompiledLeg::fixingDates() const {
+        calculate();
+        return fixingDates_;
+    }
+
+    inline const std::vector<Spread>& CompiledLeg::spreads() const {
+        calculate();
+        return spreads_;
+    }
+
+}
+
+
+#endif
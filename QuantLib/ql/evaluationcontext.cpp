@@ -0,0 +1,140 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/evaluationcontext.hpp>
+
+#if defined(QL_ENABLE_EVALUATION_CONTEXTS)
+
+#include <ql/settings.hpp>
+#include <ql/indexes/indexmanager.hpp>
+#include <boost/thread/tss.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    namespace {
+
+        // the context bound to each thread; none means the default one
+        boost::thread_specific_ptr<Integer> boundContext_;
+
+        void bind(Integer context) {
+            if (context == 0)
+                boundContext_.reset();
+            else
+                boundContext_.reset(new Integer(context));
+        }
+
+        typedef std::map<Integer, std::vector<void (*)(Integer)> >
+                                                               cleanup_map;
+
+        cleanup_map& cleanups() {
+            static cleanup_map cleanups_;
+            return cleanups_;
+        }
+
+        Integer nextContext_ = 0;
+
+    }
+
+    namespace detail {
+
+        Integer currentEvaluationContext() {
+            Integer* context = boundContext_.get();
+            return context ? *context : 0;
+        }
+
+        boost::recursive_mutex& singletonMutex() {
+            static boost::recursive_mutex mutex_;
+            return mutex_;
+        }
+
+        void registerEvaluationContextCleanup(Integer context,
+                                              void (*cleanup)(Integer)) {
+            boost::lock_guard<boost::recursive_mutex> lock(singletonMutex());
+            cleanups()[context].push_back(cleanup);
+        }
+
+    }
+
+    EvaluationContext::EvaluationContext() {
+        {
+            boost::lock_guard<boost::recursive_mutex> lock(
+                                                   detail::singletonMutex());
+            id_ = ++nextContext_;
+        }
+
+        // copy the settings and fixings of the current context...
+        Settings& settings = Settings::instance();
+        Date evaluationDate = settings.evaluationDate().value();
+        bool includeReferenceDateEvents =
+            settings.includeReferenceDateEvents();
+        boost::optional<bool> includeTodaysCashFlows =
+            settings.includeTodaysCashFlows();
+        bool enforcesTodaysHistoricFixings =
+            settings.enforcesTodaysHistoricFixings();
+
+        IndexManager& manager = IndexManager::instance();
+        std::vector<std::string> names = manager.histories();
+        std::vector<TimeSeries<Real> > fixings;
+        fixings.reserve(names.size());
+        for (Size i=0; i<names.size(); ++i)
+            fixings.push_back(manager.getHistory(names[i]));
+
+        // ...into the new one
+        ScopedEvaluationContext scope(*this);
+        Settings& newSettings = Settings::instance();
+        newSettings.evaluationDate() = evaluationDate;
+        newSettings.includeReferenceDateEvents() =
+            includeReferenceDateEvents;
+        newSettings.includeTodaysCashFlows() = includeTodaysCashFlows;
+        newSettings.enforcesTodaysHistoricFixings() =
+            enforcesTodaysHistoricFixings;
+        IndexManager& newManager = IndexManager::instance();
+        for (Size i=0; i<names.size(); ++i)
+            newManager.setHistory(names[i], fixings[i]);
+    }
+
+    EvaluationContext::~EvaluationContext() {
+        std::vector<void (*)(Integer)> cleanup;
+        {
+            boost::lock_guard<boost::recursive_mutex> lock(
+                                                   detail::singletonMutex());
+            cleanup_map::iterator i = cleanups().find(id_);
+            if (i != cleanups().end()) {
+                cleanup.swap(i->second);
+                cleanups().erase(i);
+            }
+        }
+        for (Size i=0; i<cleanup.size(); ++i)
+            cleanup[i](id_);
+    }
+
+
+    ScopedEvaluationContext::ScopedEvaluationContext(
+                                          const EvaluationContext& context)
+    : previous_(detail::currentEvaluationContext()) {
+        bind(context.id());
+    }
+
+    ScopedEvaluationContext::~ScopedEvaluationContext() {
+        bind(previous_);
+    }
+
+}
+
+#endif
+
@@ -0,0 +1,91 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file evaluationcontext.hpp
+    \brief per-thread evaluation contexts
+*/
+
+#ifndef quantlib_evaluation_context_hpp
+#define quantlib_evaluation_context_hpp
+
+#include <ql/qldefines.hpp>
+
+#if defined(QL_ENABLE_EVALUATION_CONTEXTS)
+
+#include <ql/types.hpp>
+#include <boost/noncopyable.hpp>
+
+namespace QuantLib {
+
+    //! set of singleton instances used for evaluation
+    /*! An evaluation context owns its own instances of the global
+        settings (evaluation date and flags), the index fixings and
+        the observable settings.  The other singletons (e.g., the
+        seed generator or the exchange-rate manager) are shared by
+        all contexts.
+        When the context is bound to a thread by means of a
+        ScopedEvaluationContext instance, the singletons accessed
+        from that thread are the ones belonging to the context; this
+        allows different threads to price at different evaluation
+        dates at the same time.  Threads to which no context is
+        bound use the default one.
+
+        A new context starts as a copy of the settings and fixings
+        of the context bound to the thread creating it.
+
+        Contexts are only available when the library is compiled
+        with QL_ENABLE_EVALUATION_CONTEXTS defined.
+
+        \warning Objects caching results that depend on the
+                 evaluation date (e.g., instruments or term
+                 structures with a moving reference date) hold a
+                 single cache; they must not be shared between
+                 contexts used concurrently.  Quotes and other
+                 market data can be shared.
+
+        \warning Objects created while a context is bound register
+                 with its singletons and must not outlive it.
+
+        \ingroup patterns
+    */
+    class EvaluationContext : private boost::noncopyable {
+      public:
+        EvaluationContext();
+        //! releases the singleton instances owned by the context
+        ~EvaluationContext();
+        Integer id() const { return id_; }
+      private:
+        Integer id_;
+    };
+
+    //! binds an evaluation context to the current thread
+    /*! The context previously bound to the thread (if any) is
+        restored when the instance is destroyed.
+    */
+    class ScopedEvaluationContext : private boost::noncopyable {
+      public:
+        explicit ScopedEvaluationContext(const EvaluationContext&);
+        ~ScopedEvaluationContext();
+      private:
+        Integer previous_;
+    };
+
+}
+
+#endif
+
+#endif
@@ -43,5 +43,31 @@ namespace QuantLib {
         return (1.0 + minYield + guarantee_) * notional_ * discount_;
     }
 
+    void EverestMultiPathPricer::operator()(const PathBlock& paths,
+                                            Real* values) const {
+
+        Size n = paths.paths();
+        Size last = paths.length()-1;
+        QL_REQUIRE(last>0, "the paths cannot be empty");
+
+        Size numAssets = paths.assetNumber();
+
+        // We search the yield min for all the paths at once
+        const Real* front = paths.values(0,0);
+        const Real* back = paths.values(last,0);
+        for (Size k=0; k<n; ++k)
+            values[k] = back[k] / front[k] - 1.0;
+        for (Size j=1; j<numAssets; ++j) {
+            front = paths.values(0,j);
+            back = paths.values(last,j);
+            for (Size k=0; k<n; ++k) {
+                Rate yield = back[k] / front[k] - 1.0;
+                values[k] = std::min(values[k], yield);
+            }
+        }
+        for (Size k=0; k<n; ++k)
+            values[k] = (1.0 + values[k] + guarantee_) * notional_ * discount_;
+    }
+
 }
 
@@ -50,7 +50,8 @@ namespace QuantLib {
                         Size requiredSamples,
                         Real requiredTolerance,
                         Size maxSamples,
-                        BigNatural seed);
+                        BigNatural seed,
+                        Size threads = 1);
         void calculate() const {
 
             McSimulation<MultiVariate,RNG,S>::calculate(requiredTolerance_,
@@ -110,6 +111,7 @@ namespace QuantLib {
         MakeMCEverestEngine& withAbsoluteTolerance(Real tolerance);
         MakeMCEverestEngine& withMaxSamples(Size samples);
         MakeMCEverestEngine& withSeed(BigNatural seed);
+        MakeMCEverestEngine& withThreads(Size threads);
         // conversion to pricing engine
         operator boost::shared_ptr<PricingEngine>() const;
       private:
@@ -118,6 +120,7 @@ namespace QuantLib {
         Size steps_, stepsPerYear_, samples_, maxSamples_;
         Real tolerance_;
         BigNatural seed_;
+        Size threads_;
     };
 
 
@@ -127,6 +130,10 @@ namespace QuantLib {
                                         Rate guarantee,
                                         DiscountFactor discount);
         Real operator()(const MultiPath& multiPath) const;
+        /*! writes into values[k] the discounted payoff of the k-th
+            multipath in the block.
+        */
+        void operator()(const PathBlock& paths, Real* values) const;
       private:
         Real notional_;
         Rate guarantee_;
@@ -146,8 +153,10 @@ namespace QuantLib {
                    Size requiredSamples,
                    Real requiredTolerance,
                    Size maxSamples,
-                   BigNatural seed)
-    : McSimulation<MultiVariate,RNG,S>(antitheticVariate, false),
+                   BigNatural seed,
+                   Size threads)
+    : McSimulation<MultiVariate,RNG,S>(antitheticVariate, false,
+                                       threads, seed),
       processes_(processes), timeSteps_(timeSteps),
       timeStepsPerYear_(timeStepsPerYear),
       requiredSamples_(requiredSamples), maxSamples_(maxSamples),
@@ -211,7 +220,7 @@ namespace QuantLib {
     : process_(process), brownianBridge_(false), antithetic_(false),
       steps_(Null<Size>()), stepsPerYear_(Null<Size>()),
       samples_(Null<Size>()), maxSamples_(Null<Size>()),
-      tolerance_(Null<Real>()), seed_(0) {}
+      tolerance_(Null<Real>()), seed_(0), threads_(1) {}
 
     template <class RNG, class S>
     inline MakeMCEverestEngine<RNG,S>&
@@ -276,6 +285,13 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S>
+    inline MakeMCEverestEngine<RNG,S>&
+    MakeMCEverestEngine<RNG,S>::withThreads(Size threads) {
+        threads_ = threads;
+        return *this;
+    }
+
     template <class RNG, class S>
     inline
     MakeMCEverestEngine<RNG,S>::operator
@@ -292,7 +308,8 @@ namespace QuantLib {
                                    antithetic_,
                                    samples_, tolerance_,
                                    maxSamples_,
-                                   seed_));
+                                   seed_,
+                                   threads_));
     }
 
 }
@@ -219,6 +219,7 @@ namespace QuantLib {
 
     template <class I, template <class> class B, class T>
     void PiecewiseYoYOptionletVolatilityCurve<I,B,T>::update() {
+        detail::notifyBootstrap(bootstrap_);
         base_curve::update();
         LazyObject::update();
     }
@@ -73,6 +73,16 @@ namespace QuantLib {
                                                 BigNatural seed) {
             return rsg_type(dimension, seed);
         }
+        static rsg_type make_sequence_generator(Size dimension,
+                                                BigNatural seed,
+                                                Size stream,
+                                                Size /* streamSize */) {
+            MersenneTwisterUniformRng seeder(seed);
+            BigNatural streamSeed = seeder.nextInt32();
+            for (Size i=0; i<stream; ++i)
+                streamSeed = seeder.nextInt32();
+            return rsg_type(dimension, streamSeed);
+        }
     };
 
 }
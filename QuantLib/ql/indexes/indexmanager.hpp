@@ -33,8 +33,8 @@ namespace QuantLib {
 
     //! global repository for past index fixings
     /*! \note index names are case insensitive */
-    class IndexManager : public Singleton<IndexManager> {
-        friend class Singleton<IndexManager>;
+    class IndexManager : public Singleton<IndexManager, true> {
+        friend class Singleton<IndexManager, true>;
       private:
         IndexManager() {}
       public:
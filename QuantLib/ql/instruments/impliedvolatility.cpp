@@ -20,6 +20,7 @@
 #include <ql/instruments/impliedvolatility.hpp>
 #include <ql/termstructures/volatility/equityfx/blackconstantvol.hpp>
 #include <ql/math/solvers1d/brent.hpp>
+#include <ql/pricingengines/blackformula.hpp>
 
 namespace QuantLib {
 
@@ -81,6 +82,51 @@ namespace QuantLib {
             return result;
         }
 
+        std::vector<Volatility> ImpliedVolatilityHelper::calculate(
+             const std::vector<Option::Type>& optionTypes,
+             const std::vector<Real>& strikes,
+             const std::vector<Date>& exerciseDates,
+             const std::vector<Real>& targetValues,
+             const boost::shared_ptr<GeneralizedBlackScholesProcess>& process,
+             std::vector<bool>& converged,
+             Real accuracy,
+             Natural maxIterations) {
+
+            const Size n = exerciseDates.size();
+            const Real spot = process->stateVariable()->value();
+            const Handle<YieldTermStructure>& dividendYield =
+                process->dividendYield();
+            const Handle<YieldTermStructure>& riskFreeRate =
+                process->riskFreeRate();
+            const Handle<BlackVolTermStructure>& blackVol =
+                process->blackVolatility();
+
+            std::vector<Real> forwards(n), discounts(n);
+            std::vector<Time> times(n);
+            for (Size i=0; i<n; ++i) {
+                times[i] = blackVol->timeFromReference(exerciseDates[i]);
+                if (times[i] <= 0.0) {
+                    // expired; the null discount leaves it unsolved
+                    forwards[i] = spot;
+                    discounts[i] = 0.0;
+                    continue;
+                }
+                discounts[i] = riskFreeRate->discount(exerciseDates[i]);
+                forwards[i] = spot *
+                    dividendYield->discount(exerciseDates[i]) / discounts[i];
+            }
+
+            std::vector<Volatility> result =
+                blackFormulaImpliedStdDev(optionTypes, strikes, forwards,
+                                          targetValues, discounts, converged,
+                                          0.0, accuracy, maxIterations);
+            for (Size i=0; i<n; ++i) {
+                if (result[i] != Null<Real>())
+                    result[i] /= std::sqrt(times[i]);
+            }
+            return result;
+        }
+
         boost::shared_ptr<GeneralizedBlackScholesProcess>
         ImpliedVolatilityHelper::clone(
              const boost::shared_ptr<GeneralizedBlackScholesProcess>& process,
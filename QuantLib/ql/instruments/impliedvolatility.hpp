@@ -25,6 +25,7 @@
 #define quantlib_implied_volatility_hpp
 
 #include <ql/instrument.hpp>
+#include <ql/option.hpp>
 #include <ql/quotes/simplequote.hpp>
 #include <ql/processes/blackscholesprocess.hpp>
 
@@ -50,6 +51,30 @@ namespace QuantLib {
                                         Natural maxEvaluations,
                                         Volatility minVol,
                                         Volatility maxVol);
+
+            /*! Implied volatilities of a batch of European
+                plain-vanilla options on the underlying of the passed
+                process, i.e., those that would be returned by
+                VanillaOption::impliedVolatility.  The forwards and
+                discounts are read from the process, and the
+                volatilities are calculated together by the batch
+                version of blackFormulaImpliedStdDev instead of
+                running a solver on a pricing engine for each option.
+
+                The accuracy refers to the implied standard
+                deviations; converged[i] is set as described for
+                blackFormulaImpliedStdDev.  Expired options are
+                returned as Null<Volatility>().
+            */
+            static std::vector<Volatility> calculate(
+                   const std::vector<Option::Type>& optionTypes,
+                   const std::vector<Real>& strikes,
+                   const std::vector<Date>& exerciseDates,
+                   const std::vector<Real>& targetValues,
+                   const boost::shared_ptr<GeneralizedBlackScholesProcess>&,
+                   std::vector<bool>& converged,
+                   Real accuracy,
+                   Natural maxIterations);
             // utilities
 
             /*! The returned process is equal to the passed one, except
@@ -7,6 +7,7 @@
 #include <ql/math/bernsteinpolynomial.hpp>
 #include <ql/math/beta.hpp>
 #include <ql/math/bspline.hpp>
+#include <ql/math/broydensolver.hpp>
 #include <ql/math/comparison.hpp>
 #include <ql/math/curve.hpp>
 #include <ql/math/errorfunction.hpp>
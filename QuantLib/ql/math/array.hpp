@@ -46,7 +46,15 @@ namespace QuantLib {
         As such, it is <b>not</b> meant to be used as a container -
         <tt>std::vector</tt> should be used instead.
 
-        \test construction of arrays is checked in a number of cases
+        Arrays of small size (such as the states of low-dimensional
+        stochastic processes) are stored inline and don't require
+        heap allocation; the price to pay is that swapping two arrays
+        is no longer a constant-time operation when one of them is
+        stored inline.
+
+        \test construction of arrays is checked in a number of cases;
+              copy and swap are checked for arrays stored both inline
+              and on the heap.
     */
     class Array {
       public:
@@ -135,8 +143,12 @@ namespace QuantLib {
         //@}
 
       private:
-        boost::scoped_array<Real> data_;
+        // arrays up to this size are stored inline
+        static const Size inlineSize = 4;
+        boost::scoped_array<Real> heap_;
+        Real* data_;
         Size n_;
+        Real buffer_[inlineSize];
     };
 
     //! specialization of null template for this class
@@ -208,21 +220,25 @@ namespace QuantLib {
     // inline definitions
 
     inline Array::Array(Size size)
-    : data_(size ? new Real[size] : (Real*)(0)), n_(size) {}
+    : heap_(size > inlineSize ? new Real[size] : (Real*)(0)),
+      data_(heap_ ? heap_.get() : buffer_), n_(size) {}
 
     inline Array::Array(Size size, Real value)
-    : data_(size ? new Real[size] : (Real*)(0)), n_(size) {
+    : heap_(size > inlineSize ? new Real[size] : (Real*)(0)),
+      data_(heap_ ? heap_.get() : buffer_), n_(size) {
         std::fill(begin(),end(),value);
     }
 
     inline Array::Array(Size size, Real value, Real increment)
-    : data_(size ? new Real[size] : (Real*)(0)), n_(size) {
+    : heap_(size > inlineSize ? new Real[size] : (Real*)(0)),
+      data_(heap_ ? heap_.get() : buffer_), n_(size) {
         for (iterator i=begin(); i!=end(); i++,value+=increment)
             *i = value;
     }
 
     inline Array::Array(const Array& from)
-    : data_(from.n_ ? new Real[from.n_] : (Real*)(0)), n_(from.n_) {
+    : heap_(from.n_ > inlineSize ? new Real[from.n_] : (Real*)(0)),
+      data_(heap_ ? heap_.get() : buffer_), n_(from.n_) {
         #if defined(QL_PATCH_MSVC) && defined(QL_DEBUG)
         if (n_)
         #endif
@@ -230,7 +246,7 @@ namespace QuantLib {
     }
 
     inline Array::Array(const Disposable<Array>& from)
-    : data_((Real*)(0)), n_(0) {
+    : data_(buffer_), n_(0) {
         swap(const_cast<Disposable<Array>&>(from));
     }
 
@@ -238,8 +254,6 @@ namespace QuantLib {
 
         template <class I>
         inline void _fill_array_(Array& a,
-                                 boost::scoped_array<Real>& data_,
-                                 Size& n_,
                                  I begin, I end,
                                  const boost::true_type&) {
             // we got redirected here from a call like Array(3, 4)
@@ -248,34 +262,32 @@ namespace QuantLib {
             // Array with a given value, which we do here.
             Size n = begin;
             Real value = end;
-            data_.reset(n ? new Real[n] : (Real*)(0));
-            n_ = n;
-            std::fill(a.begin(),a.end(),value);
+            Array temp(n, value);
+            a.swap(temp);
         }
 
         template <class I>
         inline void _fill_array_(Array& a,
-                                 boost::scoped_array<Real>& data_,
-                                 Size& n_,
                                  I begin, I end,
                                  const boost::false_type&) {
             // true iterators
             Size n = std::distance(begin, end);
-            data_.reset(n ? new Real[n] : (Real*)(0));
-            n_ = n;
+            Array temp(n);
             #if defined(QL_PATCH_MSVC) && defined(QL_DEBUG)
-            if (n_)
+            if (n)
             #endif
-            std::copy(begin, end, a.begin());
+            std::copy(begin, end, temp.begin());
+            a.swap(temp);
         }
 
     }
 
     template <class ForwardIterator>
-    inline Array::Array(ForwardIterator begin, ForwardIterator end) {
+    inline Array::Array(ForwardIterator begin, ForwardIterator end)
+    : data_(buffer_), n_(0) {
         // Unfortunately, calls such as Array(3, 4) match this constructor.
         // We have to detect integral types and dispatch.
-        detail::_fill_array_(*this, data_, n_, begin, end,
+        detail::_fill_array_(*this, begin, end,
                              boost::is_integral<ForwardIterator>());
     }
 
@@ -366,28 +378,28 @@ namespace QuantLib {
                    "index (" << i << ") must be less than " << n_ <<
                    ": array access out of range");
         #endif
-        return data_.get()[i];
+        return data_[i];
     }
 
     inline Real Array::at(Size i) const {
         QL_REQUIRE(i<n_,
                    "index (" << i << ") must be less than " << n_ <<
                    ": array access out of range");
-        return data_.get()[i];
+        return data_[i];
     }
 
     inline Real Array::front() const {
         #if defined(QL_EXTRA_SAFETY_CHECKS)
         QL_REQUIRE(n_>0, "null Array: array access out of range");
         #endif
-        return data_.get()[0];
+        return data_[0];
     }
 
     inline Real Array::back() const {
         #if defined(QL_EXTRA_SAFETY_CHECKS)
         QL_REQUIRE(n_>0, "null Array: array access out of range");
         #endif
-        return data_.get()[n_-1];
+        return data_[n_-1];
     }
 
     inline Real& Array::operator[](Size i) {
@@ -396,28 +408,28 @@ namespace QuantLib {
                    "index (" << i << ") must be less than " << n_ <<
                    ": array access out of range");
         #endif
-        return data_.get()[i];
+        return data_[i];
     }
 
     inline Real& Array::at(Size i) {
         QL_REQUIRE(i<n_,
                    "index (" << i << ") must be less than " << n_ <<
                    ": array access out of range");
-        return data_.get()[i];
+        return data_[i];
     }
 
     inline Real& Array::front() {
         #if defined(QL_EXTRA_SAFETY_CHECKS)
         QL_REQUIRE(n_>0, "null Array: array access out of range");
         #endif
-        return data_.get()[0];
+        return data_[0];
     }
 
     inline Real& Array::back() {
         #if defined(QL_EXTRA_SAFETY_CHECKS)
         QL_REQUIRE(n_>0, "null Array: array access out of range");
         #endif
-        return data_.get()[n_-1];
+        return data_[n_-1];
     }
 
     inline Size Array::size() const {
@@ -429,19 +441,19 @@ namespace QuantLib {
     }
 
     inline Array::const_iterator Array::begin() const {
-        return data_.get();
+        return data_;
     }
 
     inline Array::iterator Array::begin() {
-        return data_.get();
+        return data_;
     }
 
     inline Array::const_iterator Array::end() const {
-        return data_.get()+n_;
+        return data_+n_;
     }
 
     inline Array::iterator Array::end() {
-        return data_.get()+n_;
+        return data_+n_;
     }
 
     inline Array::const_reverse_iterator Array::rbegin() const {
@@ -462,7 +474,15 @@ namespace QuantLib {
 
     inline void Array::swap(Array& from) {
         using std::swap;
-        data_.swap(from.data_);
+        // inline contents must be copied; heap storage is swapped
+        Real temp[inlineSize];
+        Size n1 = heap_ ? 0 : n_, n2 = from.heap_ ? 0 : from.n_;
+        std::copy(buffer_, buffer_+n1, temp);
+        std::copy(from.buffer_, from.buffer_+n2, buffer_);
+        std::copy(temp, temp+n1, from.buffer_);
+        heap_.swap(from.heap_);
+        data_ = heap_ ? heap_.get() : buffer_;
+        from.data_ = from.heap_ ? from.heap_.get() : from.buffer_;
         swap(n_,from.n_);
     }
 
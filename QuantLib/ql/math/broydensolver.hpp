@@ -0,0 +1,134 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file broydensolver.hpp
+    \brief Newton solver with Broyden updates for systems of equations
+*/
+
+#ifndef quantlib_broyden_solver_hpp
+#define quantlib_broyden_solver_hpp
+
+#include <ql/math/matrixutilities/qrdecomposition.hpp>
+#include <string>
+
+namespace QuantLib {
+
+    namespace detail {
+
+        /*! Drives the errors \f$ e(x) \f$ to zero by Newton steps.
+            The given Jacobian is used as a starting point and kept
+            up to date by Broyden updates; it is computed anew by the
+            Jacobian function when missing or when no step along the
+            Newton direction, halved up to a few times, reduces the
+            max error.
+
+            The error function is called as <tt>f(x, e)</tt>; it sets
+            the problem at \c x and writes in \c e the errors, and it
+            can throw when \c x is outside its domain.  The Jacobian
+            function is called as <tt>jacobian(x, e)</tt>, with \c e
+            the errors at \c x; it returns the Jacobian at \c x and
+            leaves the problem set at \c x, where it might not be on
+            entry.
+
+            On input, \c x holds the guess; on output, the solution,
+            at which the problem is left set, and \c e the errors at
+            the solution.  The name is used in the error messages.
+        */
+        template <class ErrorFunction, class JacobianFunction>
+        void broydenSolve(const ErrorFunction& f,
+                          const JacobianFunction& jacobianFunction,
+                          Array& x, Array& e,
+                          Matrix& jacobian, bool& exactJacobian,
+                          Real accuracy, Size maxIterations,
+                          const std::string& name) {
+            const Size n = x.size();
+            e = Array(n);
+            f(x, e);
+            if (jacobian.rows() != n) {
+                jacobian = jacobianFunction(x, e);
+                exactJacobian = true;
+            }
+
+            Real error = 0.0;
+            for (Size i=0; i<n; ++i)
+                error = std::max(error, std::fabs(e[i]));
+
+            Array xNew(n), eNew(n);
+            Size iteration = 0;
+            while (error > accuracy) {
+                QL_REQUIRE(++iteration <= maxIterations,
+                           name << " failed to converge after " <<
+                           maxIterations << " iterations: " <<
+                           "max error is " << error << ", accuracy is " <<
+                           accuracy);
+
+                Array dx = -qrSolve(jacobian, e);
+
+                // backtrack until the step reduces the errors
+                Real lambda = 1.0, newError = QL_MAX_REAL;
+                bool improved = false;
+                while (lambda > 1.0e-4) {
+                    xNew = x + lambda*dx;
+                    try {
+                        f(xNew, eNew);
+                        newError = 0.0;
+                        for (Size i=0; i<n; ++i)
+                            newError = std::max(newError, std::fabs(eNew[i]));
+                    } catch (...) {
+                        newError = QL_MAX_REAL;
+                    }
+                    // also catches NaN
+                    if (newError < error) {
+                        improved = true;
+                        break;
+                    }
+                    lambda *= 0.5;
+                }
+
+                if (!improved) {
+                    // a stale Jacobian might be the culprit
+                    QL_REQUIRE(!exactJacobian,
+                               name << " failed: no step reduces "
+                               "the max error (" << error << ")");
+                    jacobian = jacobianFunction(x, e);
+                    exactJacobian = true;
+                    continue;
+                }
+
+                // Broyden update of the Jacobian
+                Array s = xNew - x, y = eNew - e;
+                Real s2 = DotProduct(s, s);
+                if (s2 > 0.0) {
+                    Array r = y - jacobian*s;
+                    for (Size i=0; i<n; ++i)
+                        for (Size j=0; j<n; ++j)
+                            jacobian[i][j] += r[i]*s[j]/s2;
+                    exactJacobian = false;
+                }
+
+                x.swap(xNew);
+                e.swap(eNew);
+                error = newError;
+            }
+        }
+
+    }
+
+}
+
+
+#endif
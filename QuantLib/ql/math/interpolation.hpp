@@ -55,6 +55,21 @@ namespace QuantLib {
             virtual Real primitive(Real) const = 0;
             virtual Real derivative(Real) const = 0;
             virtual Real secondDerivative(Real) const = 0;
+            /*! writes the values at the n given points; the default
+                implementation calls value() for each of them.
+            */
+            virtual void values(const Real* x, Real* y, Size n) const {
+                for (Size i=0; i<n; ++i)
+                    y[i] = value(x[i]);
+            }
+            /*! writes the primitives at the n given points; the
+                default implementation calls primitive() for each of
+                them.
+            */
+            virtual void primitives(const Real* x, Real* y, Size n) const {
+                for (Size i=0; i<n; ++i)
+                    y[i] = primitive(x[i]);
+            }
         };
         boost::shared_ptr<Impl> impl_;
       public:
@@ -105,6 +120,21 @@ namespace QuantLib {
                 else
                     return std::upper_bound(xBegin_,xEnd_-1,x)-xBegin_-1;
             }
+            /*! returns the same as locate(x), but tries the given
+                segment and the next one before searching; passing
+                the segment of the previous point makes the lookup of
+                sorted points linear overall.
+            */
+            Size locate(Real x, Size hint) const {
+                Size n = xEnd_-xBegin_;
+                if (hint+1 < n && x >= xBegin_[hint]) {
+                    if (x < xBegin_[hint+1])
+                        return hint;
+                    if (hint+2 < n && x < xBegin_[hint+2])
+                        return hint+1;
+                }
+                return locate(x);
+            }
             I1 xBegin_, xEnd_;
             I2 yBegin_;
         };
@@ -116,10 +146,30 @@ namespace QuantLib {
             checkRange(x,allowExtrapolation);
             return impl_->value(x);
         }
+        /*! writes the interpolated values at the n given points.
+            The results are the same as those of the single-point
+            method; however, the lookup of the interpolation segment
+            is faster when the points are sorted.
+        */
+        void operator()(const Real* x, Real* y, Size n,
+                        bool allowExtrapolation = false) const {
+            for (Size i=0; i<n; ++i)
+                checkRange(x[i],allowExtrapolation);
+            impl_->values(x, y, n);
+        }
         Real primitive(Real x, bool allowExtrapolation = false) const {
             checkRange(x,allowExtrapolation);
             return impl_->primitive(x);
         }
+        /*! writes the primitives at the n given points; see the
+            corresponding operator() for details.
+        */
+        void primitive(const Real* x, Real* y, Size n,
+                       bool allowExtrapolation = false) const {
+            for (Size i=0; i<n; ++i)
+                checkRange(x[i],allowExtrapolation);
+            impl_->primitives(x, y, n);
+        }
         Real derivative(Real x, bool allowExtrapolation = false) const {
             checkRange(x,allowExtrapolation);
             return impl_->derivative(x);
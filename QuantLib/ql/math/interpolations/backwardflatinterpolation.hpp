@@ -94,6 +94,26 @@ namespace QuantLib {
                 Real dx = x-this->xBegin_[i];
                 return primitive_[i] + dx*this->yBegin_[i+1];
             }
+            void values(const Real* x, Real* y, Size n) const {
+                for (Size k=0, i=0; k<n; ++k) {
+                    if (x[k] <= this->xBegin_[0]) {
+                        y[k] = this->yBegin_[0];
+                        continue;
+                    }
+                    i = this->locate(x[k], i);
+                    if (x[k] == this->xBegin_[i])
+                        y[k] = this->yBegin_[i];
+                    else
+                        y[k] = this->yBegin_[i+1];
+                }
+            }
+            void primitives(const Real* x, Real* y, Size n) const {
+                for (Size k=0, i=0; k<n; ++k) {
+                    i = this->locate(x[k], i);
+                    Real dx = x[k]-this->xBegin_[i];
+                    y[k] = primitive_[i] + dx*this->yBegin_[i+1];
+                }
+            }
             Real derivative(Real) const {
                 return 0.0;
             }
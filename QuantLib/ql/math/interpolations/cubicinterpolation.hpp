@@ -705,6 +705,23 @@ namespace QuantLib {
                     + dx_*(this->yBegin_[j] + dx_*(a_[j]/2.0
                     + dx_*(b_[j]/3.0 + dx_*c_[j]/4.0)));
             }
+            void values(const Real* x, Real* y, Size n) const {
+                for (Size k=0, j=0; k<n; ++k) {
+                    j = this->locate(x[k], j);
+                    Real dx = x[k]-this->xBegin_[j];
+                    y[k] = this->yBegin_[j]
+                        + dx*(a_[j] + dx*(b_[j] + dx*c_[j]));
+                }
+            }
+            void primitives(const Real* x, Real* y, Size n) const {
+                for (Size k=0, j=0; k<n; ++k) {
+                    j = this->locate(x[k], j);
+                    Real dx = x[k]-this->xBegin_[j];
+                    y[k] = primitiveConst_[j]
+                        + dx*(this->yBegin_[j] + dx*(a_[j]/2.0
+                        + dx*(b_[j]/3.0 + dx*c_[j]/4.0)));
+                }
+            }
             Real derivative(Real x) const {
                 Size j = this->locate(x);
                 Real dx_ = x-this->xBegin_[j];
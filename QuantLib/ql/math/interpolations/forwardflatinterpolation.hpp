@@ -91,6 +91,23 @@ namespace QuantLib {
                 Real dx = x-this->xBegin_[i];
                 return primitive_[i] + dx*this->yBegin_[i];
             }
+            void values(const Real* x, Real* y, Size n) const {
+                for (Size k=0, i=0; k<n; ++k) {
+                    if (x[k] >= this->xBegin_[n_-1]) {
+                        y[k] = this->yBegin_[n_-1];
+                        continue;
+                    }
+                    i = this->locate(x[k], i);
+                    y[k] = this->yBegin_[i];
+                }
+            }
+            void primitives(const Real* x, Real* y, Size n) const {
+                for (Size k=0, i=0; k<n; ++k) {
+                    i = this->locate(x[k], i);
+                    Real dx = x[k]-this->xBegin_[i];
+                    y[k] = primitive_[i] + dx*this->yBegin_[i];
+                }
+            }
             Real derivative(Real) const {
                 return 0.0;
             }
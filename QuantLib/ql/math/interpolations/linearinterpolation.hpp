@@ -92,6 +92,20 @@ namespace QuantLib {
                 return primitiveConst_[i] +
                     dx*(this->yBegin_[i] + 0.5*dx*s_[i]);
             }
+            void values(const Real* x, Real* y, Size n) const {
+                for (Size k=0, i=0; k<n; ++k) {
+                    i = this->locate(x[k], i);
+                    y[k] = this->yBegin_[i] + (x[k]-this->xBegin_[i])*s_[i];
+                }
+            }
+            void primitives(const Real* x, Real* y, Size n) const {
+                for (Size k=0, i=0; k<n; ++k) {
+                    i = this->locate(x[k], i);
+                    Real dx = x[k]-this->xBegin_[i];
+                    y[k] = primitiveConst_[i] +
+                        dx*(this->yBegin_[i] + 0.5*dx*s_[i]);
+                }
+            }
             Real derivative(Real x) const {
                 Size i = this->locate(x);
                 return s_[i];
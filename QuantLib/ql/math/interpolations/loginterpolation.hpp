@@ -227,6 +227,11 @@ namespace QuantLib {
             Real value(Real x) const {
                 return std::exp(interpolation_(x, true));
             }
+            void values(const Real* x, Real* y, Size n) const {
+                interpolation_(x, y, n, true);
+                for (Size i=0; i<n; ++i)
+                    y[i] = std::exp(y[i]);
+            }
             Real primitive(Real) const {
                 QL_FAIL("LogInterpolation primitive not implemented");
             }
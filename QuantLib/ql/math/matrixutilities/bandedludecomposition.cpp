@@ -0,0 +1,115 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file bandedludecomposition.cpp
+    \brief LU decomposition of banded sparse matrices
+*/
+
+#include <ql/qldefines.hpp>
+
+#if !defined(QL_NO_UBLAS_SUPPORT)
+
+#include <ql/math/matrixutilities/bandedludecomposition.hpp>
+#include <algorithm>
+
+namespace QuantLib {
+
+    BandedLUDecomposition::BandedLUDecomposition(const SparseMatrix& A)
+    : n_(A.size1()), kl_(0), ku_(0) {
+
+        QL_REQUIRE(A.size1() == A.size2(),
+                   "banded LU decomposition works only with square matrices");
+        QL_REQUIRE(n_ > 0, "empty matrix given");
+
+        const SparseMatrix::index_array_type& rows = A.index1_data();
+        const SparseMatrix::index_array_type& columns = A.index2_data();
+
+        for (Size i=0; i+1 < A.filled1(); ++i) {
+            for (Size k=rows[i]; k < rows[i+1]; ++k) {
+                const Size j = columns[k];
+                if (j < i)
+                    kl_ = std::max(kl_, i-j);
+                else
+                    ku_ = std::max(ku_, j-i);
+            }
+        }
+
+        // row interchanges widen the upper band by kl
+        w_ = 2*kl_ + ku_ + 1;
+        u_.resize(n_*w_, 0.0);
+        l_.resize(n_*kl_, 0.0);
+        pivots_.resize(n_);
+
+        for (Size i=0; i+1 < A.filled1(); ++i)
+            for (Size k=rows[i]; k < rows[i+1]; ++k)
+                u(i, columns[k]) = A.value_data()[k];
+
+        for (Size k=0; k < n_; ++k) {
+            const Size last = std::min(n_-1, k+kl_);
+            const Size lastColumn = std::min(n_-1, k+kl_+ku_);
+
+            Size p = k;
+            for (Size i=k+1; i <= last; ++i)
+                if (std::fabs(u(i, k)) > std::fabs(u(p, k)))
+                    p = i;
+            QL_REQUIRE(u(p, k) != 0.0, "singular matrix given");
+
+            pivots_[k] = p;
+            if (p != k)
+                for (Size j=k; j <= lastColumn; ++j)
+                    std::swap(u(k, j), u(p, j));
+
+            const Real pivot = u(k, k);
+            for (Size i=k+1; i <= last; ++i) {
+                const Real m = u(i, k)/pivot;
+                l_[k*kl_ + i-k-1] = m;
+                u(i, k) = 0.0;
+                if (m != 0.0)
+                    for (Size j=k+1; j <= lastColumn; ++j)
+                        u(i, j) -= m*u(k, j);
+            }
+        }
+    }
+
+    Disposable<Array> BandedLUDecomposition::solve(const Array& b) const {
+        QL_REQUIRE(b.size() == n_, "wrong size of the right-hand side");
+
+        Array x(b);
+        for (Size k=0; k < n_; ++k) {
+            if (pivots_[k] != k)
+                std::swap(x[k], x[pivots_[k]]);
+
+            const Size last = std::min(n_-1, k+kl_);
+            for (Size i=k+1; i <= last; ++i)
+                x[i] -= l_[k*kl_ + i-k-1]*x[k];
+        }
+
+        for (Size k=n_; k > 0; --k) {
+            const Size i = k-1;
+            const Size lastColumn = std::min(n_-1, i+kl_+ku_);
+            Real sum = x[i];
+            for (Size j=i+1; j <= lastColumn; ++j)
+                sum -= u(i, j)*x[j];
+            x[i] = sum/u(i, i);
+        }
+
+        return x;
+    }
+
+}
+
+#endif
@@ -0,0 +1,74 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file bandedludecomposition.hpp
+    \brief LU decomposition of banded sparse matrices
+*/
+
+#ifndef quantlib_banded_lu_decomposition_hpp
+#define quantlib_banded_lu_decomposition_hpp
+
+#include <ql/qldefines.hpp>
+
+#if !defined(QL_NO_UBLAS_SUPPORT)
+
+#include <ql/math/array.hpp>
+#include <ql/math/matrixutilities/sparsematrix.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    //! LU decomposition of a banded matrix with partial pivoting
+    /*! The lower and upper bandwidths are taken from the non-zero
+        elements of the given sparse matrix; the factors are stored
+        in band form, as in LAPACK's dgbtrf, so that the
+        decomposition takes \f$ O(n k_l (k_l + k_u)) \f$ operations
+        and each solve \f$ O(n (2 k_l + k_u)) \f$.  This makes it
+        suitable for the operators of finite-difference schemes,
+        whose bandwidth is given by the size of all but the last
+        dimension of the grid.
+
+        \test the solution of a banded system is checked against the
+              given right-hand side.
+    */
+    class BandedLUDecomposition {
+      public:
+        explicit BandedLUDecomposition(const SparseMatrix& A);
+
+        Size size() const { return n_; }
+        Size lowerBandwidth() const { return kl_; }
+        Size upperBandwidth() const { return ku_; }
+
+        //! solves \f$ A x = b \f$
+        Disposable<Array> solve(const Array& b) const;
+
+      private:
+        Real& u(Size i, Size j) { return u_[i*w_ + j + kl_ - i]; }
+        Real u(Size i, Size j) const { return u_[i*w_ + j + kl_ - i]; }
+
+        Size n_, kl_, ku_, w_;
+        // rows of U, including the fill-in due to row interchanges
+        std::vector<Real> u_;
+        // multipliers of each elimination step
+        std::vector<Real> l_;
+        std::vector<Size> pivots_;
+    };
+
+}
+
+#endif
+#endif
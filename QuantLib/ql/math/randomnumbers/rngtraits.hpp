@@ -54,6 +54,20 @@ namespace QuantLib {
             ursg_type g(dimension, seed);
             return (icInstance ? rsg_type(g, *icInstance) : rsg_type(g));
         }
+        /*! returns the generator for the given stream of draws;
+            each stream is seeded independently with a seed derived
+            from the given one.
+        */
+        static rsg_type make_sequence_generator(Size dimension,
+                                                BigNatural seed,
+                                                Size stream,
+                                                Size /* streamSize */) {
+            MersenneTwisterUniformRng seeder(seed);
+            BigNatural streamSeed = seeder.nextInt32();
+            for (Size i=0; i<stream; ++i)
+                streamSeed = seeder.nextInt32();
+            return make_sequence_generator(dimension, streamSeed);
+        }
         // data
         static boost::shared_ptr<IC> icInstance;
     };
@@ -91,6 +105,18 @@ namespace QuantLib {
             ursg_type g(dimension, seed);
             return (icInstance ? rsg_type(g, *icInstance) : rsg_type(g));
         }
+        /*! returns the generator for the given stream of draws;
+            the n-th stream covers the draws from n*streamSize to
+            (n+1)*streamSize-1 of the low-discrepancy sequence.
+        */
+        static rsg_type make_sequence_generator(Size dimension,
+                                                BigNatural seed,
+                                                Size stream,
+                                                Size streamSize) {
+            ursg_type g(dimension, seed);
+            g.skipTo(static_cast<unsigned long>(stream*streamSize));
+            return (icInstance ? rsg_type(g, *icInstance) : rsg_type(g));
+        }
         // data
         static boost::shared_ptr<IC> icInstance;
     };
@@ -0,0 +1,344 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/statistics/streamingstatistics.hpp>
+#include <algorithm>
+#include <functional>
+
+namespace QuantLib {
+
+    StreamingStatistics::StreamingStatistics(Size tailSize,
+                                             Real compression)
+    : tailSize_(tailSize), compression_(compression) {
+        QL_REQUIRE(compression >= 1.0,
+                   "compression (" << compression << ") must be at least 1");
+        reset();
+    }
+
+    Real StreamingStatistics::mean() const {
+        QL_REQUIRE(samples() != 0, "empty sample set");
+        return mean_;
+    }
+
+    Real StreamingStatistics::variance() const {
+        Size N = samples();
+        QL_REQUIRE(N > 1,
+                   "sample number <=1, unsufficient");
+        return (m2_/weightSum_)*N/(N-1.0);
+    }
+
+    Real StreamingStatistics::skewness() const {
+        Size N = samples();
+        QL_REQUIRE(N > 2,
+                   "sample number <=2, unsufficient");
+
+        Real x = m3_/weightSum_;
+        Real sigma = standardDeviation();
+
+        return (x/(sigma*sigma*sigma))*(N/(N-1.0))*(N/(N-2.0));
+    }
+
+    Real StreamingStatistics::kurtosis() const {
+        Size N = samples();
+        QL_REQUIRE(N > 3,
+                   "sample number <=3, unsufficient");
+
+        Real x = m4_/weightSum_;
+        Real sigma2 = variance();
+
+        Real c1 = (N/(N-1.0)) * (N/(N-2.0)) * ((N+1.0)/(N-3.0));
+        Real c2 = 3.0 * ((N-1.0)/(N-2.0)) * ((N-1.0)/(N-3.0));
+
+        return c1*(x/(sigma2*sigma2))-c2;
+    }
+
+    Real StreamingStatistics::percentile(Real percent) const {
+        QL_REQUIRE(percent > 0.0 && percent <= 1.0,
+                   "percentile (" << percent << ") must be in (0.0, 1.0]");
+        QL_REQUIRE(weightSum_ > 0.0, "empty sample set");
+        return quantile(percent, false);
+    }
+
+    Real StreamingStatistics::topPercentile(Real percent) const {
+        QL_REQUIRE(percent > 0.0 && percent <= 1.0,
+                   "percentile (" << percent << ") must be in (0.0, 1.0]");
+        QL_REQUIRE(weightSum_ > 0.0, "empty sample set");
+        return quantile(percent, true);
+    }
+
+    Real StreamingStatistics::quantile(Real percent, bool fromTop) const {
+        std::vector<Centroid> reversed;
+        const std::vector<Centroid>* points = &this->points();
+        if (fromTop) {
+            reversed.assign(points->rbegin(), points->rend());
+            points = &reversed;
+        }
+        const std::vector<Centroid>& p = *points;
+        const Size n = p.size();
+
+        Real total = 0.0;
+        for (Size i=0; i<n; ++i)
+            total += p[i].weight;
+
+        // same walk as in GeneralStatistics
+        Size k = 0;
+        Real integral = p[0].weight, target = percent*total;
+        while (integral < target && k != n-1) {
+            ++k;
+            integral += p[k].weight;
+        }
+
+        const Centroid& c = p[k];
+        if (c.count == 1.0)
+            // an actual sample
+            return c.value;
+
+        // interpolate between the centers of the neighboring points
+        Real center = integral - 0.5*c.weight;
+        Real result = c.value;
+        if (target < center && k > 0) {
+            const Centroid& previous = p[k-1];
+            Real previousCenter = integral - c.weight - 0.5*previous.weight;
+            result = previous.value + (c.value-previous.value)
+                * (target-previousCenter)/(center-previousCenter);
+        } else if (target > center && k+1 < n) {
+            const Centroid& next = p[k+1];
+            Real nextCenter = integral + 0.5*next.weight;
+            result = c.value + (next.value-c.value)
+                * (target-center)/(nextCenter-center);
+        }
+        return result;
+    }
+
+    void StreamingStatistics::add(Real value, Real weight) {
+        QL_REQUIRE(weight>=0.0, "negative weight not allowed");
+
+        if (samples_ == 0) {
+            min_ = max_ = value;
+        } else {
+            min_ = std::min(min_, value);
+            max_ = std::max(max_, value);
+        }
+        ++samples_;
+
+        addToLowerTail(std::make_pair(value, weight));
+        addToUpperTail(std::make_pair(value, weight));
+
+        if (weight > 0.0) {
+            addMoments(weight, value, 0.0, 0.0, 0.0);
+            buffer_.push_back(Centroid(value, weight, 1.0));
+            if (buffer_.size() >= 5.0*compression_)
+                compress();
+        }
+        pointsValid_ = false;
+    }
+
+    void StreamingStatistics::merge(const StreamingStatistics& other) {
+        if (&other == this) {
+            StreamingStatistics copy(other);
+            merge(copy);
+            return;
+        }
+        if (other.samples_ == 0)
+            return;
+
+        if (samples_ == 0) {
+            min_ = other.min_;
+            max_ = other.max_;
+        } else {
+            min_ = std::min(min_, other.min_);
+            max_ = std::max(max_, other.max_);
+        }
+        samples_ += other.samples_;
+
+        // the tails of the union are among the tails of the parts
+        for (Size i=0; i<other.lowerTail_.size(); ++i)
+            addToLowerTail(other.lowerTail_[i]);
+        for (Size i=0; i<other.upperTail_.size(); ++i)
+            addToUpperTail(other.upperTail_[i]);
+
+        if (other.weightSum_ > 0.0) {
+            addMoments(other.weightSum_, other.mean_,
+                       other.m2_, other.m3_, other.m4_);
+            other.compress();
+            buffer_.insert(buffer_.end(),
+                           other.centroids_.begin(), other.centroids_.end());
+            compress();
+        }
+        pointsValid_ = false;
+    }
+
+    void StreamingStatistics::reset() {
+        samples_ = 0;
+        weightSum_ = mean_ = m2_ = m3_ = m4_ = 0.0;
+        min_ = max_ = Null<Real>();
+        lowerTail_.clear();
+        upperTail_.clear();
+        centroids_.clear();
+        buffer_.clear();
+        points_.clear();
+        pointsValid_ = false;
+    }
+
+    void StreamingStatistics::addMoments(Real wB, Real meanB,
+                                         Real m2B, Real m3B, Real m4B) {
+        // pairwise update of the central moments, see Pebay (2008)
+        Real wA = weightSum_, w = wA+wB;
+        Real delta = meanB-mean_;
+        Real dw = delta/w;
+
+        m4_ += m4B + delta*dw*dw*dw*wA*wB*(wA*wA-wA*wB+wB*wB)
+             + 6.0*dw*dw*(wA*wA*m2B+wB*wB*m2_)
+             + 4.0*dw*(wA*m3B-wB*m3_);
+        m3_ += m3B + delta*dw*dw*wA*wB*(wA-wB)
+             + 3.0*dw*(wA*m2B-wB*m2_);
+        m2_ += m2B + delta*dw*wA*wB;
+        mean_ += wB*dw;
+        weightSum_ = w;
+    }
+
+    void StreamingStatistics::addToLowerTail(
+                                      const std::pair<Real,Real>& sample) {
+        // max-heap: the front is the largest of the stored samples
+        if (lowerTail_.size() < tailSize_) {
+            lowerTail_.push_back(sample);
+            std::push_heap(lowerTail_.begin(), lowerTail_.end());
+        } else if (tailSize_ > 0 && sample < lowerTail_.front()) {
+            std::pop_heap(lowerTail_.begin(), lowerTail_.end());
+            lowerTail_.back() = sample;
+            std::push_heap(lowerTail_.begin(), lowerTail_.end());
+        }
+    }
+
+    void StreamingStatistics::addToUpperTail(
+                                      const std::pair<Real,Real>& sample) {
+        // min-heap: the front is the smallest of the stored samples
+        std::greater<std::pair<Real,Real> > greater;
+        if (upperTail_.size() < tailSize_) {
+            upperTail_.push_back(sample);
+            std::push_heap(upperTail_.begin(), upperTail_.end(), greater);
+        } else if (tailSize_ > 0 && greater(sample, upperTail_.front())) {
+            std::pop_heap(upperTail_.begin(), upperTail_.end(), greater);
+            upperTail_.back() = sample;
+            std::push_heap(upperTail_.begin(), upperTail_.end(), greater);
+        }
+    }
+
+    void StreamingStatistics::compress() const {
+        if (buffer_.empty())
+            return;
+
+        buffer_.insert(buffer_.end(), centroids_.begin(), centroids_.end());
+        std::sort(buffer_.begin(), buffer_.end());
+
+        Real total = 0.0;
+        for (Size i=0; i<buffer_.size(); ++i)
+            total += buffer_[i].weight;
+
+        // the size of each centroid is bounded by the k_1 scale
+        // function k(q) = delta/(2 pi) asin(2q-1), i.e., each
+        // centroid spans at most a unit increment of k.
+        const Real factor = compression_/(2.0*M_PI);
+        centroids_.clear();
+        Centroid current = buffer_.front();
+        Real weightSoFar = 0.0;
+        Real q = 0.0;
+        Real k = factor*std::asin(2.0*q-1.0);
+        Real limit = total*0.5*(1.0+std::sin(std::min((k+1.0)/factor,
+                                                      M_PI_2)));
+        for (Size i=1; i<buffer_.size(); ++i) {
+            const Centroid& c = buffer_[i];
+            if (weightSoFar + current.weight + c.weight <= limit) {
+                current.weight += c.weight;
+                current.value += (c.value-current.value)
+                               * c.weight/current.weight;
+                current.count += c.count;
+            } else {
+                weightSoFar += current.weight;
+                centroids_.push_back(current);
+                q = std::min(weightSoFar/total, 1.0);
+                k = factor*std::asin(2.0*q-1.0);
+                limit = total*0.5*(1.0+std::sin(std::min((k+1.0)/factor,
+                                                         M_PI_2)));
+                current = c;
+            }
+        }
+        centroids_.push_back(current);
+        buffer_.clear();
+    }
+
+    const std::vector<StreamingStatistics::Centroid>&
+    StreamingStatistics::points() const {
+        if (pointsValid_)
+            return points_;
+
+        std::vector<std::pair<Real,Real> > lower(lowerTail_),
+                                           upper(upperTail_);
+        std::sort(lower.begin(), lower.end());
+        std::sort(upper.begin(), upper.end());
+
+        points_.clear();
+        if (samples_ <= tailSize_) {
+            // the lower tail contains all the samples
+            for (Size i=0; i<lower.size(); ++i)
+                points_.push_back(Centroid(lower[i].first,
+                                           lower[i].second, 1.0));
+        } else if (samples_ < 2*tailSize_) {
+            // the two tails overlap and cover all the samples
+            for (Size i=0; i<lower.size(); ++i)
+                points_.push_back(Centroid(lower[i].first,
+                                           lower[i].second, 1.0));
+            for (Size i=2*tailSize_-samples_; i<upper.size(); ++i)
+                points_.push_back(Centroid(upper[i].first,
+                                           upper[i].second, 1.0));
+        } else {
+            compress();
+
+            Real lowerWeight = 0.0, upperWeight = 0.0, total = 0.0;
+            for (Size i=0; i<lower.size(); ++i) {
+                points_.push_back(Centroid(lower[i].first,
+                                           lower[i].second, 1.0));
+                lowerWeight += lower[i].second;
+            }
+            for (Size i=0; i<upper.size(); ++i)
+                upperWeight += upper[i].second;
+            for (Size i=0; i<centroids_.size(); ++i)
+                total += centroids_[i].weight;
+
+            // the digest also contains the samples in the tails,
+            // which are trimmed from its ends
+            Real end = total - upperWeight, cumulated = 0.0;
+            for (Size i=0; i<centroids_.size(); ++i) {
+                const Centroid& c = centroids_[i];
+                Real from = std::max(cumulated, lowerWeight);
+                Real to = std::min(cumulated+c.weight, end);
+                if (to > from)
+                    points_.push_back(Centroid(c.value, to-from,
+                                               c.count*(to-from)/c.weight));
+                cumulated += c.weight;
+            }
+
+            for (Size i=0; i<upper.size(); ++i)
+                points_.push_back(Centroid(upper[i].first,
+                                           upper[i].second, 1.0));
+        }
+
+        pointsValid_ = true;
+        return points_;
+    }
+
+}
@@ -0,0 +1,242 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file streamingstatistics.hpp
+    \brief statistics tool with fixed memory requirements
+*/
+
+#ifndef quantlib_streaming_statistics_hpp
+#define quantlib_streaming_statistics_hpp
+
+#include <ql/math/statistics/riskstatistics.hpp>
+#include <ql/math/statistics/sequencestatistics.hpp>
+#include <vector>
+#include <utility>
+
+namespace QuantLib {
+
+    //! Statistics tool with fixed memory requirements
+    /*! This class accumulates a set of data and returns the same
+        statistics as GeneralStatistics, but without storing the
+        samples; its memory requirements don't depend on their
+        number.
+
+        Moments are accumulated incrementally (Welford, 1962, as
+        extended to higher moments and to the merging of partial
+        results by Pebay, 2008) and are therefore exact up to
+        rounding.  The empirical distribution is described by a
+        merging t-digest (Dunning and Ertl, 2019) whose accuracy is
+        driven by the given compression, plus two buffers keeping
+        the exact smallest and largest samples.  Percentiles and
+        expectation values on the range spanned by the buffers
+        (e.g., value-at-risk and expected shortfall at a percentile
+        \f$ p \f$ when the buffer size is larger than \f$ (1-p) N
+        \f$) are the same as those returned by GeneralStatistics;
+        elsewhere, they're approximated by the digest.
+
+        Partial results (e.g., those accumulated by different
+        threads) can be combined by means of the merge() method.
+
+        \test the returned values are tested against those returned
+              by GeneralStatistics, both for a single accumulator and
+              for merged ones.
+    */
+    class StreamingStatistics {
+      public:
+        typedef Real value_type;
+        /*! \param tailSize     number of smallest and largest samples
+                                to be stored exactly.
+            \param compression  compression parameter of the digest;
+                                the number of stored centroids is of
+                                the same order.
+        */
+        explicit StreamingStatistics(Size tailSize = 1000,
+                                     Real compression = 200.0);
+        //! \name Inspectors
+        //@{
+        //! number of samples collected
+        Size samples() const;
+        //! sum of data weights
+        Real weightSum() const;
+        /*! returns the mean, defined as
+            \f[ \langle x \rangle = \frac{\sum w_i x_i}{\sum w_i}. \f]
+        */
+        Real mean() const;
+        /*! returns the variance, defined as
+            \f[ \sigma^2 = \frac{N}{N-1} \left\langle \left(
+                x-\langle x \rangle \right)^2 \right\rangle. \f]
+        */
+        Real variance() const;
+        /*! returns the standard deviation \f$ \sigma \f$, defined as the
+            square root of the variance.
+        */
+        Real standardDeviation() const;
+        /*! returns the error estimate on the mean value, defined as
+            \f$ \epsilon = \sigma/\sqrt{N}. \f$
+        */
+        Real errorEstimate() const;
+        /*! returns the skewness, defined as
+            \f[ \frac{N^2}{(N-1)(N-2)} \frac{\left\langle \left(
+                x-\langle x \rangle \right)^3 \right\rangle}{\sigma^3}. \f]
+            The above evaluates to 0 for a Gaussian distribution.
+        */
+        Real skewness() const;
+        /*! returns the excess kurtosis, defined as
+            \f[ \frac{N^2(N+1)}{(N-1)(N-2)(N-3)}
+                \frac{\left\langle \left(x-\langle x \rangle \right)^4
+                \right\rangle}{\sigma^4} - \frac{3(N-1)^2}{(N-2)(N-3)}. \f]
+            The above evaluates to 0 for a Gaussian distribution.
+        */
+        Real kurtosis() const;
+        /*! returns the minimum sample value */
+        Real min() const;
+        /*! returns the maximum sample value */
+        Real max() const;
+        /*! Expectation value of a function \f$ f \f$ on a given
+            range \f$ \mathcal{R} \f$, as in GeneralStatistics.
+            The samples in the tail buffers are used exactly; the
+            remaining ones are represented by the digest centroids.
+        */
+        template <class Func, class Predicate>
+        std::pair<Real,Size> expectationValue(const Func& f,
+                                              const Predicate& inRange) const {
+            const std::vector<Centroid>& points = this->points();
+            Real num = 0.0, den = 0.0, N = 0.0;
+            std::vector<Centroid>::const_iterator i;
+            for (i=points.begin(); i!=points.end(); ++i) {
+                Real x = i->value, w = i->weight;
+                if (inRange(x)) {
+                    num += f(x)*w;
+                    den += w;
+                    N += i->count;
+                }
+            }
+            if (N == 0.0)
+                return std::make_pair<Real,Size>(Null<Real>(),0);
+            else
+                return std::make_pair(num/den, Size(N+0.5));
+        }
+        /*! \f$ y \f$-th percentile, as defined in GeneralStatistics.
+            It is interpolated between the digest centroids if it
+            falls outside the range of the tail buffers.
+
+            \pre \f$ y \f$ must be in the range \f$ (0-1]. \f$
+        */
+        Real percentile(Real y) const;
+        /*! \f$ y \f$-th top percentile, as defined in
+            GeneralStatistics.  It is interpolated between the
+            digest centroids if it falls outside the range of the
+            tail buffers.
+
+            \pre \f$ y \f$ must be in the range \f$ (0-1]. \f$
+        */
+        Real topPercentile(Real y) const;
+        //@}
+
+        //! \name Modifiers
+        //@{
+        //! adds a datum to the set, possibly with a weight
+        void add(Real value, Real weight = 1.0);
+        //! adds a sequence of data to the set, with default weight
+        template <class DataIterator>
+        void addSequence(DataIterator begin, DataIterator end) {
+            for (;begin!=end;++begin)
+                add(*begin);
+        }
+        //! adds a sequence of data to the set, each with its weight
+        template <class DataIterator, class WeightIterator>
+        void addSequence(DataIterator begin, DataIterator end,
+                         WeightIterator wbegin) {
+            for (;begin!=end;++begin,++wbegin)
+                add(*begin, *wbegin);
+        }
+        //! adds the data collected by another instance
+        void merge(const StreamingStatistics& other);
+        //! resets the data to a null set
+        void reset();
+        //@}
+      private:
+        struct Centroid {
+            Centroid(Real value, Real weight, Real count)
+            : value(value), weight(weight), count(count) {}
+            Real value, weight, count;
+            bool operator<(const Centroid& c) const {
+                return value < c.value;
+            }
+        };
+        void addMoments(Real weight, Real mean,
+                        Real m2, Real m3, Real m4);
+        void addToLowerTail(const std::pair<Real,Real>& sample);
+        void addToUpperTail(const std::pair<Real,Real>& sample);
+        void compress() const;
+        Real quantile(Real percent, bool fromTop) const;
+        const std::vector<Centroid>& points() const;
+        Size tailSize_;
+        Real compression_;
+        Size samples_;
+        Real weightSum_, mean_, m2_, m3_, m4_, min_, max_;
+        // max-heap of the smallest samples and min-heap of the largest
+        std::vector<std::pair<Real,Real> > lowerTail_, upperTail_;
+        mutable std::vector<Centroid> centroids_, buffer_;
+        // sorted representation of the distribution, built on demand
+        mutable std::vector<Centroid> points_;
+        mutable bool pointsValid_;
+    };
+
+
+    //! streaming statistics tool with risk measures
+    typedef GenericRiskStatistics<GenericGaussianStatistics<
+                                     StreamingStatistics> >
+                                                    StreamingRiskStatistics;
+
+    //! streaming statistics tool for sequences
+    typedef GenericSequenceStatistics<StreamingRiskStatistics>
+                                                SequenceStreamingStatistics;
+
+
+    // inline definitions
+
+    inline Size StreamingStatistics::samples() const {
+        return samples_;
+    }
+
+    inline Real StreamingStatistics::weightSum() const {
+        return weightSum_;
+    }
+
+    inline Real StreamingStatistics::standardDeviation() const {
+        return std::sqrt(variance());
+    }
+
+    inline Real StreamingStatistics::errorEstimate() const {
+        return std::sqrt(variance()/samples());
+    }
+
+    inline Real StreamingStatistics::min() const {
+        QL_REQUIRE(samples() > 0, "empty sample set");
+        return min_;
+    }
+
+    inline Real StreamingStatistics::max() const {
+        QL_REQUIRE(samples() > 0, "empty sample set");
+        return max_;
+    }
+
+}
+
+
+#endif
@@ -119,14 +119,26 @@ namespace QuantLib {
                 new LinearInterpolation(x.begin(), x.end(), f.row_begin(i)));
         }
         
-        Array integral(r.size());
-        for (FdmLinearOpIterator iter=layout->begin(); iter!=endIter; ++iter) {
-            const Size i = iter.coordinates()[0];
-            const Size j = iter.coordinates()[1];
+        // checked here, since exceptions can't leave the parallel loop
+        for (FdmBoundaryConditionSet::const_iterator iter=bcSet_.begin();
+            iter < bcSet_.end(); ++iter) {
+            QL_REQUIRE(boost::dynamic_pointer_cast<FdmDirichletBoundary>(*iter),
+                       "FdmBatesOp can only deal with Dirichlet "
+                       "boundary conditions.");
+        }
 
-            integral[iter.index()] = M_1_SQRTPI* 
-                gaussHermiteIntegration_(
+        // the integrals are independent; the grid is traversed by
+        // index rather than by iterator so that rows can be
+        // distributed among threads on large grids.
+        const Size nx = layout->dim()[0], ny = layout->dim()[1];
+        Array integral(r.size());
+        #pragma omp parallel for if (r.size() > 1000)
+        for (Size j=0; j < ny; ++j) {
+            for (Size i=0; i < nx; ++i) {
+                integral[i + j*nx] = M_1_SQRTPI*
+                    gaussHermiteIntegration_(
                       IntegroIntegrand(interpl[j], bcSet_, x[i], delta_, nu_));
+            }
         }
 
         return lambda_*(integral-r);
@@ -46,10 +46,38 @@ namespace QuantLib {
       dxxMap_(SecondDerivativeOp(direction, mesher)),
       mapT_  (direction, mesher),
       strike_(strike),
+      strikeDirection_(0),
       illegalLocalVolOverwrite_(illegalLocalVolOverwrite),
       direction_(direction) {
     }
 
+    FdmBlackScholesOp::FdmBlackScholesOp(
+        const boost::shared_ptr<FdmMesher>& mesher,
+        const boost::shared_ptr<GeneralizedBlackScholesProcess> & bsProcess,
+        const std::vector<Real>& strikes,
+        Size strikeDirection,
+        Size direction)
+    : mesher_(mesher),
+      rTS_   (bsProcess->riskFreeRate().currentLink()),
+      qTS_   (bsProcess->dividendYield().currentLink()),
+      volTS_ (bsProcess->blackVolatility().currentLink()),
+      dxMap_ (FirstDerivativeOp(direction, mesher)),
+      dxxMap_(SecondDerivativeOp(direction, mesher)),
+      mapT_  (direction, mesher),
+      strike_(Null<Real>()),
+      strikes_(strikes),
+      strikeDirection_(strikeDirection),
+      illegalLocalVolOverwrite_(-Null<Real>()),
+      direction_(direction) {
+        QL_REQUIRE(strikeDirection != direction,
+                   "strikes and underlying must run along "
+                   "different directions");
+        QL_REQUIRE(mesher->layout()->dim()[strikeDirection] == strikes.size(),
+                   "wrong number of strikes (" << strikes.size() << ", "
+                   << mesher->layout()->dim()[strikeDirection]
+                   << " required)");
+    }
+
     void FdmBlackScholesOp::setTime(Time t1, Time t2) {
         const Rate r = rTS_->forwardRate(t1, t2, Continuous).rate();
         const Rate q = qTS_->forwardRate(t1, t2, Continuous).rate();
@@ -80,6 +108,24 @@ namespace QuantLib {
             mapT_.axpyb(r - q - 0.5*v, dxMap_,
                         dxxMap_.mult(0.5*v), Array(1, -r));
         }
+        else if (!strikes_.empty()) {
+            std::vector<Real> lineVariance(strikes_.size());
+            for (Size i=0; i < strikes_.size(); ++i)
+                lineVariance[i] = volTS_->blackForwardVariance(
+                                                t1, t2, strikes_[i])/(t2-t1);
+
+            const boost::shared_ptr<FdmLinearOpLayout> layout=mesher_->layout();
+            const FdmLinearOpIterator endIter = layout->end();
+
+            Array v(layout->size());
+            for (FdmLinearOpIterator iter = layout->begin();
+                 iter!=endIter; ++iter) {
+                v[iter.index()]
+                    = lineVariance[iter.coordinates()[strikeDirection_]];
+            }
+            mapT_.axpyb(r - q - 0.5*v, dxMap_,
+                        dxxMap_.mult(0.5*v), Array(1, -r));
+        }
         else {
             const Real v
                 = volTS_->blackForwardVariance(t1, t2, strike_)/(t2-t1);
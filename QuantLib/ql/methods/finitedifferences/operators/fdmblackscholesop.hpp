@@ -43,6 +43,17 @@ namespace QuantLib {
             bool localVol = false,
             Real illegalLocalVolOverwrite = -Null<Real>(),
             Size direction = 0);
+        /*! Operator for a batch of options sharing the same grid, each
+            of them corresponding to one coordinate along the direction
+            \c strikeDirection; the volatility on each grid line is
+            the one implied at the strike of the corresponding option.
+        */
+        FdmBlackScholesOp(
+            const boost::shared_ptr<FdmMesher>& mesher,
+            const boost::shared_ptr<GeneralizedBlackScholesProcess>& process,
+            const std::vector<Real>& strikes,
+            Size strikeDirection,
+            Size direction = 0);
 
         Size size() const;
         void setTime(Time t1, Time t2);
@@ -68,6 +79,8 @@ namespace QuantLib {
         const TripleBandLinearOp dxxMap_;
         TripleBandLinearOp mapT_;
         const Real strike_;
+        const std::vector<Real> strikes_;
+        const Size strikeDirection_;
         const Real illegalLocalVolOverwrite_;
         const Size direction_;
     };
@@ -36,11 +36,22 @@ namespace QuantLib {
         typedef Array array_type;
         virtual ~FdmLinearOp() { }
         virtual Disposable<array_type> apply(const array_type& r) const = 0;
+        /*! stores the result of apply(r) into out, which is resized
+            if needed and must not be the same array as r.  The
+            default implementation calls apply(r); operators can
+            override it to reuse the storage of out.
+        */
+        virtual void apply_into(const array_type& r, array_type& out) const;
 
 #if !defined(QL_NO_UBLAS_SUPPORT)
         virtual Disposable<SparseMatrix> toMatrix() const = 0;
 #endif
     };
+
+    inline void FdmLinearOp::apply_into(const array_type& r,
+                                        array_type& out) const {
+        out = apply(r);
+    }
 }
 
 #endif
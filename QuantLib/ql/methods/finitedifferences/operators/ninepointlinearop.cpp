@@ -130,12 +130,23 @@ namespace QuantLib {
 
     Disposable<Array> NinePointLinearOp::apply(const Array& u)
         const {
+        Array retVal(u.size());
+        apply_into(u, retVal);
+        return retVal;
+    }
+
+    void NinePointLinearOp::apply_into(const Array& u, Array& retVal)
+        const {
 
         const boost::shared_ptr<FdmLinearOpLayout> index=mesher_->layout();
         QL_REQUIRE(u.size() == index->size(),"inconsistent length of r "
                     << u.size() << " vs " << index->size());
+        QL_REQUIRE(&u != &retVal,
+                   "result cannot be stored into the operand");
+
+        if (retVal.size() != u.size())
+            Array(u.size()).swap(retVal);
 
-        Array retVal(u.size());
         // direct access to make the following code faster.
         const Real *a00(a00_.get()), *a01(a01_.get()), *a02(a02_.get());
         const Real *a10(a10_.get()), *a11(a11_.get()), *a12(a12_.get());
@@ -143,9 +154,11 @@ namespace QuantLib {
         const Size *i00(i00_.get()), *i01(i01_.get()), *i02(i02_.get());
         const Size *i10(i10_.get()),                   *i12(i12_.get());
         const Size *i20(i20_.get()), *i21(i21_.get()), *i22(i22_.get());
+        const Size size = retVal.size();
 
-        //#pragma omp parallel for
-        for (Size i=0; i < retVal.size(); ++i) {
+        // small grids aren't worth the thread overhead
+        #pragma omp parallel for if (size > 1000)
+        for (Size i=0; i < size; ++i) {
             retVal[i] =   a00[i]*u[i00[i]]
                         + a01[i]*u[i01[i]]
                         + a02[i]*u[i02[i]]
@@ -156,7 +169,6 @@ namespace QuantLib {
                         + a21[i]*u[i21[i]]
                         + a22[i]*u[i22[i]];
         }
-        return retVal;
     }
 
 #if !defined(QL_NO_UBLAS_SUPPORT)
@@ -188,7 +200,7 @@ namespace QuantLib {
         NinePointLinearOp retVal(d0_, d1_, mesher_);
         const Size size = mesher_->layout()->size();
 
-        //#pragma omp parallel for
+        #pragma omp parallel for if (size > 1000)
         for (Size i=0; i < size; ++i) {
             const Real s = u[i];
             retVal.a11_[i]=a11_[i]*s; retVal.a00_[i]=a00_[i]*s;
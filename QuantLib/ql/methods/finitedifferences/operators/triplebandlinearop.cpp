@@ -23,6 +23,8 @@
 #include <ql/methods/finitedifferences/tridiagonaloperator.hpp>
 #include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
 #include <ql/methods/finitedifferences/operators/triplebandlinearop.hpp>
+#include <algorithm>
+#include <vector>
 
 namespace QuantLib {
 
@@ -32,7 +34,6 @@ namespace QuantLib {
     : direction_(direction),
       i0_       (new Size[mesher->layout()->size()]),
       i2_       (new Size[mesher->layout()->size()]),
-      reverseIndex_ (new Size[mesher->layout()->size()]),
       lower_    (new Real[mesher->layout()->size()]),
       diag_     (new Real[mesher->layout()->size()]),
       upper_    (new Real[mesher->layout()->size()]),
@@ -41,22 +42,11 @@ namespace QuantLib {
         const boost::shared_ptr<FdmLinearOpLayout> layout = mesher->layout();
         const FdmLinearOpIterator endIter = layout->end();
 
-        std::vector<Size> newDim(layout->dim());
-        std::iter_swap(newDim.begin(), newDim.begin()+direction_);
-        std::vector<Size> newSpacing = FdmLinearOpLayout(newDim).spacing();
-        std::iter_swap(newSpacing.begin(), newSpacing.begin()+direction_);
-
         for (FdmLinearOpIterator iter = layout->begin(); iter!=endIter; ++iter) {
             const Size i = iter.index();
 
             i0_[i] = layout->neighbourhood(iter, direction, -1);
             i2_[i] = layout->neighbourhood(iter, direction,  1);
-
-            const std::vector<Size>& coordinates = iter.coordinates();
-            const Size newIndex =
-                  std::inner_product(coordinates.begin(), coordinates.end(),
-                                     newSpacing.begin(), Size(0));
-            reverseIndex_[newIndex] = i;
         }
     }
 
@@ -64,7 +54,6 @@ namespace QuantLib {
     : direction_(m.direction_),
       i0_   (new Size[m.mesher_->layout()->size()]),
       i2_   (new Size[m.mesher_->layout()->size()]),
-      reverseIndex_(new Size[m.mesher_->layout()->size()]),
       lower_(new Real[m.mesher_->layout()->size()]),
       diag_ (new Real[m.mesher_->layout()->size()]),
       upper_(new Real[m.mesher_->layout()->size()]),
@@ -72,8 +61,6 @@ namespace QuantLib {
         const Size len = m.mesher_->layout()->size();
         std::copy(m.i0_.get(), m.i0_.get() + len, i0_.get());
         std::copy(m.i2_.get(), m.i2_.get() + len, i2_.get());
-        std::copy(m.reverseIndex_.get(), m.reverseIndex_.get()+len,
-                  reverseIndex_.get());
         std::copy(m.lower_.get(), m.lower_.get() + len, lower_.get());
         std::copy(m.diag_.get(),  m.diag_.get() + len,  diag_.get());
         std::copy(m.upper_.get(), m.upper_.get() + len, upper_.get());
@@ -103,7 +90,6 @@ namespace QuantLib {
         std::swap(direction_, m.direction_);
 
         i0_.swap(m.i0_); i2_.swap(m.i2_);
-        reverseIndex_.swap(m.reverseIndex_);
         lower_.swap(m.lower_); diag_.swap(m.diag_); upper_.swap(m.upper_);
     }
 
@@ -121,9 +107,10 @@ namespace QuantLib {
         const Real *y_lower(y.lower_.get());
         const Real *y_upper(y.upper_.get());
 
+        // here and below, small grids aren't worth the thread overhead
         if (a.empty()) {
             if (b.empty()) {
-                //#pragma omp parallel for
+                #pragma omp parallel for if (size > 1000)
                 for (Size i=0; i < size; ++i) {
                     diag[i]  = y_diag[i];
                     lower[i] = y_lower[i];
@@ -133,7 +120,7 @@ namespace QuantLib {
             else {
                 Array::const_iterator bptr(b.begin());
                 const Size binc = (b.size() > 1) ? 1 : 0;
-                //#pragma omp parallel for
+                #pragma omp parallel for if (size > 1000)
                 for (Size i=0; i < size; ++i) {
                     diag[i]  = y_diag[i] + bptr[i*binc];
                     lower[i] = y_lower[i];
@@ -149,7 +136,7 @@ namespace QuantLib {
             const Real *x_lower(x.lower_.get());
             const Real *x_upper(x.upper_.get());
 
-            //#pragma omp parallel for
+            #pragma omp parallel for if (size > 1000)
             for (Size i=0; i < size; ++i) {
                 const Real s = aptr[i*ainc];
                 diag[i]  = y_diag[i]  + s*x_diag[i];
@@ -168,7 +155,7 @@ namespace QuantLib {
             const Real *x_lower(x.lower_.get());
             const Real *x_upper(x.upper_.get());
 
-            //#pragma omp parallel for
+            #pragma omp parallel for if (size > 1000)
             for (Size i=0; i < size; ++i) {
                 const Real s = aptr[i*ainc];
                 diag[i]  = y_diag[i]  + s*x_diag[i] + bptr[i*binc];
@@ -183,7 +170,7 @@ namespace QuantLib {
 
         TripleBandLinearOp retVal(direction_, mesher_);
         const Size size = mesher_->layout()->size();
-        //#pragma omp parallel for
+        #pragma omp parallel for if (size > 1000)
         for (Size i=0; i < size; ++i) {
             retVal.lower_[i]= lower_[i] + m.lower_[i];
             retVal.diag_[i] = diag_[i]  + m.diag_[i];
@@ -199,7 +186,7 @@ namespace QuantLib {
         TripleBandLinearOp retVal(direction_, mesher_);
 
         const Size size = mesher_->layout()->size();
-        //#pragma omp parallel for
+        #pragma omp parallel for if (size > 1000)
         for (Size i=0; i < size; ++i) {
             const Real s = u[i];
             retVal.lower_[i]= lower_[i]*s;
@@ -215,7 +202,7 @@ namespace QuantLib {
         TripleBandLinearOp retVal(direction_, mesher_);
 
         const Size size = mesher_->layout()->size();
-        //#pragma omp parallel for
+        #pragma omp parallel for if (size > 1000)
         for (Size i=0; i < size; ++i) {
             retVal.lower_[i]= lower_[i];
             retVal.upper_[i]= upper_[i];
@@ -226,23 +213,31 @@ namespace QuantLib {
     }
 
     Disposable<Array> TripleBandLinearOp::apply(const Array& r) const {
+        array_type retVal(r.size());
+        apply_into(r, retVal);
+        return retVal;
+    }
+
+    void TripleBandLinearOp::apply_into(const Array& r, Array& out) const {
         const boost::shared_ptr<FdmLinearOpLayout> index = mesher_->layout();
 
         QL_REQUIRE(r.size() == index->size(), "inconsistent length of r");
+        QL_REQUIRE(&r != &out, "result cannot be stored into the operand");
+
+        if (out.size() != r.size())
+            Array(r.size()).swap(out);
 
         const Real* lptr = lower_.get();
         const Real* dptr = diag_.get();
         const Real* uptr = upper_.get();
         const Size* i0ptr = i0_.get();
         const Size* i2ptr = i2_.get();
+        const Size size = index->size();
 
-        array_type retVal(r.size());
-        //#pragma omp parallel for
-        for (Size i=0; i < index->size(); ++i) {
-            retVal[i] = r[i0ptr[i]]*lptr[i]+r[i]*dptr[i]+r[i2ptr[i]]*uptr[i];
+        #pragma omp parallel for if (size > 1000)
+        for (Size i=0; i < size; ++i) {
+            out[i] = r[i0ptr[i]]*lptr[i]+r[i]*dptr[i]+r[i2ptr[i]]*uptr[i];
         }
-
-        return retVal;
     }
 
 #if !defined(QL_NO_UBLAS_SUPPORT)
@@ -278,35 +273,74 @@ namespace QuantLib {
         }
 #endif
 
-        Array retVal(r.size()), tmp(r.size());
-
+        // The system decouples into independent tridiagonal systems,
+        // one for each grid line along the given direction. Points
+        // on a line are stride apart, while the corresponding points
+        // of neighbouring lines are contiguous; therefore, lines are
+        // solved in blocks, with the inner loops running across the
+        // lines of a block so that memory is accessed sequentially
+        // and the loops can be vectorized. Blocks are independent
+        // and are distributed among threads.
+        const Size n = layout->dim()[direction_];
+        const Size stride = layout->spacing()[direction_];
+        const Size blockSize = std::min(stride, Size(16));
+        const Size blocksPerSlice = (stride + blockSize - 1)/blockSize;
+        const Size nBlocks = layout->size()/(n*stride)*blocksPerSlice;
+
+        Array retVal(r.size());
+
+        const Real* rptr = r.begin();
         const Real* lptr = lower_.get();
         const Real* dptr = diag_.get();
         const Real* uptr = upper_.get();
-
-        // Thomson algorithm to solve a tridiagonal system.
-        // Example code taken from Tridiagonalopertor and
-        // changed to fit for the triple band operator.
-        Size rim1 = reverseIndex_[0];
-        Real bet=1.0/(a*dptr[rim1]+b);
-        QL_REQUIRE(bet != 0.0, "division by zero");
-        retVal[reverseIndex_[0]] = r[rim1]*bet;
-
-        for (Size j=1; j<=layout->size()-1; j++){
-            const Size ri = reverseIndex_[j];
-            tmp[j] = a*uptr[rim1]*bet;
-
-            bet=b+a*(dptr[ri]-tmp[j]*lptr[ri]);
-            QL_ENSURE(bet != 0.0, "division by zero");
-            bet=1.0/bet;
-
-            retVal[ri] = (r[ri]-a*lptr[ri]*retVal[rim1])*bet;
-            rim1 = ri;
+        Real* xptr = retVal.begin();
+
+        // not a vector<bool>, which can't be written by different threads
+        std::vector<char> singular(nBlocks, 0);
+
+        #pragma omp parallel if (r.size() > 1000)
+        {
+            std::vector<Real> tmp(n*blockSize), bet(blockSize);
+
+            #pragma omp for
+            for (Size blk=0; blk < nBlocks; ++blk) {
+                const Size first = (blk % blocksPerSlice)*blockSize;
+                const Size offset = (blk / blocksPerSlice)*n*stride + first;
+                const Size m = std::min(blockSize, stride - first);
+
+                // Thomas algorithm, as in TridiagonalOperator
+                for (Size k=0; k < m; ++k) {
+                    const Size i = offset + k;
+                    const Real den = a*dptr[i]+b;
+                    if (den == 0.0)
+                        singular[blk] = 1;
+                    bet[k] = 1.0/den;
+                    xptr[i] = rptr[i]*bet[k];
+                }
+                for (Size j=1; j < n; ++j) {
+                    const Size row = offset + j*stride;
+                    Real* t = &tmp[j*blockSize];
+                    for (Size k=0; k < m; ++k) {
+                        const Size i = row + k;
+                        t[k] = a*uptr[i-stride]*bet[k];
+                        const Real den = b+a*(dptr[i]-t[k]*lptr[i]);
+                        if (den == 0.0)
+                            singular[blk] = 1;
+                        bet[k] = 1.0/den;
+                        xptr[i] = (rptr[i]-a*lptr[i]*xptr[i-stride])*bet[k];
+                    }
+                }
+                for (Size j=n-1; j > 0; --j) {
+                    const Size row = offset + (j-1)*stride;
+                    const Real* t = &tmp[j*blockSize];
+                    for (Size k=0; k < m; ++k)
+                        xptr[row+k] -= t[k]*xptr[row+stride+k];
+                }
+            }
         }
-        // cannot be j>=0 with Size j
-        for (Size j=layout->size()-2; j>0; --j)
-            retVal[reverseIndex_[j]] -= tmp[j+1]*retVal[reverseIndex_[j+1]];
-        retVal[reverseIndex_[0]] -= tmp[1]*retVal[reverseIndex_[1]];
+
+        QL_ENSURE(std::find(singular.begin(), singular.end(), 1)
+                  == singular.end(), "division by zero");
 
         return retVal;
     }
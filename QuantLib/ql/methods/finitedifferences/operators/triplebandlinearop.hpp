@@ -44,6 +44,7 @@ namespace QuantLib {
         TripleBandLinearOp& operator=(const Disposable<TripleBandLinearOp>& m);
 
         Disposable<Array> apply(const Array& r) const;
+        void apply_into(const Array& r, Array& out) const;
         Disposable<Array> solve_splitting(const Array& r, Real a,
                                           Real b = 1.0) const;
 
@@ -66,7 +67,6 @@ namespace QuantLib {
 
         Size direction_;
         boost::shared_array<Size> i0_, i2_;
-        boost::shared_array<Size> reverseIndex_;
         boost::shared_array<Real> lower_, diag_, upper_;
 
         boost::shared_ptr<FdmMesher> mesher_;
@@ -31,7 +31,8 @@ namespace QuantLib {
         theta_(theta),
         mu_   (mu),
         map_  (map),
-        bcSet_(bcSet) {
+        bcSet_(bcSet),
+        splitting_(map) {
     }
 
     void CraigSneydScheme::step(array_type& a, Time t) {
@@ -41,27 +42,27 @@ namespace QuantLib {
         bcSet_.setTime(std::max(0.0, t-dt_));
 
         bcSet_.applyBeforeApplying(*map_);
-        Array y = a + dt_*map_->apply(a);
-        bcSet_.applyAfterApplying(y);
+        y_ = map_->apply(a);
+        SplittingSchemeHelper::axpy(dt_, y_, a, y_);
+        bcSet_.applyAfterApplying(y_);
 
-        Array y0 = y;
+        SplittingSchemeHelper::copy(y_, y0_);
 
-        for (Size i=0; i < map_->size(); ++i) {
-            Array rhs = y - theta_*dt_*map_->apply_direction(i, a);
-            y = map_->solve_splitting(i, rhs, -theta_*dt_);
-        }
+        splitting_.applyDirections(a);
+        splitting_.sweep(y_, theta_*dt_);
+
+        SplittingSchemeHelper::axpy(-1.0, a, y_, diff_);
 
         bcSet_.applyBeforeApplying(*map_);
-        Array yt = y0 + mu_*dt_*map_->apply_mixed(y-a);
-        bcSet_.applyAfterApplying(yt);
+        yt_ = map_->apply_mixed(diff_);
+        SplittingSchemeHelper::axpy(mu_*dt_, yt_, y0_, yt_);
+        bcSet_.applyAfterApplying(yt_);
 
-        for (Size i=0; i < map_->size(); ++i) {
-            Array rhs = yt - theta_*dt_*map_->apply_direction(i, a);
-            yt = map_->solve_splitting(i, rhs, -theta_*dt_);
-        }
-        bcSet_.applyAfterSolving(yt);
+        // the explicit parts of the first sweep are used again
+        splitting_.sweep(yt_, theta_*dt_);
+        bcSet_.applyAfterSolving(yt_);
 
-        a = yt;
+        a.swap(yt_);
     }
 
     void CraigSneydScheme::setStep(Time dt) {
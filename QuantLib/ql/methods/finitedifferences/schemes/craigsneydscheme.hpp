@@ -29,6 +29,7 @@
 #include <ql/methods/finitedifferences/operatortraits.hpp>
 #include <ql/methods/finitedifferences/operators/fdmlinearopcomposite.hpp>
 #include <ql/methods/finitedifferences/schemes/boundaryconditionschemehelper.hpp>
+#include <ql/methods/finitedifferences/schemes/splittingschemehelper.hpp>
 
 namespace QuantLib {
 
@@ -55,6 +56,8 @@ namespace QuantLib {
         const Real mu_;
         const boost::shared_ptr<FdmLinearOpComposite> map_;
         const BoundaryConditionSchemeHelper bcSet_;
+        SplittingSchemeHelper splitting_;
+        Array y_, y0_, yt_, diff_;
     };
 }
 
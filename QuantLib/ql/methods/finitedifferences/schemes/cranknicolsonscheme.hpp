@@ -0,0 +1,71 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file cranknicolsonscheme.hpp
+    \brief Crank-Nicolson scheme
+*/
+
+#ifndef quantlib_crank_nicolson_scheme_hpp
+#define quantlib_crank_nicolson_scheme_hpp
+
+#include <ql/methods/finitedifferences/schemes/expliciteulerscheme.hpp>
+#include <ql/methods/finitedifferences/schemes/impliciteulerscheme.hpp>
+
+namespace QuantLib {
+
+    //! theta scheme without operator splitting
+    /*! Each step is an explicit Euler step weighted by 1-theta
+        followed by an implicit Euler step weighted by theta; the
+        default theta of 0.5 gives the Crank-Nicolson scheme.  The
+        implicit part is solved for the full operator with the given
+        linear solver; see ImplicitEulerScheme.
+    */
+    class CrankNicolsonScheme  {
+      public:
+        // typedefs
+        typedef OperatorTraits<FdmLinearOp> traits;
+        typedef traits::operator_type operator_type;
+        typedef traits::array_type array_type;
+        typedef traits::bc_set bc_set;
+        typedef traits::condition_type condition_type;
+
+        // constructors
+        CrankNicolsonScheme(
+            Real theta,
+            const boost::shared_ptr<FdmLinearOpComposite>& map,
+            const bc_set& bcSet = bc_set(),
+            Real relTol = 1e-8,
+            ImplicitEulerScheme::SolverType solverType
+                                            = ImplicitEulerScheme::BiCGstab);
+
+        void step(array_type& a, Time t);
+        void setStep(Time dt);
+
+        //! total number of iterations of the linear solver
+        Size numberOfIterations() const;
+        //! number of factorizations computed by the banded LU solver
+        Size numberOfFactorizations() const;
+
+      protected:
+        Real dt_;
+        const Real theta_;
+        ExplicitEulerScheme explicit_;
+        ImplicitEulerScheme implicit_;
+    };
+}
+
+#endif
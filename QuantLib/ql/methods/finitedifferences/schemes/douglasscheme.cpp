@@ -29,7 +29,8 @@ namespace QuantLib {
     : dt_(Null<Real>()),
       theta_(theta),
       map_(map),
-      bcSet_(bcSet) {
+      bcSet_(bcSet),
+      splitting_(map) {
     }
 
     void DouglasScheme::step(array_type& a, Time t) {
@@ -38,16 +39,15 @@ namespace QuantLib {
         bcSet_.setTime(std::max(0.0, t-dt_));
 
         bcSet_.applyBeforeApplying(*map_);
-        Array y = a + dt_*map_->apply(a);
-        bcSet_.applyAfterApplying(y);
+        y_ = map_->apply(a);
+        SplittingSchemeHelper::axpy(dt_, y_, a, y_);
+        bcSet_.applyAfterApplying(y_);
 
-        for (Size i=0; i < map_->size(); ++i) {
-            Array rhs = y - theta_*dt_*map_->apply_direction(i, a);
-            y = map_->solve_splitting(i, rhs, -theta_*dt_);
-        }
-        bcSet_.applyAfterSolving(y);
+        splitting_.applyDirections(a);
+        splitting_.sweep(y_, theta_*dt_);
+        bcSet_.applyAfterSolving(y_);
 
-        a = y;
+        a.swap(y_);
     }
 
     void DouglasScheme::setStep(Time dt) {
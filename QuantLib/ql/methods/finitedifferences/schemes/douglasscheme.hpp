@@ -29,6 +29,7 @@
 #include <ql/methods/finitedifferences/operatortraits.hpp>
 #include <ql/methods/finitedifferences/operators/fdmlinearopcomposite.hpp>
 #include <ql/methods/finitedifferences/schemes/boundaryconditionschemehelper.hpp>
+#include <ql/methods/finitedifferences/schemes/splittingschemehelper.hpp>
 
 namespace QuantLib {
 
@@ -54,6 +55,8 @@ namespace QuantLib {
         const Real theta_;
         const boost::shared_ptr<FdmLinearOpComposite> map_;
         const BoundaryConditionSchemeHelper bcSet_;
+        SplittingSchemeHelper splitting_;
+        Array y_;
     };
 }
 
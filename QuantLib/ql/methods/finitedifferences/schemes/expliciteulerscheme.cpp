@@ -28,13 +28,13 @@ namespace QuantLib {
             dt_(Null<Real>()), map_(map), bcSet_(bcSet) {
     }
 
-    void ExplicitEulerScheme::step(array_type& a, Time t) {
+    void ExplicitEulerScheme::step(array_type& a, Time t, Real theta) {
         QL_REQUIRE(t-dt_ > -1e-8, "a step towards negative time given");
         map_->setTime(std::max(0.0, t - dt_), t);
         bcSet_.setTime(std::max(0.0, t-dt_));
 
         bcSet_.applyBeforeApplying(*map_);
-        a += dt_ * map_->apply(a);
+        a += (theta*dt_) * map_->apply(a);
         bcSet_.applyAfterApplying(a);
     }
 
@@ -46,7 +46,8 @@ namespace QuantLib {
             const boost::shared_ptr<FdmLinearOpComposite>& map,
             const bc_set& bcSet = bc_set());
 
-        void step(array_type& a, Time t);
+        //! a theta other than one gives the explicit part of a theta scheme
+        void step(array_type& a, Time t, Real theta = 1.0);
         void setStep(Time dt);
 
       protected:
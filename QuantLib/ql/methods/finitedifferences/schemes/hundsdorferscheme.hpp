@@ -30,6 +30,7 @@
 #include <ql/methods/finitedifferences/operatortraits.hpp>
 #include <ql/methods/finitedifferences/operators/fdmlinearopcomposite.hpp>
 #include <ql/methods/finitedifferences/schemes/boundaryconditionschemehelper.hpp>
+#include <ql/methods/finitedifferences/schemes/splittingschemehelper.hpp>
 
 #include <vector>
 
@@ -59,6 +60,8 @@ namespace QuantLib {
 
         const boost::shared_ptr<FdmLinearOpComposite> map_;
         const BoundaryConditionSchemeHelper bcSet_;
+        SplittingSchemeHelper splitting_;
+        Array y_, y0_, yt_, diff_;
     };
 }
 
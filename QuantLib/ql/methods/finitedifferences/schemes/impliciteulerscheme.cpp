@@ -19,7 +19,9 @@
  FOR A PARTICULAR PURPOSE.  See the license for more details.
 */
 
+#include <ql/math/matrixutilities/gmres.hpp>
 #include <ql/math/matrixutilities/bicgstab.hpp>
+#include <ql/math/matrixutilities/bandedludecomposition.hpp>
 #include <ql/methods/finitedifferences/schemes/impliciteulerscheme.hpp>
 #if defined(__GNUC__) && (((__GNUC__ == 4) && (__GNUC_MINOR__ >= 8)) || (__GNUC__ > 4))
 #pragma GCC diagnostic push
@@ -30,43 +32,124 @@
 #pragma GCC diagnostic pop
 #endif
 #include <boost/function.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
     ImplicitEulerScheme::ImplicitEulerScheme(
         const boost::shared_ptr<FdmLinearOpComposite>& map,
         const bc_set& bcSet,
-        Real relTol)
+        Real relTol,
+        SolverType solverType)
     : dt_    (Null<Real>()),
+      iterations_(0), factorizations_(0),
       relTol_(relTol),
       map_   (map),
-      bcSet_ (bcSet) {
+      bcSet_ (bcSet),
+      solverType_(solverType),
+      factor_(Null<Real>()) {
     }
 
-    Disposable<Array> ImplicitEulerScheme::apply(const Array& r) const {
-        return r - dt_*map_->apply(r);
+    Disposable<Array> ImplicitEulerScheme::apply(const Array& r,
+                                                 Real theta) const {
+        return r - (theta*dt_)*map_->apply(r);
     }
 
-    void ImplicitEulerScheme::step(array_type& a, Time t) {
+    void ImplicitEulerScheme::step(array_type& a, Time t, Real theta) {
         QL_REQUIRE(t-dt_ > -1e-8, "a step towards negative time given");
         map_->setTime(std::max(0.0, t-dt_), t);
         bcSet_.setTime(std::max(0.0, t-dt_));
 
         bcSet_.applyBeforeSolving(*map_, a);
 
-        a = BiCGstab(
-                boost::function<Disposable<Array>(const Array&)>(
-                    boost::bind(&ImplicitEulerScheme::apply, this, _1)), 
-                10*a.size(), relTol_,
-                boost::function<Disposable<Array>(const Array&)>(
-                    boost::bind(&FdmLinearOpComposite::preconditioner, 
-                                map_, _1, -dt_))
-            ).solve(a).x;
-        
+        const boost::function<Disposable<Array>(const Array&)>
+            applyF(boost::bind(&ImplicitEulerScheme::apply, this, _1, theta));
+        const boost::function<Disposable<Array>(const Array&)>
+            preconditioner(boost::bind(&FdmLinearOpComposite::preconditioner,
+                                       map_, _1, -theta*dt_));
+
+        if (solverType_ == BiCGstab) {
+            const BiCGStabResult result =
+                QuantLib::BiCGstab(applyF, 10*a.size(), relTol_,
+                                   preconditioner).solve(a);
+
+            iterations_ += result.iterations;
+            a = result.x;
+        }
+        else if (solverType_ == GMRES) {
+            // restarted every few iterations to bound the memory use;
+            // the previous values are a good initial guess.
+            const GMRESResult result =
+                QuantLib::GMRES(applyF, 20, relTol_, preconditioner)
+                    .solveWithRestart(a.size()/2+1, a, a);
+
+            iterations_ += result.iterations;
+            a = result.x;
+        }
+        else if (solverType_ == BandedLU) {
+            solveBandedLU(a, theta);
+        }
+        else
+            QL_FAIL("unknown/illegal solver type");
+
         bcSet_.applyAfterSolving(a);
     }
 
+    void ImplicitEulerScheme::solveBandedLU(array_type& a, Real theta) {
+        #if !defined(QL_NO_UBLAS_SUPPORT)
+        const SparseMatrix m = map_->toMatrix();
+
+        const Size n = m.filled1();
+        const Size nonZeros = m.filled2();
+        const SparseMatrix::index_array_type& rows = m.index1_data();
+        const SparseMatrix::index_array_type& columns = m.index2_data();
+        const SparseMatrix::value_array_type& values = m.value_data();
+
+        // the factorization is reused if the operator is unchanged
+        // up to the tolerance of the iterative solvers
+        bool unchanged = lu_ && theta*dt_ == factor_
+            && rows_.size() == n && columns_.size() == nonZeros
+            && std::equal(rows_.begin(), rows_.end(), rows.begin())
+            && std::equal(columns_.begin(), columns_.end(), columns.begin());
+        if (unchanged) {
+            Real maxValue = 0.0, maxChange = 0.0;
+            for (Size i=0; i < nonZeros; ++i) {
+                maxValue = std::max(maxValue, std::fabs(values_[i]));
+                maxChange = std::max(maxChange,
+                                     std::fabs(values[i] - values_[i]));
+            }
+            unchanged = maxChange <= relTol_*maxValue;
+        }
+
+        if (!unchanged) {
+            rows_.assign(rows.begin(), rows.begin()+n);
+            columns_.assign(columns.begin(), columns.begin()+nonZeros);
+            values_.assign(values.begin(), values.begin()+nonZeros);
+            factor_ = theta*dt_;
+
+            const SparseMatrix lhs =
+                boost::numeric::ublas::identity_matrix<Real>(m.size1())
+                - factor_*m;
+            lu_ = boost::shared_ptr<BandedLUDecomposition>(
+                                            new BandedLUDecomposition(lhs));
+            ++factorizations_;
+        }
+
+        a = lu_->solve(a);
+        #else
+        QL_FAIL("banded LU solver requires uBLAS support");
+        #endif
+    }
+
     void ImplicitEulerScheme::setStep(Time dt) {
         dt_=dt;
     }
+
+    Size ImplicitEulerScheme::numberOfIterations() const {
+        return iterations_;
+    }
+
+    Size ImplicitEulerScheme::numberOfFactorizations() const {
+        return factorizations_;
+    }
 }
@@ -29,11 +29,24 @@
 #include <ql/methods/finitedifferences/operatortraits.hpp>
 #include <ql/methods/finitedifferences/operators/fdmlinearopcomposite.hpp>
 #include <ql/methods/finitedifferences/schemes/boundaryconditionschemehelper.hpp>
+#include <vector>
 
 namespace QuantLib {
 
+    class BandedLUDecomposition;
+
     class ImplicitEulerScheme {
       public:
+        /*! linear solver used at each step.  The iterative solvers
+            use the preconditioner of the operator map.  The banded
+            LU solver factorizes the matrix of the operator map,
+            which must provide toMatrixDecomp(), and reuses the
+            factorization as long as neither the step nor the matrix
+            change, i.e., for time-homogeneous operators; it is not
+            available without uBLAS support.
+        */
+        enum SolverType { BiCGstab, GMRES, BandedLU };
+
         // typedefs
         typedef OperatorTraits<FdmLinearOp> traits;
         typedef traits::operator_type operator_type;
@@ -45,18 +58,37 @@ namespace QuantLib {
         ImplicitEulerScheme(
             const boost::shared_ptr<FdmLinearOpComposite>& map,
             const bc_set& bcSet = bc_set(),
-            Real relTol = 1e-8);
+            Real relTol = 1e-8,
+            SolverType solverType = BiCGstab);
 
-        void step(array_type& a, Time t);
+        /*! solves \f$ (1 - \theta \Delta t L) a_{new} = a \f$; a theta
+            other than one gives the implicit part of a theta scheme.
+        */
+        void step(array_type& a, Time t, Real theta = 1.0);
         void setStep(Time dt);
 
+        //! total number of iterations of the linear solver
+        Size numberOfIterations() const;
+        //! number of factorizations computed by the banded LU solver
+        Size numberOfFactorizations() const;
+
       protected:
-        Disposable<Array> apply(const Array& r) const;   
-          
+        Disposable<Array> apply(const Array& r, Real theta) const;
+        void solveBandedLU(array_type& a, Real theta);
+
         Time dt_;
+        Size iterations_, factorizations_;
         const Real relTol_;
         const boost::shared_ptr<FdmLinearOpComposite> map_;
         const BoundaryConditionSchemeHelper bcSet_;
+        const SolverType solverType_;
+
+        // operator matrix (in compressed row storage) and theta*dt
+        // of the cached factorization
+        std::vector<Size> rows_, columns_;
+        std::vector<Real> values_;
+        Real factor_;
+        boost::shared_ptr<BandedLUDecomposition> lu_;
     };
 }
 
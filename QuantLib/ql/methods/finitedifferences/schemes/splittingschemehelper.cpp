@@ -0,0 +1,61 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/methods/finitedifferences/schemes/splittingschemehelper.hpp>
+#include <algorithm>
+
+namespace QuantLib {
+
+    SplittingSchemeHelper::SplittingSchemeHelper(
+                          const boost::shared_ptr<FdmLinearOpComposite>& map)
+    : map_(map), directions_(map->size()) {}
+
+    void SplittingSchemeHelper::applyDirections(const Array& u) {
+        for (Size i=0; i < directions_.size(); ++i)
+            directions_[i] = map_->apply_direction(i, u);
+    }
+
+    void SplittingSchemeHelper::sweep(Array& y, Real s) {
+        for (Size i=0; i < directions_.size(); ++i) {
+            axpy(-s, directions_[i], y, rhs_);
+            y = map_->solve_splitting(i, rhs_, -s);
+        }
+    }
+
+    void SplittingSchemeHelper::axpy(Real s, const Array& z,
+                                     const Array& x, Array& y) {
+        QL_REQUIRE(z.size() == x.size(), "arrays with different sizes");
+        if (y.size() != x.size())
+            Array(x.size()).swap(y);
+
+        const Size size = x.size();
+        const Real* xptr = x.begin();
+        const Real* zptr = z.begin();
+        Real* yptr = y.begin();
+
+        // small grids aren't worth the thread overhead
+        #pragma omp parallel for if (size > 1000)
+        for (Size j=0; j < size; ++j)
+            yptr[j] = xptr[j] + s*zptr[j];
+    }
+
+    void SplittingSchemeHelper::copy(const Array& x, Array& y) {
+        if (y.size() != x.size())
+            Array(x.size()).swap(y);
+        std::copy(x.begin(), x.end(), y.begin());
+    }
+}
@@ -0,0 +1,66 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file splittingschemehelper.hpp
+    \brief common building blocks of the operator-splitting schemes
+*/
+
+#ifndef quantlib_splitting_scheme_helper_hpp
+#define quantlib_splitting_scheme_helper_hpp
+
+#include <ql/methods/finitedifferences/operators/fdmlinearopcomposite.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    //! common building blocks of the operator-splitting schemes
+    /*! The helper keeps the explicit parts \f$ A_i u \f$ of all
+        directions, so that they're computed once and can be used
+        by more than one sweep, and the work arrays of the sweeps.
+        They are allocated on the first step and reused afterwards.
+
+        The element-wise updates of large grids run in parallel; the
+        line solves are distributed among threads by the operators.  The results
+        are the same as those of the plain expressions.
+    */
+    class SplittingSchemeHelper {
+      public:
+        explicit SplittingSchemeHelper(
+                          const boost::shared_ptr<FdmLinearOpComposite>& map);
+
+        //! stores \f$ A_i u \f$ for all directions \f$ i \f$
+        void applyDirections(const Array& u);
+
+        /*! solves \f$ (1 - s A_i) y_i = y_{i-1} - s A_i u \f$ for
+            all directions in turn, using the stored \f$ A_i u \f$;
+            \f$ y \f$ is overwritten by the result.
+        */
+        void sweep(Array& y, Real s);
+
+        //! \f$ y = x + s z \f$, element-wise and in parallel
+        static void axpy(Real s, const Array& z, const Array& x, Array& y);
+        //! copies \f$ x \f$ into \f$ y \f$, reusing its storage
+        static void copy(const Array& x, Array& y);
+
+      private:
+        const boost::shared_ptr<FdmLinearOpComposite> map_;
+        std::vector<Array> directions_;
+        Array rhs_;
+    };
+}
+
+#endif
@@ -64,9 +64,10 @@ namespace QuantLib {
         Array rhs(initialValues_.size());
         std::copy(initialValues_.begin(), initialValues_.end(), rhs.begin());
 
-        FdmBackwardSolver(op_, solverDesc_.bcSet, conditions_, schemeDesc_)
-            .rollback(rhs, solverDesc_.maturity, 0.0,
-                      solverDesc_.timeSteps, solverDesc_.dampingSteps);
+        FdmBackwardSolver backwardSolver(op_, solverDesc_.bcSet,
+                                         conditions_, schemeDesc_);
+        backwardSolver.rollback(rhs, solverDesc_.maturity, 0.0, solverDesc_);
+        numberOfSteps_ = backwardSolver.numberOfSteps();
 
         std::copy(rhs.begin(), rhs.end(), resultValues_.begin());
         interpolation_ = boost::shared_ptr<CubicInterpolation>(new
@@ -79,6 +80,11 @@ namespace QuantLib {
         return interpolation_->operator()(x);
     }
 
+    Size Fdm1DimSolver::numberOfSteps() const {
+        calculate();
+        return numberOfSteps_;
+    }
+
     Real Fdm1DimSolver::thetaAt(Real x) const {
         QL_REQUIRE(conditions_->stoppingTimes().front() > 0.0,
                    "stopping time at zero-> can't calculate theta");
@@ -44,6 +44,9 @@ namespace QuantLib {
         Real interpolateAt(Real x) const;
         Real thetaAt(Real x) const;
 
+        //! number of time steps taken by the rollback
+        Size numberOfSteps() const;
+
         Real derivativeX(Real x) const;
         Real derivativeXX(Real x) const;
 
@@ -61,6 +64,7 @@ namespace QuantLib {
         std::vector<Real> x_, initialValues_;
         mutable Array resultValues_;
         mutable boost::shared_ptr<CubicInterpolation> interpolation_;
+        mutable Size numberOfSteps_;
     };
 }
 
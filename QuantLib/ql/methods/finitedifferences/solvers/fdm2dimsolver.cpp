@@ -73,9 +73,10 @@ namespace QuantLib {
         Array rhs(initialValues_.size());
         std::copy(initialValues_.begin(), initialValues_.end(), rhs.begin());
 
-        FdmBackwardSolver(op_, solverDesc_.bcSet, conditions_, schemeDesc_)
-            .rollback(rhs, solverDesc_.maturity, 0.0,
-                      solverDesc_.timeSteps, solverDesc_.dampingSteps);
+        FdmBackwardSolver backwardSolver(op_, solverDesc_.bcSet,
+                                         conditions_, schemeDesc_);
+        backwardSolver.rollback(rhs, solverDesc_.maturity, 0.0, solverDesc_);
+        numberOfSteps_ = backwardSolver.numberOfSteps();
 
         std::copy(rhs.begin(), rhs.end(), resultValues_.begin());
         interpolation_ = boost::shared_ptr<BicubicSpline> (
@@ -89,6 +90,11 @@ namespace QuantLib {
         return interpolation_->operator()(x, y);
     }
 
+    Size Fdm2DimSolver::numberOfSteps() const {
+        calculate();
+        return numberOfSteps_;
+    }
+
     Real Fdm2DimSolver::thetaAt(Real x, Real y) const {
         QL_REQUIRE(conditions_->stoppingTimes().front() > 0.0,
                    "stopping time at zero-> can't calculate theta");
@@ -44,6 +44,9 @@ namespace QuantLib {
         Real interpolateAt(Real x, Real y) const;
         Real thetaAt(Real x, Real y) const;
 
+        //! number of time steps taken by the rollback
+        Size numberOfSteps() const;
+
         Real derivativeX(Real x, Real y) const;
         Real derivativeY(Real x, Real y) const;
         Real derivativeXX(Real x, Real y) const;
@@ -64,6 +67,7 @@ namespace QuantLib {
         std::vector<Real> x_, y_, initialValues_;
         mutable Matrix resultValues_;
         mutable boost::shared_ptr<BicubicSpline> interpolation_;
+        mutable Size numberOfSteps_;
     };
 }
 
@@ -81,9 +81,10 @@ namespace QuantLib {
         Array rhs(initialValues_.size());
         std::copy(initialValues_.begin(), initialValues_.end(), rhs.begin());
 
-        FdmBackwardSolver(op_, solverDesc_.bcSet, conditions_, schemeDesc_)
-             .rollback(rhs, solverDesc_.maturity, 0.0,
-                       solverDesc_.timeSteps, solverDesc_.dampingSteps);
+        FdmBackwardSolver backwardSolver(op_, solverDesc_.bcSet,
+                                         conditions_, schemeDesc_);
+        backwardSolver.rollback(rhs, solverDesc_.maturity, 0.0, solverDesc_);
+        numberOfSteps_ = backwardSolver.numberOfSteps();
 
         for (Size i=0; i < z_.size(); ++i) {
             std::copy(rhs.begin()+i    *y_.size()*x_.size(),
@@ -108,6 +109,11 @@ namespace QuantLib {
                                            zArray.begin())(z);
     }
 
+    Size Fdm3DimSolver::numberOfSteps() const {
+        calculate();
+        return numberOfSteps_;
+    }
+
     Real Fdm3DimSolver::thetaAt(Real x, Real y, Rate z) const {
         QL_REQUIRE(conditions_->stoppingTimes().front() > 0.0,
                    "stopping time at zero-> can't calculate theta");
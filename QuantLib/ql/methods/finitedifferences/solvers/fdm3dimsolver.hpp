@@ -45,6 +45,9 @@ namespace QuantLib {
         Real interpolateAt(Real x, Real y, Rate z) const;
         Real thetaAt(Real x, Real y, Rate z) const;
 
+        //! number of time steps taken by the rollback
+        Size numberOfSteps() const;
+
       private:
         const FdmSolverDesc solverDesc_;
         const FdmSchemeDesc schemeDesc_;
@@ -56,6 +59,7 @@ namespace QuantLib {
         std::vector<Real> x_, y_, z_, initialValues_;
         mutable std::vector<Matrix> resultValues_;
         mutable std::vector<boost::shared_ptr<BicubicSpline> > interpolation_;
+        mutable Size numberOfSteps_;
     };
 }
 
@@ -23,9 +23,11 @@
 */
 
 #include <ql/methods/finitedifferences/finitedifferencemodel.hpp>
+#include <ql/methods/finitedifferences/solvers/fdmsolverdesc.hpp>
 #include <ql/methods/finitedifferences/solvers/fdmbackwardsolver.hpp>
 #include <ql/methods/finitedifferences/schemes/douglasscheme.hpp>
 #include <ql/methods/finitedifferences/schemes/craigsneydscheme.hpp>
+#include <ql/methods/finitedifferences/schemes/cranknicolsonscheme.hpp>
 #include <ql/methods/finitedifferences/schemes/hundsdorferscheme.hpp>
 #include <ql/methods/finitedifferences/schemes/impliciteulerscheme.hpp>
 #include <ql/methods/finitedifferences/schemes/expliciteulerscheme.hpp>
@@ -68,6 +70,10 @@ namespace QuantLib {
         return FdmSchemeDesc(FdmSchemeDesc::ImplicitEulerType, 0.0, 0.0);
     }
 
+    FdmSchemeDesc FdmSchemeDesc::CrankNicolson() {
+        return FdmSchemeDesc(FdmSchemeDesc::CrankNicolsonType, 0.5, 0.0);
+    }
+
     FdmBackwardSolver::FdmBackwardSolver(
         const boost::shared_ptr<FdmLinearOpComposite>& map,
         const FdmBoundaryConditionSet& bcSet,
@@ -79,9 +85,232 @@ namespace QuantLib {
                                  new FdmStepConditionComposite(
                                      std::list<std::vector<Time> >(),
                                      FdmStepConditionComposite::Conditions()))),
-      schemeDesc_(schemeDesc) {
+      schemeDesc_(schemeDesc), numberOfSteps_(0) {
      }
-        
+
+    Size FdmBackwardSolver::numberOfSteps() const {
+        return numberOfSteps_;
+    }
+
+    Size FdmBackwardSolver::order() const {
+        switch (schemeDesc_.type) {
+          case FdmSchemeDesc::HundsdorferType:
+          case FdmSchemeDesc::ModifiedCraigSneydType:
+            return 2;
+          case FdmSchemeDesc::DouglasType:
+          case FdmSchemeDesc::CraigSneydType:
+          case FdmSchemeDesc::CrankNicolsonType:
+            return (schemeDesc_.theta == 0.5) ? 2 : 1;
+          case FdmSchemeDesc::ImplicitEulerType:
+          case FdmSchemeDesc::ExplicitEulerType:
+            return 1;
+          default:
+            QL_FAIL("Unknown scheme type");
+        }
+    }
+
+    namespace {
+
+        class AdaptiveRollback {
+          public:
+            typedef FdmBackwardSolver::array_type array_type;
+
+            AdaptiveRollback(array_type& a, Time from, Time to,
+                             Time initialStep, Real tolerance,
+                             const FdmStepConditionComposite& condition)
+            : a_(a), from_(from), to_(to), tolerance_(tolerance),
+              minStep_((from-to)*1e-6), condition_(condition),
+              t_(from), dt_(initialStep), next_(0), steps_(0) {
+                const std::vector<Time>& stoppingTimes
+                    = condition_.stoppingTimes();
+                next_ = Integer(stoppingTimes.size())-1;
+                if (!stoppingTimes.empty() && stoppingTimes.back() == from_)
+                    condition_.applyTo(a_, from_);
+            }
+
+            Size steps() const { return steps_; }
+
+            /* rolls back until the end time is reached or the given
+               number of steps is accepted, whichever comes first */
+            template <class Evolver>
+            void rollback(Evolver& evolver, Size order, Size maxSteps) {
+                const std::vector<Time>& stoppingTimes
+                    = condition_.stoppingTimes();
+
+                // the difference between one step and two half steps
+                // is (2^p-1) times the error of the latter
+                const Real factor = 1.0/((1 << order) - 1.0);
+                array_type coarse(a_.size()), fine(a_.size());
+
+                Size accepted = 0;
+                while (t_ > to_ && accepted < maxSteps) {
+                    // next point to be hit exactly
+                    while (next_ >= 0 && stoppingTimes[next_] >= t_)
+                        --next_;
+                    const Time target =
+                        (next_ >= 0 && stoppingTimes[next_] > to_)
+                        ? stoppingTimes[next_] : to_;
+                    const bool hit = (t_ - dt_ <= target + minStep_);
+                    const Time h = hit ? t_ - target : dt_;
+
+                    coarse = a_;
+                    evolver.setStep(h);
+                    evolver.step(coarse, t_);
+
+                    fine = a_;
+                    evolver.setStep(0.5*h);
+                    evolver.step(fine, t_);
+                    evolver.step(fine, t_-0.5*h);
+                    steps_ += 3;
+
+                    Real error = 0.0, scale = 0.0;
+                    for (Size i=0; i < fine.size(); ++i) {
+                        error = std::max(error, std::fabs(fine[i]-coarse[i]));
+                        scale = std::max(scale, std::fabs(fine[i]));
+                    }
+                    error *= factor/std::max(scale, QL_EPSILON);
+
+                    if (error <= tolerance_ || h <= minStep_) {
+                        for (Size i=0; i < a_.size(); ++i)
+                            a_[i] = fine[i] + factor*(fine[i]-coarse[i]);
+                        t_ = hit ? target : t_ - h;
+                        condition_.applyTo(a_, t_);
+                        ++accepted;
+                    }
+
+                    const Real growth = (error > 0.0)
+                        ? 0.9*std::pow(tolerance_/error, 1.0/(order+1.0))
+                        : 2.0;
+                    dt_ = std::max(h*std::min(2.0, std::max(0.2, growth)),
+                                   minStep_);
+                }
+            }
+
+          private:
+            array_type& a_;
+            const Time from_, to_;
+            const Real tolerance_;
+            const Time minStep_;
+            const FdmStepConditionComposite& condition_;
+            Time t_, dt_;
+            Integer next_;
+            Size steps_;
+        };
+
+    }
+
+    void FdmBackwardSolver::rollbackAdaptive(
+                                   FdmBackwardSolver::array_type& rhs,
+                                   Time from, Time to,
+                                   Real tolerance,
+                                   Size initialSteps, Size dampingSteps) {
+        QL_REQUIRE(from > to,
+                   "trying to roll back from " << from << " to " << to);
+        QL_REQUIRE(tolerance > 0.0, "positive tolerance required");
+        QL_REQUIRE(initialSteps > 0, "at least one initial step required");
+
+        AdaptiveRollback adaptive(rhs, from, to, (from - to)/initialSteps,
+                                  tolerance, *condition_);
+
+        if (dampingSteps
+            && schemeDesc_.type != FdmSchemeDesc::ImplicitEulerType) {
+            ImplicitEulerScheme implicitEvolver(map_, bcSet_);
+            adaptive.rollback(implicitEvolver, 1, dampingSteps);
+        }
+
+        const Size untilEnd = Null<Size>();
+        switch (schemeDesc_.type) {
+          case FdmSchemeDesc::HundsdorferType:
+            {
+                HundsdorferScheme hsEvolver(schemeDesc_.theta, schemeDesc_.mu,
+                                            map_, bcSet_);
+                adaptive.rollback(hsEvolver, order(), untilEnd);
+            }
+            break;
+          case FdmSchemeDesc::DouglasType:
+            {
+                DouglasScheme dsEvolver(schemeDesc_.theta, map_, bcSet_);
+                adaptive.rollback(dsEvolver, order(), untilEnd);
+            }
+            break;
+          case FdmSchemeDesc::CraigSneydType:
+            {
+                CraigSneydScheme csEvolver(schemeDesc_.theta, schemeDesc_.mu,
+                                           map_, bcSet_);
+                adaptive.rollback(csEvolver, order(), untilEnd);
+            }
+            break;
+          case FdmSchemeDesc::ModifiedCraigSneydType:
+            {
+                ModifiedCraigSneydScheme csEvolver(schemeDesc_.theta,
+                                                   schemeDesc_.mu,
+                                                   map_, bcSet_);
+                adaptive.rollback(csEvolver, order(), untilEnd);
+            }
+            break;
+          case FdmSchemeDesc::ImplicitEulerType:
+            {
+                ImplicitEulerScheme implicitEvolver(map_, bcSet_);
+                adaptive.rollback(implicitEvolver, order(), untilEnd);
+            }
+            break;
+          case FdmSchemeDesc::ExplicitEulerType:
+            {
+                ExplicitEulerScheme explicitEvolver(map_, bcSet_);
+                adaptive.rollback(explicitEvolver, order(), untilEnd);
+            }
+            break;
+          case FdmSchemeDesc::CrankNicolsonType:
+            {
+                CrankNicolsonScheme cnEvolver(schemeDesc_.theta, map_, bcSet_);
+                adaptive.rollback(cnEvolver, order(), untilEnd);
+            }
+            break;
+          default:
+            QL_FAIL("Unknown scheme type");
+        }
+        numberOfSteps_ = adaptive.steps();
+    }
+
+    void FdmBackwardSolver::rollbackExtrapolated(
+                                   FdmBackwardSolver::array_type& rhs,
+                                   Time from, Time to,
+                                   Size steps, Size dampingSteps) {
+        array_type coarse(rhs);
+        rollback(coarse, from, to, steps, dampingSteps);
+        const Size coarseSteps = numberOfSteps_;
+
+        rollback(rhs, from, to, 2*steps, dampingSteps);
+        numberOfSteps_ += coarseSteps;
+
+        const Real factor = 1.0/((1 << order()) - 1.0);
+        for (Size i=0; i < rhs.size(); ++i)
+            rhs[i] += factor*(rhs[i] - coarse[i]);
+    }
+
+
+    void FdmBackwardSolver::rollback(FdmBackwardSolver::array_type& rhs,
+                                     Time from, Time to,
+                                     const FdmSolverDesc& solverDesc) {
+        switch (solverDesc.timeStepping) {
+          case FdmSolverDesc::FixedSteps:
+            rollback(rhs, from, to,
+                     solverDesc.timeSteps, solverDesc.dampingSteps);
+            break;
+          case FdmSolverDesc::AdaptiveSteps:
+            rollbackAdaptive(rhs, from, to, solverDesc.tolerance,
+                             solverDesc.timeSteps, solverDesc.dampingSteps);
+            break;
+          case FdmSolverDesc::ExtrapolatedSteps:
+            rollbackExtrapolated(rhs, from, to, solverDesc.timeSteps,
+                                 solverDesc.dampingSteps);
+            break;
+          default:
+            QL_FAIL("unknown time stepping");
+        }
+    }
+
+
     void FdmBackwardSolver::rollback(FdmBackwardSolver::array_type& rhs, 
                                      Time from, Time to,
                                      Size steps, Size dampingSteps) {
@@ -89,7 +318,8 @@ namespace QuantLib {
         const Time deltaT = from - to;
         const Size allSteps = steps + dampingSteps;
         const Time dampingTo = from - (deltaT*dampingSteps)/allSteps;
-                    
+        numberOfSteps_ = allSteps;
+
         if (   dampingSteps 
             && schemeDesc_.type != FdmSchemeDesc::ImplicitEulerType) {
             ImplicitEulerScheme implicitEvolver(map_, bcSet_);    
@@ -152,6 +382,14 @@ namespace QuantLib {
                 explicitModel.rollback(rhs, dampingTo, to, steps, *condition_);
             }
             break;
+          case FdmSchemeDesc::CrankNicolsonType:
+            {
+                CrankNicolsonScheme cnEvolver(schemeDesc_.theta, map_, bcSet_);
+                FiniteDifferenceModel<CrankNicolsonScheme>
+                               cnModel(cnEvolver, condition_->stoppingTimes());
+                cnModel.rollback(rhs, dampingTo, to, steps, *condition_);
+            }
+            break;
           default:
             QL_FAIL("Unknown scheme type");
         }
@@ -31,11 +31,13 @@ namespace QuantLib {
 
     class FdmLinearOpComposite;
     class FdmStepConditionComposite;
+    struct FdmSolverDesc;
 
     struct FdmSchemeDesc {
         enum FdmSchemeType { HundsdorferType, DouglasType, 
                              CraigSneydType, ModifiedCraigSneydType, 
-                             ImplicitEulerType, ExplicitEulerType };
+                             ImplicitEulerType, ExplicitEulerType,
+                             CrankNicolsonType };
 
         FdmSchemeDesc(FdmSchemeType type, Real theta, Real mu);
 
@@ -50,6 +52,7 @@ namespace QuantLib {
         static FdmSchemeDesc ModifiedCraigSneyd(); 
         static FdmSchemeDesc Hundsdorfer();
         static FdmSchemeDesc ModifiedHundsdorfer();
+        static FdmSchemeDesc CrankNicolson();
     };
         
     class FdmBackwardSolver {
@@ -66,11 +69,51 @@ namespace QuantLib {
                       Time from, Time to,
                       Size steps, Size dampingSteps);
 
+        /*! Rolls back with time steps chosen so that the local error
+            of each step, estimated by step doubling, stays below the
+            given tolerance relative to the largest absolute value of
+            the solution.  Accepted steps are corrected by the error
+            estimate (local extrapolation).  The damping steps, if
+            any, are implicit Euler steps under the same control; the
+            first step is (from-to)/initialSteps.
+        */
+        void rollbackAdaptive(array_type& a,
+                              Time from, Time to,
+                              Real tolerance,
+                              Size initialSteps, Size dampingSteps = 0);
+
+        /*! Rolls back on two grids of \c steps and \c 2*steps time
+            steps, both starting with the given number of damping
+            steps, and combines the results by Richardson
+            extrapolation to remove the leading error term.
+
+            \warning the step conditions (if any) are applied on both
+                     grids, and snapshots keep the values of the
+                     finer one.
+        */
+        void rollbackExtrapolated(array_type& a,
+                                  Time from, Time to,
+                                  Size steps, Size dampingSteps);
+
+        /*! Rolls back with the time steps, damping steps, time
+            stepping and tolerance given by the solver description.
+        */
+        void rollback(array_type& a,
+                      Time from, Time to,
+                      const FdmSolverDesc& solverDesc);
+
+        //! number of time steps taken by the last rollback
+        Size numberOfSteps() const;
+
       protected:
+        // order of convergence in time of the scheme
+        Size order() const;
+
         const boost::shared_ptr<FdmLinearOpComposite> map_;
         const FdmBoundaryConditionSet bcSet_;
         const boost::shared_ptr<FdmStepConditionComposite> condition_;
         const FdmSchemeDesc schemeDesc_;
+        Size numberOfSteps_;
     };
 }
 
@@ -51,6 +51,9 @@ namespace QuantLib {
         Real gammaAt(Real s) const;
         Real thetaAt(Real s) const;
 
+        //! number of time steps taken by the rollback
+        Size numberOfSteps() const;
+
       protected:
         void performCalculations() const;
 
@@ -88,4 +88,9 @@ namespace QuantLib {
         calculate();
         return solver_->thetaAt(std::log(s), v);
     }
+
+    Size FdmHestonSolver::numberOfSteps() const {
+        calculate();
+        return solver_->numberOfSteps();
+    }
 }
@@ -60,6 +60,9 @@ namespace QuantLib {
         Real meanVarianceDeltaAt(Real s, Real v) const;
         Real meanVarianceGammaAt(Real s, Real v) const;
 
+        //! number of time steps taken by the rollback
+        Size numberOfSteps() const;
+
       protected:
         void performCalculations() const;
         
@@ -36,20 +36,58 @@
 
 #include <numeric>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 namespace QuantLib {
 
+    namespace detail {
+
+        // sets the number of OpenMP threads for its lifetime
+        class FdmThreadsGuard {
+          public:
+#ifdef _OPENMP
+            explicit FdmThreadsGuard(Size threads)
+            : previous_(omp_get_max_threads()) {
+                if (threads > 0)
+                    omp_set_num_threads(int(threads));
+            }
+            ~FdmThreadsGuard() {
+                omp_set_num_threads(previous_);
+            }
+          private:
+            int previous_;
+#else
+            explicit FdmThreadsGuard(Size) {}
+#endif
+        };
+
+    }
+
+    //! multi-dimensional finite-differences solver
+    /*! The rollback runs on the given number of threads when the
+        library is compiled with OpenMP support; the line solves of
+        the splitting schemes and the operator kernels are
+        distributed among them.  The default of zero leaves the
+        number of threads to the OpenMP runtime.
+    */
     template <Size N>
     class FdmNdimSolver : public LazyObject {
       public:
         FdmNdimSolver(const FdmSolverDesc& solverDesc,
                       const FdmSchemeDesc& schemeDesc,
-                      const boost::shared_ptr<FdmLinearOpComposite>& op);
+                      const boost::shared_ptr<FdmLinearOpComposite>& op,
+                      Size threads = 0);
 
         void performCalculations() const;
 
         Real interpolateAt(const std::vector<Real>& x) const;
         Real thetaAt(const std::vector<Real>& x) const;
 
+        //! number of time steps taken by the rollback
+        Size numberOfSteps() const;
+
         // template meta programming
         typedef typename MultiCubicSpline<N>::data_table data_table;
         void static setValue(data_table& f,
@@ -59,6 +97,7 @@ namespace QuantLib {
         const FdmSolverDesc solverDesc_;
         const FdmSchemeDesc schemeDesc_;
         const boost::shared_ptr<FdmLinearOpComposite> op_;
+        const Size threads_;
 
         const boost::shared_ptr<FdmSnapshotCondition> thetaCondition_;
         const boost::shared_ptr<FdmStepConditionComposite> conditions_;
@@ -69,6 +108,7 @@ namespace QuantLib {
 
         mutable boost::shared_ptr<data_table> f_;
         mutable boost::shared_ptr<MultiCubicSpline<N> > interp_;
+        mutable Size numberOfSteps_;
     };
 
 
@@ -76,10 +116,12 @@ namespace QuantLib {
     FdmNdimSolver<N>::FdmNdimSolver(
                         const FdmSolverDesc& solverDesc,
                         const FdmSchemeDesc& schemeDesc,
-                        const boost::shared_ptr<FdmLinearOpComposite>& op)
+                        const boost::shared_ptr<FdmLinearOpComposite>& op,
+                        Size threads)
     : solverDesc_(solverDesc),
       schemeDesc_(schemeDesc),
       op_(op),
+      threads_(threads),
       thetaCondition_(new FdmSnapshotCondition(
         0.99*std::min(1.0/365.0,
                 solverDesc.condition->stoppingTimes().empty()
@@ -125,9 +167,14 @@ namespace QuantLib {
         Array rhs(initialValues_.size());
         std::copy(initialValues_.begin(), initialValues_.end(), rhs.begin());
 
-        FdmBackwardSolver(op_, solverDesc_.bcSet, conditions_, schemeDesc_)
-                 .rollback(rhs, solverDesc_.maturity, 0.0,
-                           solverDesc_.timeSteps, solverDesc_.dampingSteps);
+        {
+            const detail::FdmThreadsGuard guard(threads_);
+            FdmBackwardSolver backwardSolver(op_, solverDesc_.bcSet,
+                                             conditions_, schemeDesc_);
+            backwardSolver.rollback(rhs, solverDesc_.maturity, 0.0,
+                                    solverDesc_);
+            numberOfSteps_ = backwardSolver.numberOfSteps();
+        }
 
         const boost::shared_ptr<FdmLinearOpLayout> layout
                                                = solverDesc_.mesher->layout();
@@ -143,6 +190,13 @@ namespace QuantLib {
     }
 
 
+    template <Size N> inline
+    Size FdmNdimSolver<N>::numberOfSteps() const {
+        calculate();
+        return numberOfSteps_;
+    }
+
+
     template <Size N> inline
     Real FdmNdimSolver<N>::thetaAt(const std::vector<Real>& x) const {
         QL_REQUIRE(conditions_->stoppingTimes().front() > 0.0,
@@ -32,7 +32,18 @@ namespace QuantLib {
     class FdmStepConditionComposite;
     class FdmInnerValueCalculator;
 
+    /*! The time stepping defaults to the given number of fixed time
+        steps, so that descriptions listing only the first seven
+        members keep their meaning.  With adaptive time stepping, the
+        number of time steps gives the size of the first step and the
+        tolerance bounds the relative local error of each step; with
+        extrapolated time stepping, the results on timeSteps and
+        2*timeSteps steps are combined by Richardson extrapolation.
+        See FdmBackwardSolver for details.
+    */
     struct FdmSolverDesc {
+        enum TimeStepping { FixedSteps, AdaptiveSteps, ExtrapolatedSteps };
+
         const boost::shared_ptr<FdmMesher> mesher;
         const FdmBoundaryConditionSet bcSet;
         const boost::shared_ptr<FdmStepConditionComposite> condition;
@@ -40,6 +51,8 @@ namespace QuantLib {
         const Time maturity;
         const Size timeSteps;
         const Size dampingSteps;
+        const TimeStepping timeStepping;
+        const Real tolerance;
     };
 }
 
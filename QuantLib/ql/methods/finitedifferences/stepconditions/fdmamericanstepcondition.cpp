@@ -32,15 +32,11 @@ namespace QuantLib {
     }
 
     void FdmAmericanStepCondition::applyTo(Array& a, Time t) const {
-        boost::shared_ptr<FdmLinearOpLayout> layout = mesher_->layout();
-        const FdmLinearOpIterator endIter = layout->end();
-
-        for (FdmLinearOpIterator iter = layout->begin(); iter != endIter;
-            ++iter) {
-            const Real innerValue = calculator_->innerValue(iter, t);
-            if (innerValue > a[iter.index()]) {
-                a[iter.index()] = innerValue;
-            }
-        }
+        const Array innerValues
+            = calculator_->innerValues(mesher_->layout(), t);
+
+        const Size size = a.size();
+        for (Size i=0; i < size; ++i)
+            a[i] = std::max(a[i], innerValues[i]);
     }
 }
@@ -48,22 +48,12 @@ namespace QuantLib {
         if (std::find(exerciseTimes_.begin(), exerciseTimes_.end(), t) 
               != exerciseTimes_.end()) {
             
-            boost::shared_ptr<FdmLinearOpLayout> layout = mesher_->layout();
-            const FdmLinearOpIterator endIter = layout->end();
+            const Array innerValues
+                = calculator_->innerValues(mesher_->layout(), t);
 
-            const Size dims = layout->dim().size();
-            Array locations(dims);
-
-            for (FdmLinearOpIterator iter = layout->begin(); iter != endIter;
-                ++iter) {
-                for (Size i=0; i < dims; ++i)
-                    locations[i] = mesher_->location(iter, i);
-
-                const Real innerValue = calculator_->innerValue(iter, t);
-                if (innerValue > a[iter.index()]) {
-                    a[iter.index()] = innerValue;
-                }
-            }            
+            const Size size = a.size();
+            for (Size i=0; i < size; ++i)
+                a[i] = std::max(a[i], innerValues[i]);
         }
     }
 }
@@ -35,6 +35,17 @@
 
 namespace QuantLib {
 
+    Disposable<Array> FdmInnerValueCalculator::innerValues(
+                const boost::shared_ptr<FdmLinearOpLayout>& layout, Time t) {
+        Array retVal(layout->size());
+        const FdmLinearOpIterator endIter = layout->end();
+        for (FdmLinearOpIterator iter = layout->begin(); iter != endIter;
+             ++iter) {
+            retVal[iter.index()] = innerValue(iter, t);
+        }
+        return retVal;
+    }
+
     FdmLogInnerValue::FdmLogInnerValue(
         const boost::shared_ptr<Payoff>& payoff,
         const boost::shared_ptr<FdmMesher>& mesher,
@@ -45,8 +56,35 @@ namespace QuantLib {
     }
 
     Real FdmLogInnerValue::innerValue(const FdmLinearOpIterator& iter, Time) {
-        const Real s = std::exp(mesher_->location(iter, direction_));
-        return payoff_->operator()(s);
+        if (innerValues_.empty()) {
+            // calculate caching values
+            innerValues_.resize(mesher_->layout()->dim()[direction_]);
+            std::deque<bool> initialized(innerValues_.size(), false);
+
+            const boost::shared_ptr<FdmLinearOpLayout> layout=mesher_->layout();
+            const FdmLinearOpIterator endIter = layout->end();
+            for (FdmLinearOpIterator i = layout->begin(); i != endIter; ++i) {
+                const Size xn = i.coordinates()[direction_];
+                if (!initialized[xn]) {
+                    initialized[xn] = true;
+                    innerValues_[xn] = payoff_->operator()(
+                                std::exp(mesher_->location(i, direction_)));
+                }
+            }
+        }
+
+        return innerValues_[iter.coordinates()[direction_]];
+    }
+
+    Disposable<Array> FdmLogInnerValue::innerValues(
+                const boost::shared_ptr<FdmLinearOpLayout>& layout, Time t) {
+        if (gridInnerValues_.empty())
+            gridInnerValues_ = FdmInnerValueCalculator::innerValues(layout, t);
+
+        QL_REQUIRE(gridInnerValues_.size() == layout->size(),
+                   "inconsistent layout given");
+        Array retVal(gridInnerValues_);
+        return retVal;
     }
 
     Real FdmLogInnerValue::avgInnerValue(
@@ -123,4 +161,23 @@ namespace QuantLib {
                                     const FdmLinearOpIterator& iter, Time t) {
         return innerValue(iter, t);
     }
+
+    FdmBatchInnerValue::FdmBatchInnerValue(
+        const std::vector<boost::shared_ptr<FdmInnerValueCalculator> >&
+                                                                calculators,
+        Size direction)
+    : calculators_(calculators),
+      direction_(direction) { }
+
+    Real FdmBatchInnerValue::innerValue(
+                                    const FdmLinearOpIterator& iter, Time t) {
+        return calculators_[iter.coordinates()[direction_]]
+            ->innerValue(iter, t);
+    }
+
+    Real FdmBatchInnerValue::avgInnerValue(
+                                    const FdmLinearOpIterator& iter, Time t) {
+        return calculators_[iter.coordinates()[direction_]]
+            ->avgInnerValue(iter, t);
+    }
 }
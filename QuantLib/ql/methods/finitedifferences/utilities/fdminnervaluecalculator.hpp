@@ -26,7 +26,7 @@
 #ifndef quantlib_fdm_inner_value_calculator_hpp
 #define quantlib_fdm_inner_value_calculator_hpp
 
-#include <ql/types.hpp>
+#include <ql/math/array.hpp>
 #include <boost/shared_ptr.hpp>
 #include <vector>
 
@@ -36,6 +36,7 @@ namespace QuantLib {
     class BasketPayoff;
     class FdmMesher;
     class FdmLinearOpIterator;
+    class FdmLinearOpLayout;
 
     class FdmInnerValueCalculator {
       public:
@@ -43,6 +44,13 @@ namespace QuantLib {
 
         virtual Real innerValue(const FdmLinearOpIterator& iter, Time t) = 0;
         virtual Real avgInnerValue(const FdmLinearOpIterator& iter, Time t) = 0;
+
+        /*! inner values on the whole grid; the default implementation
+            calls innerValue() for each point, derived classes can
+            override it with a faster one.
+        */
+        virtual Disposable<Array> innerValues(
+                    const boost::shared_ptr<FdmLinearOpLayout>& layout, Time t);
     };
 
 
@@ -54,6 +62,8 @@ namespace QuantLib {
 
         Real innerValue(const FdmLinearOpIterator& iter, Time);
         Real avgInnerValue(const FdmLinearOpIterator& iter, Time);
+        Disposable<Array> innerValues(
+                    const boost::shared_ptr<FdmLinearOpLayout>& layout, Time);
 
       private:
 
@@ -62,7 +72,9 @@ namespace QuantLib {
         const boost::shared_ptr<Payoff> payoff_;
         const boost::shared_ptr<FdmMesher> mesher_;
         const Size direction_;
-        std::vector<Real> avgInnerValues_;
+        // the payoff only depends on the coordinate along direction_
+        std::vector<Real> innerValues_, avgInnerValues_;
+        Array gridInnerValues_;
     };
 
     class FdmLogBasketInnerValue : public FdmInnerValueCalculator {
@@ -78,6 +90,26 @@ namespace QuantLib {
         const boost::shared_ptr<FdmMesher> mesher_;
     };
 
+    /*! Inner values of a batch of options sharing the same grid; each
+        option corresponds to one coordinate along the given direction
+        and its inner value is returned by the corresponding calculator.
+    */
+    class FdmBatchInnerValue : public FdmInnerValueCalculator {
+      public:
+        FdmBatchInnerValue(
+            const std::vector<boost::shared_ptr<FdmInnerValueCalculator> >&
+                                                                calculators,
+            Size direction);
+
+        Real innerValue(const FdmLinearOpIterator& iter, Time);
+        Real avgInnerValue(const FdmLinearOpIterator& iter, Time);
+
+      private:
+        const std::vector<boost::shared_ptr<FdmInnerValueCalculator> >
+                                                                calculators_;
+        const Size direction_;
+    };
+
     class FdmZeroInnerValue : public FdmInnerValueCalculator {
       public:
         Real innerValue(const FdmLinearOpIterator&, Time)    { return 0.0; }
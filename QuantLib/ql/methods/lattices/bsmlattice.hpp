@@ -84,8 +84,14 @@ namespace QuantLib {
     template <class T>
     void BlackScholesLattice<T>::stepback(Size i, const Array& values,
                                           Array& newValues) const {
-        for (Size j=0; j<size(i); j++)
-            newValues[j] = (pd_*values[j] + pu_*values[j+1])*discount_;
+        const Size size = this->size(i);
+        const Real* v = values.begin();
+        Real* newV = newValues.begin();
+
+        // only wide steps are worth the overhead of the threads
+        #pragma omp parallel for if (size > 1000)
+        for (Size j=0; j<size; j++)
+            newV[j] = (pd_*v[j] + pu_*v[j+1])*discount_;
     }
 
 }
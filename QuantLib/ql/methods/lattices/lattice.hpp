@@ -51,6 +51,13 @@ namespace QuantLib {
                         Array& newValues) const;
         \endcode
 
+        The default stepback() doesn't call the above methods at each
+        rollback; their results are stored the first time a step is
+        rolled back, in contiguous arrays that are used afterwards.
+        Therefore, derived classes must not change the branching or
+        the discount factors of their steps once the lattice is
+        built.
+
         \ingroup lattices
     */
     template <class Impl>
@@ -59,7 +66,9 @@ namespace QuantLib {
       public:
         TreeLattice(const TimeGrid& timeGrid,
                     Size n)
-        : Lattice(timeGrid), n_(n) {
+        : Lattice(timeGrid),
+          descendants_(timeGrid.size()), probabilities_(timeGrid.size()),
+          discounts_(timeGrid.size()), n_(n) {
             QL_REQUIRE(n>0, "there is no zeronomial lattice!");
             statePrices_ = std::vector<Array>(1, Array(1, 1.0));
             statePricesLimit_ = 0;
@@ -82,10 +91,22 @@ namespace QuantLib {
 
       protected:
         void computeStatePrices(Size until) const;
+        //! discount factors of the nodes at the i-th step
+        const Array& discounts(Size i) const;
+        /*! descendants and probabilities of the nodes at the i-th
+            step; the entries for the l-th branch of the j-th node
+            are stored at the index l*size(i)+j.
+        */
+        void computeBranching(Size i) const;
 
         // Arrow-Debrew state prices
         mutable std::vector<Array> statePrices_;
 
+        // branching data and discount factors, stored on demand
+        mutable std::vector<std::vector<Size> > descendants_;
+        mutable std::vector<Array> probabilities_;
+        mutable std::vector<Array> discounts_;
+
       private:
         Size n_;
         mutable Size statePricesLimit_;
@@ -110,6 +131,36 @@ namespace QuantLib {
         statePricesLimit_ = until;
     }
 
+    template <class Impl>
+    const Array& TreeLattice<Impl>::discounts(Size i) const {
+        if (discounts_[i].empty()) {
+            const Size size = this->impl().size(i);
+            Array discounts(size);
+            for (Size j=0; j<size; j++)
+                discounts[j] = this->impl().discount(i,j);
+            discounts_[i].swap(discounts);
+        }
+        return discounts_[i];
+    }
+
+    template <class Impl>
+    void TreeLattice<Impl>::computeBranching(Size i) const {
+        if (!probabilities_[i].empty())
+            return;
+
+        const Size size = this->impl().size(i);
+        std::vector<Size> descendants(n_*size);
+        Array probabilities(n_*size);
+        for (Size l=0; l<n_; l++) {
+            for (Size j=0; j<size; j++) {
+                descendants[l*size+j] = this->impl().descendant(i,j,l);
+                probabilities[l*size+j] = this->impl().probability(i,j,l);
+            }
+        }
+        descendants_[i].swap(descendants);
+        probabilities_[i].swap(probabilities);
+    }
+
     template <class Impl>
     const Array& TreeLattice<Impl>::statePrices(Size i) const {
         if (i>statePricesLimit_)
@@ -156,7 +207,7 @@ namespace QuantLib {
             Array newValues(this->impl().size(i));
             this->impl().stepback(i, asset.values(), newValues);
             asset.time() = t_[i];
-            asset.values() = newValues;
+            asset.values().swap(newValues);
             // skip the very last adjustment
             if (i != iTo)
                 asset.adjustValues();
@@ -166,15 +217,25 @@ namespace QuantLib {
     template <class Impl>
     void TreeLattice<Impl>::stepback(Size i, const Array& values,
                                      Array& newValues) const {
-        #pragma omp parallel for
-        for (Size j=0; j<this->impl().size(i); j++) {
+        computeBranching(i);
+
+        const Size size = this->impl().size(i);
+        const Size* descendants = &descendants_[i][0];
+        const Real* probabilities = probabilities_[i].begin();
+        const Real* discounts = this->discounts(i).begin();
+        const Real* v = values.begin();
+        Real* newV = newValues.begin();
+
+        // only wide steps are worth the overhead of the threads
+        #pragma omp parallel for if (size > 1000)
+        for (Size j=0; j<size; j++) {
             Real value = 0.0;
             for (Size l=0; l<n_; l++) {
-                value += this->impl().probability(i,j,l) *
-                         values[this->impl().descendant(i,j,l)];
+                value += probabilities[l*size+j] *
+                         v[descendants[l*size+j]];
             }
-            value *= this->impl().discount(i,j);
-            newValues[j] = value;
+            value *= discounts[j];
+            newV[j] = value;
         }
     }
 
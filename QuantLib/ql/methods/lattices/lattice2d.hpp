@@ -35,6 +35,11 @@ namespace QuantLib {
     /*! This lattice is based on two trinomial trees and primarily used
         for the G2 short-rate model.
 
+        Its stepback() uses the branching of the two trees, stored
+        for each step the first time it's rolled back, rather than
+        that of the full lattice; the storage needed is thus
+        proportional to the size of the trees.
+
         \ingroup lattices
     */
     template <class Impl, class T = TrinomialTree>
@@ -47,13 +52,20 @@ namespace QuantLib {
         Size size(Size i) const;
         Size descendant(Size i, Size index, Size branch) const;
         Real probability(Size i, Size index, Size branch) const;
+        void stepback(Size i, const Array& values, Array& newValues) const;
       protected:
         boost::shared_ptr<T> tree1_, tree2_;
         // smelly
         Disposable<Array> grid(Time) const { QL_FAIL("not implemented"); }
       private:
+        void computeTreeBranching(Size i) const;
         Matrix m_;
         Real rho_;
+        // correlation term of the probability of each branch
+        std::vector<Real> correlationTerms_;
+        // branching data of the two trees, stored on demand
+        mutable std::vector<std::vector<Size> > descendants1_, descendants2_;
+        mutable std::vector<Array> probabilities1_, probabilities2_;
     };
 
 
@@ -73,7 +85,12 @@ namespace QuantLib {
                                          Real correlation)
     : TreeLattice<Impl>(tree1->timeGrid(), T::branches*T::branches),
       tree1_(tree1), tree2_(tree2), m_(T::branches,T::branches),
-      rho_(std::fabs(correlation)) {
+      rho_(std::fabs(correlation)),
+      correlationTerms_(T::branches*T::branches),
+      descendants1_(tree1->timeGrid().size()),
+      descendants2_(tree1->timeGrid().size()),
+      probabilities1_(tree1->timeGrid().size()),
+      probabilities2_(tree1->timeGrid().size()) {
 
         // what happens here?
         if (correlation < 0.0 && T::branches == 3) {
@@ -97,6 +114,12 @@ namespace QuantLib {
             m_[2][1] = -4.0;
             m_[2][2] =  5.0;
         }
+
+        for (Size branch=0; branch<correlationTerms_.size(); branch++) {
+            Size branch1 = branch % T::branches;
+            Size branch2 = branch / T::branches;
+            correlationTerms_[branch] = rho_*(m_[branch1][branch2])/36.0;
+        }
     }
 
 
@@ -131,6 +154,66 @@ namespace QuantLib {
         return prob1*prob2 + rho_*(m_[branch1][branch2])/36.0;
     }
 
+    template <class Impl, class T>
+    void TreeLattice2D<Impl,T>::computeTreeBranching(Size i) const {
+        if (!probabilities1_[i].empty())
+            return;
+
+        const Size size1 = tree1_->size(i), size2 = tree2_->size(i);
+        std::vector<Size> descendants1(T::branches*size1),
+                          descendants2(T::branches*size2);
+        Array probabilities1(T::branches*size1),
+              probabilities2(T::branches*size2);
+        for (Size l=0; l<Size(T::branches); l++) {
+            for (Size j=0; j<size1; j++) {
+                descendants1[l*size1+j] = tree1_->descendant(i, j, l);
+                probabilities1[l*size1+j] = tree1_->probability(i, j, l);
+            }
+            for (Size j=0; j<size2; j++) {
+                descendants2[l*size2+j] = tree2_->descendant(i, j, l);
+                probabilities2[l*size2+j] = tree2_->probability(i, j, l);
+            }
+        }
+        descendants1_[i].swap(descendants1);
+        descendants2_[i].swap(descendants2);
+        probabilities1_[i].swap(probabilities1);
+        probabilities2_[i].swap(probabilities2);
+    }
+
+    template <class Impl, class T>
+    void TreeLattice2D<Impl,T>::stepback(Size i, const Array& values,
+                                         Array& newValues) const {
+        computeTreeBranching(i);
+
+        const Size size1 = tree1_->size(i), size2 = tree2_->size(i);
+        const Size modulo = tree1_->size(i+1);
+        const Size size = size1*size2;
+        const Size branches = T::branches;
+        const Size* d1 = &descendants1_[i][0];
+        const Size* d2 = &descendants2_[i][0];
+        const Real* p1 = probabilities1_[i].begin();
+        const Real* p2 = probabilities2_[i].begin();
+        const Real* c = &correlationTerms_[0];
+        const Real* discounts = this->discounts(i).begin();
+        const Real* v = values.begin();
+        Real* newV = newValues.begin();
+
+        // only wide steps are worth the overhead of the threads
+        #pragma omp parallel for if (size > 1000)
+        for (Size j=0; j<size; j++) {
+            const Size j1 = j % size1, j2 = j / size1;
+            Real value = 0.0;
+            for (Size l=0; l<branches*branches; l++) {
+                const Size k1 = (l % branches)*size1 + j1;
+                const Size k2 = (l / branches)*size2 + j2;
+                value += (p1[k1]*p2[k2] + c[l]) *
+                         v[d1[k1] + d2[k2]*modulo];
+            }
+            value *= discounts[j];
+            newV[j] = value;
+        }
+    }
+
 }
 
 
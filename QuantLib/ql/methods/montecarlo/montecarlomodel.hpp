@@ -27,7 +27,10 @@
 
 #include <ql/methods/montecarlo/mctraits.hpp>
 #include <ql/math/statistics/statistics.hpp>
+#include <ql/math/randomnumbers/seedgenerator.hpp>
 #include <boost/shared_ptr.hpp>
+#include <vector>
+#include <string>
 
 namespace QuantLib {
 
@@ -45,6 +48,20 @@ namespace QuantLib {
         provide the additional control option, namely the option path
         pricer and the option value.
 
+        When more than one thread is requested, samples are drawn
+        from independent streams of samplesPerStream paths each; the
+        streams are obtained from the RNG traits (which must provide
+        a stream-aware make_sequence_generator method) and are
+        simulated in parallel if OpenMP is enabled.  The results are
+        added to the accumulator in the order of the sample index;
+        therefore, they do not depend on the number of threads
+        (although they differ from those of a single-threaded run.)
+
+        \warning In multi-threaded mode, the path generator, the path
+                 pricer and the underlying process are used
+                 concurrently and must be thread-safe once the first
+                 sample has been drawn.
+
         \ingroup mcarlo
     */
     template <template <class> class MC, class RNG, class S = Statistics>
@@ -67,20 +84,33 @@ namespace QuantLib {
                         = boost::shared_ptr<path_pricer_type>(),
                   result_type cvOptionValue = result_type(),
                   const boost::shared_ptr<path_generator_type>& cvPathGenerator
-                        = boost::shared_ptr<path_generator_type>())
+                        = boost::shared_ptr<path_generator_type>(),
+                  Size threads = 1,
+                  BigNatural seed = 0)
         : pathGenerator_(pathGenerator), pathPricer_(pathPricer),
           sampleAccumulator_(sampleAccumulator),
           isAntitheticVariate_(antitheticVariate),
           cvPathPricer_(cvPathPricer), cvOptionValue_(cvOptionValue),
-          cvPathGenerator_(cvPathGenerator) {
+          cvPathGenerator_(cvPathGenerator), threads_(threads),
+          seed_(seed), drawnSamples_(0) {
             if (!cvPathPricer_)
                 isControlVariate_ = false;
             else
                 isControlVariate_ = true;
+            QL_REQUIRE(threads_ > 0, "at least one thread required");
+            // all streams must be derived from the same seed
+            if (threads_ > 1 && seed_ == 0)
+                seed_ = SeedGenerator::instance().get();
         }
         void addSamples(Size samples);
         const stats_type& sampleAccumulator(void) const;
+        //! number of paths drawn from each stream in multi-threaded mode
+        static const Size samplesPerStream = 1024;
       private:
+        result_type nextSample(const path_generator_type& pathGenerator,
+                               const path_generator_type* cvPathGenerator,
+                               Real& weight) const;
+        void addSamplesFromStreams(Size samples);
         boost::shared_ptr<path_generator_type> pathGenerator_;
         boost::shared_ptr<path_pricer_type> pathPricer_;
         stats_type sampleAccumulator_;
@@ -89,42 +119,156 @@ namespace QuantLib {
         result_type cvOptionValue_;
         bool isControlVariate_;
         boost::shared_ptr<path_generator_type> cvPathGenerator_;
+        Size threads_;
+        BigNatural seed_;
+        Size drawnSamples_;
+        std::vector<boost::shared_ptr<path_generator_type> > streams_;
+        std::vector<boost::shared_ptr<path_generator_type> > cvStreams_;
     };
 
+    template <template <class> class MC, class RNG, class S>
+    const Size MonteCarloModel<MC,RNG,S>::samplesPerStream;
+
     // inline definitions
     template <template <class> class MC, class RNG, class S>
     inline void MonteCarloModel<MC,RNG,S>::addSamples(Size samples) {
+        if (threads_ > 1) {
+            addSamplesFromStreams(samples);
+            return;
+        }
+
         for(Size j = 1; j <= samples; j++) {
+            Real weight;
+            result_type price =
+                nextSample(*pathGenerator_, cvPathGenerator_.get(), weight);
+            sampleAccumulator_.add(price, weight);
+        }
+    }
 
-            sample_type path = pathGenerator_->next();
-            result_type price = (*pathPricer_)(path.value);
+    template <template <class> class MC, class RNG, class S>
+    inline typename MonteCarloModel<MC,RNG,S>::result_type
+    MonteCarloModel<MC,RNG,S>::nextSample(
+                               const path_generator_type& pathGenerator,
+                               const path_generator_type* cvPathGenerator,
+                               Real& weight) const {
+
+        sample_type path = pathGenerator.next();
+        result_type price = (*pathPricer_)(path.value);
+
+        if (isControlVariate_) {
+            if (!cvPathGenerator) {
+                price += cvOptionValue_-(*cvPathPricer_)(path.value);
+            }
+            else {
+                sample_type cvPath = cvPathGenerator->next();
+                price += cvOptionValue_-(*cvPathPricer_)(cvPath.value);
+            }
+        }
 
+        if (isAntitheticVariate_) {
+            path = pathGenerator.antithetic();
+            result_type price2 = (*pathPricer_)(path.value);
             if (isControlVariate_) {
-                if (!cvPathGenerator_) {
-                    price += cvOptionValue_-(*cvPathPricer_)(path.value);
-                }
+                if (!cvPathGenerator)
+                    price2 += cvOptionValue_-(*cvPathPricer_)(path.value);
                 else {
-                    sample_type cvPath = cvPathGenerator_->next();
-                    price += cvOptionValue_-(*cvPathPricer_)(cvPath.value);
+                    sample_type cvPath = cvPathGenerator->antithetic();
+                    price2 += cvOptionValue_-(*cvPathPricer_)(cvPath.value);
+                }
+            }
+
+            weight = path.weight;
+            return (price+price2)/2.0;
+        } else {
+            weight = path.weight;
+            return price;
+        }
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline void MonteCarloModel<MC,RNG,S>::addSamplesFromStreams(
+                                                               Size samples) {
+        if (drawnSamples_ == 0 && samples > 0) {
+            // a first, discarded sample triggers the lazy
+            // initializations (if any) in the generator, the pricer
+            // and the process before they're used concurrently
+            Real weight;
+            nextSample(*pathGenerator_, cvPathGenerator_.get(), weight);
+        }
+
+        while (samples > 0) {
+            // each round spans at most one stream per thread
+            Size first = drawnSamples_;
+            Size last = first + std::min(samples, threads_*samplesPerStream);
+
+            std::vector<Size> bounds(1, first);
+            while (bounds.back() < last) {
+                Size next = (bounds.back()/samplesPerStream+1)
+                          * samplesPerStream;
+                bounds.push_back(std::min(next, last));
+            }
+            Size chunks = bounds.size()-1;
+
+            // stream generators are created serially...
+            for (Size i=0; i<chunks; ++i) {
+                Size stream = bounds[i]/samplesPerStream;
+                if (stream >= streams_.size()) {
+                    streams_.resize(stream+1);
+                    cvStreams_.resize(stream+1);
+                }
+                if (!streams_[stream]) {
+                    streams_[stream] =
+                        boost::shared_ptr<path_generator_type>(
+                            new path_generator_type(
+                                *pathGenerator_,
+                                RNG::make_sequence_generator(
+                                    pathGenerator_->size(), seed_,
+                                    stream, samplesPerStream)));
+                    if (cvPathGenerator_)
+                        cvStreams_[stream] =
+                            boost::shared_ptr<path_generator_type>(
+                                new path_generator_type(
+                                    *cvPathGenerator_,
+                                    RNG::make_sequence_generator(
+                                        cvPathGenerator_->size(), seed_,
+                                        stream, samplesPerStream)));
                 }
             }
 
-            if (isAntitheticVariate_) {
-                path = pathGenerator_->antithetic();
-                result_type price2 = (*pathPricer_)(path.value);
-                if (isControlVariate_) {
-                    if (!cvPathGenerator_)
-                        price2 += cvOptionValue_-(*cvPathPricer_)(path.value);
-                    else {
-                        sample_type cvPath = cvPathGenerator_->antithetic();
-                        price2 += cvOptionValue_-(*cvPathPricer_)(cvPath.value);
-                    }
+            // ...and run in parallel
+            std::vector<result_type> prices(last-first);
+            std::vector<Real> weights(last-first);
+            std::vector<std::string> errors(chunks);
+            #pragma omp parallel for num_threads(threads_)
+            for (Size i=0; i<chunks; ++i) {
+                Size stream = bounds[i]/samplesPerStream;
+                try {
+                    for (Size j=bounds[i]; j<bounds[i+1]; ++j)
+                        prices[j-first] =
+                            nextSample(*streams_[stream],
+                                       cvStreams_[stream].get(),
+                                       weights[j-first]);
+                } catch (std::exception& e) {
+                    errors[i] = e.what();
                 }
+            }
+            for (Size i=0; i<chunks; ++i)
+                QL_REQUIRE(errors[i].empty(), errors[i]);
 
-                sampleAccumulator_.add((price+price2)/2.0, path.weight);
-            } else {
-                sampleAccumulator_.add(price, path.weight);
+            // exhausted streams are no longer needed
+            for (Size i=0; i<chunks; ++i) {
+                if (bounds[i+1] % samplesPerStream == 0) {
+                    Size stream = bounds[i]/samplesPerStream;
+                    streams_[stream].reset();
+                    cvStreams_[stream].reset();
+                }
             }
+
+            for (Size j=0; j<last-first; ++j)
+                sampleAccumulator_.add(prices[j], weights[j]);
+
+            drawnSamples_ = last;
+            samples -= last-first;
         }
     }
 
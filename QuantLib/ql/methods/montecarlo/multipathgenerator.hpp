@@ -27,7 +27,9 @@
 #ifndef quantlib_multi_path_generator_hpp
 #define quantlib_multi_path_generator_hpp
 
+#include <ql/methods/montecarlo/brownianbridge.hpp>
 #include <ql/methods/montecarlo/multipath.hpp>
+#include <ql/methods/montecarlo/pathblock.hpp>
 #include <ql/methods/montecarlo/sample.hpp>
 #include <ql/stochasticprocess.hpp>
 
@@ -42,9 +44,21 @@ namespace QuantLib {
         };
         \endcode
 
+        When the Brownian bridge is used, the sequence dimensions are
+        allocated in time-major order across factors: the first
+        factors() dimensions drive the first point of the bridge
+        (i.e., the final time) for each factor, the next factors()
+        dimensions drive the second point, and so on.  This way, the
+        lowest and best-distributed dimensions of a low-discrepancy
+        sequence are used for the coarse features of all the factors.
+
         \ingroup mcarlo
 
-        \test the generated paths are checked against cached results
+        \test the generated paths are checked against cached results;
+              paths generated in blocks are checked against the
+              corresponding paths generated one at a time; the final
+              values of paths generated with the Brownian bridge are
+              checked against the first dimensions of the sequence.
     */
     template <class GSG>
     class MultiPathGenerator {
@@ -54,14 +68,36 @@ namespace QuantLib {
                            const TimeGrid&,
                            GSG generator,
                            bool brownianBridge = false);
+        /*! builds a generator for the same process and time grid
+            as the given one, drawing its variates from a different
+            sequence generator.
+        */
+        MultiPathGenerator(const MultiPathGenerator& other,
+                           GSG generator);
         const sample_type& next() const;
         const sample_type& antithetic() const;
+        Size size() const { return generator_.dimension(); }
+        /*! fills the given block with block.paths() multipaths,
+            drawing the same sequences that as many calls to next()
+            would. The process is evolved across the whole block at
+            each time step by means of StochasticProcess::evolveBlock.
+        */
+        void next(PathBlock& block) const;
+        /*! fills the given block with the multipaths antithetic to
+            the ones generated by the last call to next(PathBlock&).
+        */
+        void antithetic(PathBlock& block) const;
       private:
         const sample_type& next(bool antithetic) const;
+        void fillBlock(PathBlock& block, bool antithetic) const;
+        void bridge(std::vector<Real>& variates) const;
         bool brownianBridge_;
         boost::shared_ptr<StochasticProcess> process_;
         GSG generator_;
         mutable sample_type next_;
+        BrownianBridge bb_;
+        mutable std::vector<Real> variates_, bridgeIn_, bridgeOut_;
+        mutable std::vector<Real> dw_, antitheticDw_;
     };
 
 
@@ -74,7 +110,9 @@ namespace QuantLib {
                    GSG generator,
                    bool brownianBridge)
     : brownianBridge_(brownianBridge), process_(process),
-      generator_(generator), next_(MultiPath(process->size(), times), 1.0) {
+      generator_(generator), next_(MultiPath(process->size(), times), 1.0),
+      bb_(times), variates_(generator_.dimension()),
+      bridgeIn_(times.size()-1), bridgeOut_(times.size()-1) {
 
         QL_REQUIRE(generator_.dimension() ==
                    process->factors()*(times.size()-1),
@@ -87,6 +125,22 @@ namespace QuantLib {
                    "no times given");
     }
 
+    template <class GSG>
+    MultiPathGenerator<GSG>::MultiPathGenerator(
+                                         const MultiPathGenerator& other,
+                                         GSG generator)
+    : brownianBridge_(other.brownianBridge_), process_(other.process_),
+      generator_(generator), next_(other.next_), bb_(other.bb_),
+      variates_(generator_.dimension()), bridgeIn_(other.bridgeIn_.size()),
+      bridgeOut_(other.bridgeOut_.size()) {
+
+        QL_REQUIRE(generator_.dimension() == other.generator_.dimension(),
+                   "dimension (" << generator_.dimension()
+                   << ") is not equal to ("
+                   << other.generator_.dimension()
+                   << ") the dimension of the copied generator");
+    }
+
     template <class GSG>
     inline const typename MultiPathGenerator<GSG>::sample_type&
     MultiPathGenerator<GSG>::next() const {
@@ -103,50 +157,135 @@ namespace QuantLib {
     const typename MultiPathGenerator<GSG>::sample_type&
     MultiPathGenerator<GSG>::next(bool antithetic) const {
 
-        if (brownianBridge_) {
+        typedef typename GSG::sample_type sequence_type;
+        const sequence_type& sequence_ =
+            antithetic ? generator_.lastSequence()
+                       : generator_.nextSequence();
 
-            QL_FAIL("Brownian bridge not supported");
+        std::copy(sequence_.value.begin(), sequence_.value.end(),
+                  variates_.begin());
+        if (brownianBridge_)
+            bridge(variates_);
 
-        } else {
+        Size m = process_->size();
+        Size n = process_->factors();
 
-            typedef typename GSG::sample_type sequence_type;
-            const sequence_type& sequence_ =
-                antithetic ? generator_.lastSequence()
-                           : generator_.nextSequence();
+        MultiPath& path = next_.value;
 
-            Size m = process_->size();
-            Size n = process_->factors();
+        Array asset = process_->initialValues();
+        for (Size j=0; j<m; j++)
+            path[j].front() = asset[j];
 
-            MultiPath& path = next_.value;
+        Array temp(n);
+        next_.weight = sequence_.weight;
 
-            Array asset = process_->initialValues();
+        const TimeGrid& timeGrid = path[0].timeGrid();
+        Time t, dt;
+        for (Size i = 1; i < path.pathSize(); i++) {
+            Size offset = (i-1)*n;
+            t = timeGrid[i-1];
+            dt = timeGrid.dt(i-1);
+            if (antithetic)
+                std::transform(variates_.begin()+offset,
+                               variates_.begin()+offset+n,
+                               temp.begin(),
+                               std::negate<Real>());
+            else
+                std::copy(variates_.begin()+offset,
+                          variates_.begin()+offset+n,
+                          temp.begin());
+
+            asset = process_->evolve(t, asset, dt, temp);
             for (Size j=0; j<m; j++)
-                path[j].front() = asset[j];
-
-            Array temp(n);
-            next_.weight = sequence_.weight;
-
-            const TimeGrid& timeGrid = path[0].timeGrid();
-            Time t, dt;
-            for (Size i = 1; i < path.pathSize(); i++) {
-                Size offset = (i-1)*n;
-                t = timeGrid[i-1];
-                dt = timeGrid.dt(i-1);
-                if (antithetic)
-                    std::transform(sequence_.value.begin()+offset,
-                                   sequence_.value.begin()+offset+n,
-                                   temp.begin(),
-                                   std::negate<Real>());
-                else
-                    std::copy(sequence_.value.begin()+offset,
-                              sequence_.value.begin()+offset+n,
-                              temp.begin());
-
-                asset = process_->evolve(t, asset, dt, temp);
-                for (Size j=0; j<m; j++)
-                    path[j][i] = asset[j];
-            }
-            return next_;
+                path[j][i] = asset[j];
+        }
+        return next_;
+    }
+
+    template <class GSG>
+    void MultiPathGenerator<GSG>::bridge(std::vector<Real>& variates) const {
+        // the variates for the k-th point of the bridge of each
+        // factor are stored in the same place as the increments for
+        // the k-th step, i.e., starting at k*factors.
+        Size factors = process_->factors();
+        Size steps = bb_.size();
+        for (Size f=0; f<factors; f++) {
+            for (Size k=0; k<steps; k++)
+                bridgeIn_[k] = variates[k*factors+f];
+            bb_.transform(bridgeIn_.begin(), bridgeIn_.end(),
+                          bridgeOut_.begin());
+            for (Size k=0; k<steps; k++)
+                variates[k*factors+f] = bridgeOut_[k];
+        }
+    }
+
+    template <class GSG>
+    void MultiPathGenerator<GSG>::next(PathBlock& block) const {
+
+        const TimeGrid& timeGrid = next_.value[0].timeGrid();
+        QL_REQUIRE(block.assetNumber() == process_->size(),
+                   "block for " << block.assetNumber()
+                   << " assets given for a " << process_->size()
+                   << "-dimensional process");
+        QL_REQUIRE(block.length() == timeGrid.size(),
+                   "block length (" << block.length()
+                   << ") != time-grid size (" << timeGrid.size() << ")");
+
+        // store the variates in time-major order, so that the
+        // process can be evolved across the block at each step
+        Size n = block.paths();
+        Size dimension = generator_.dimension();
+        dw_.resize(dimension*n);
+        std::vector<Real>& weights = block.weights();
+        typedef typename GSG::sample_type sequence_type;
+        for (Size k=0; k<n; k++) {
+            const sequence_type& sequence_ = generator_.nextSequence();
+            std::copy(sequence_.value.begin(), sequence_.value.end(),
+                      variates_.begin());
+            if (brownianBridge_)
+                bridge(variates_);
+            for (Size i=0; i<dimension; i++)
+                dw_[i*n+k] = variates_[i];
+            weights[k] = sequence_.weight;
+        }
+
+        fillBlock(block, false);
+    }
+
+    template <class GSG>
+    void MultiPathGenerator<GSG>::antithetic(PathBlock& block) const {
+        QL_REQUIRE(dw_.size() == generator_.dimension()*block.paths(),
+                   "no block of the same size previously generated");
+        fillBlock(block, true);
+    }
+
+    template <class GSG>
+    void MultiPathGenerator<GSG>::fillBlock(PathBlock& block,
+                                            bool antithetic) const {
+
+        Size n = block.paths();
+        Size m = process_->size();
+        Size factors = process_->factors();
+
+        const Real* dw = &dw_[0];
+        if (antithetic) {
+            antitheticDw_.resize(dw_.size());
+            std::transform(dw_.begin(), dw_.end(),
+                           antitheticDw_.begin(),
+                           std::negate<Real>());
+            dw = &antitheticDw_[0];
+        }
+
+        Array asset = process_->initialValues();
+        for (Size j=0; j<m; j++)
+            std::fill(block.values(0,j), block.values(0,j)+n, asset[j]);
+
+        const TimeGrid& timeGrid = block.timeGrid();
+        for (Size i=1; i<timeGrid.size(); i++) {
+            Time t = timeGrid[i-1];
+            Time dt = timeGrid.dt(i-1);
+            process_->evolveBlock(t, block.values(i-1), dt,
+                                  dw+(i-1)*factors*n, block.values(i), n);
         }
     }
 
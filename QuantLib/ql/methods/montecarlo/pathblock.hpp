@@ -0,0 +1,107 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file pathblock.hpp
+    \brief Block of paths stored in structure-of-arrays layout
+*/
+
+#ifndef quantlib_montecarlo_path_block_hpp
+#define quantlib_montecarlo_path_block_hpp
+
+#include <ql/timegrid.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    //! Block of single- or multi-asset paths
+    /*! PathBlock stores the values of a number of paths sampled on
+        the same time grid.  The storage is time-major: the values of
+        all the paths for a given asset at a given time are
+        contiguous, so that the calculations performed across paths
+        at each time step can be vectorized.  In particular,
+        values(i,j) returns a pointer to the paths() values of the
+        j-th asset at the i-th point of the time grid, and the
+        values of all assets at the i-th point are stored as
+        consecutive rows starting at values(i).
+
+        \ingroup mcarlo
+    */
+    class PathBlock {
+      public:
+        PathBlock(Size nAsset,
+                  Size nPaths,
+                  const TimeGrid& timeGrid);
+        //! \name inspectors
+        //@{
+        Size assetNumber() const { return nAsset_; }
+        Size paths() const { return nPaths_; }
+        Size length() const { return timeGrid_.size(); }
+        const TimeGrid& timeGrid() const { return timeGrid_; }
+        //@}
+        //! \name read/write access to components
+        //@{
+        const Real* values(Size i, Size j = 0) const;
+        Real* values(Size i, Size j = 0);
+        Real value(Size path, Size i, Size j = 0) const;
+        //! weights of the paths, as returned by the sequence generator
+        const std::vector<Real>& weights() const { return weights_; }
+        std::vector<Real>& weights() { return weights_; }
+        //@}
+      private:
+        Size nAsset_, nPaths_;
+        TimeGrid timeGrid_;
+        std::vector<Real> values_;
+        std::vector<Real> weights_;
+    };
+
+
+    // inline definitions
+
+    inline PathBlock::PathBlock(Size nAsset,
+                                Size nPaths,
+                                const TimeGrid& timeGrid)
+    : nAsset_(nAsset), nPaths_(nPaths), timeGrid_(timeGrid),
+      values_(nAsset*nPaths*timeGrid.size()), weights_(nPaths, 1.0) {
+        QL_REQUIRE(nAsset > 0, "number of asset must be positive");
+        QL_REQUIRE(nPaths > 0, "number of paths must be positive");
+        QL_REQUIRE(timeGrid_.size() > 0, "no times given");
+    }
+
+    inline const Real* PathBlock::values(Size i, Size j) const {
+        #if defined(QL_EXTRA_SAFETY_CHECKS)
+        QL_REQUIRE(i < timeGrid_.size() && j < nAsset_,
+                   "index (" << i << "," << j << ") out of range");
+        #endif
+        return &values_[(i*nAsset_+j)*nPaths_];
+    }
+
+    inline Real* PathBlock::values(Size i, Size j) {
+        #if defined(QL_EXTRA_SAFETY_CHECKS)
+        QL_REQUIRE(i < timeGrid_.size() && j < nAsset_,
+                   "index (" << i << "," << j << ") out of range");
+        #endif
+        return &values_[(i*nAsset_+j)*nPaths_];
+    }
+
+    inline Real PathBlock::value(Size path, Size i, Size j) const {
+        return values(i,j)[path];
+    }
+
+}
+
+
+#endif
@@ -27,6 +27,7 @@
 #define quantlib_montecarlo_path_generator_hpp
 
 #include <ql/methods/montecarlo/brownianbridge.hpp>
+#include <ql/methods/montecarlo/pathblock.hpp>
 #include <ql/stochasticprocess.hpp>
 
 namespace QuantLib {
@@ -38,7 +39,9 @@ namespace QuantLib {
 
         \ingroup mcarlo
 
-        \test the generated paths are checked against cached results
+        \test the generated paths are checked against cached results;
+              paths generated in blocks are checked against the
+              corresponding paths generated one at a time.
     */
     template <class GSG>
     class PathGenerator {
@@ -54,6 +57,12 @@ namespace QuantLib {
                       const TimeGrid& timeGrid,
                       const GSG& generator,
                       bool brownianBridge);
+        /*! builds a generator for the same process and time grid
+            as the given one, drawing its variates from a different
+            sequence generator.
+        */
+        PathGenerator(const PathGenerator& other,
+                      const GSG& generator);
         //! \name inspectors
         //@{
         const sample_type& next() const;
@@ -61,8 +70,22 @@ namespace QuantLib {
         Size size() const { return dimension_; }
         const TimeGrid& timeGrid() const { return timeGrid_; }
         //@}
+        //! \name block generation
+        //@{
+        /*! fills the given block with block.paths() paths, drawing
+            the same sequences that as many calls to next() would.
+            The process is evolved across the whole block at each
+            time step by means of StochasticProcess::evolveBlock.
+        */
+        void next(PathBlock& block) const;
+        /*! fills the given block with the paths antithetic to the
+            ones generated by the last call to next(PathBlock&).
+        */
+        void antithetic(PathBlock& block) const;
+        //@}
       private:
         const sample_type& next(bool antithetic) const;
+        void fillBlock(PathBlock& block, bool antithetic) const;
         bool brownianBridge_;
         GSG generator_;
         Size dimension_;
@@ -71,6 +94,7 @@ namespace QuantLib {
         mutable sample_type next_;
         mutable std::vector<Real> temp_;
         BrownianBridge bb_;
+        mutable std::vector<Real> dw_, antitheticDw_;
     };
 
 
@@ -107,6 +131,18 @@ namespace QuantLib {
                    << ") != timeSteps (" << timeGrid_.size()-1 << ")");
     }
 
+    template <class GSG>
+    PathGenerator<GSG>::PathGenerator(const PathGenerator& other,
+                                      const GSG& generator)
+    : brownianBridge_(other.brownianBridge_), generator_(generator),
+      dimension_(generator_.dimension()), timeGrid_(other.timeGrid_),
+      process_(other.process_), next_(Path(timeGrid_),1.0),
+      temp_(dimension_), bb_(other.bb_) {
+        QL_REQUIRE(dimension_==other.dimension_,
+                   "sequence generator dimensionality (" << dimension_
+                   << ") != timeSteps (" << other.dimension_ << ")");
+    }
+
     template <class GSG>
     const typename PathGenerator<GSG>::sample_type&
     PathGenerator<GSG>::next() const {
@@ -154,6 +190,72 @@ namespace QuantLib {
         return next_;
     }
 
+    template <class GSG>
+    void PathGenerator<GSG>::next(PathBlock& block) const {
+
+        QL_REQUIRE(block.assetNumber() == 1,
+                   "block for " << block.assetNumber()
+                   << " assets given for a single-asset process");
+        QL_REQUIRE(block.length() == timeGrid_.size(),
+                   "block length (" << block.length()
+                   << ") != time-grid size (" << timeGrid_.size() << ")");
+
+        // store the variates in time-major order, so that the
+        // process can be evolved across the block at each step
+        Size n = block.paths();
+        dw_.resize(dimension_*n);
+        std::vector<Real>& weights = block.weights();
+        typedef typename GSG::sample_type sequence_type;
+        for (Size k=0; k<n; k++) {
+            const sequence_type& sequence_ = generator_.nextSequence();
+            if (brownianBridge_) {
+                bb_.transform(sequence_.value.begin(),
+                              sequence_.value.end(),
+                              temp_.begin());
+            } else {
+                std::copy(sequence_.value.begin(),
+                          sequence_.value.end(),
+                          temp_.begin());
+            }
+            for (Size i=0; i<dimension_; i++)
+                dw_[i*n+k] = temp_[i];
+            weights[k] = sequence_.weight;
+        }
+
+        fillBlock(block, false);
+    }
+
+    template <class GSG>
+    void PathGenerator<GSG>::antithetic(PathBlock& block) const {
+        QL_REQUIRE(dw_.size() == dimension_*block.paths(),
+                   "no block of the same size previously generated");
+        fillBlock(block, true);
+    }
+
+    template <class GSG>
+    void PathGenerator<GSG>::fillBlock(PathBlock& block,
+                                       bool antithetic) const {
+
+        Size n = block.paths();
+        const Real* dw = &dw_[0];
+        if (antithetic) {
+            antitheticDw_.resize(dw_.size());
+            std::transform(dw_.begin(), dw_.end(),
+                           antitheticDw_.begin(),
+                           std::negate<Real>());
+            dw = &antitheticDw_[0];
+        }
+
+        std::fill(block.values(0), block.values(0)+n, process_->x0());
+
+        for (Size i=1; i<timeGrid_.size(); i++) {
+            Time t = timeGrid_[i-1];
+            Time dt = timeGrid_.dt(i-1);
+            process_->evolveBlock(t, block.values(i-1), dt,
+                                  dw+(i-1)*n, block.values(i), n);
+        }
+    }
+
 }
 
 
@@ -28,6 +28,7 @@
 #include <ql/handle.hpp>
 #include <ql/math/optimization/constraint.hpp>
 #include <vector>
+#include <algorithm>
 
 namespace QuantLib {
 
@@ -156,9 +157,11 @@ namespace QuantLib {
         class NumericalImpl : public Parameter::Impl {
           public:
             NumericalImpl(const Handle<YieldTermStructure>& termStructure)
-            : times_(0), values_(0), termStructure_(termStructure) {}
+            : times_(0), values_(0), sorted_(true),
+              termStructure_(termStructure) {}
 
             void set(Time t, Real x) {
+                sorted_ = sorted_ && (times_.empty() || t >= times_.back());
                 times_.push_back(t);
                 values_.push_back(x);
             }
@@ -168,11 +171,16 @@ namespace QuantLib {
             void reset() {
                 times_.clear();
                 values_.clear();
+                sorted_ = true;
             }
             Real value(const Array&, Time t) const {
+                // trees set the times in increasing order; a binary
+                // search finds the same (first) match as a linear one
                 std::vector<Time>::const_iterator result =
+                    sorted_ ?
+                    std::lower_bound(times_.begin(), times_.end(), t) :
                     std::find(times_.begin(), times_.end(), t);
-                QL_REQUIRE(result!=times_.end(),
+                QL_REQUIRE(result!=times_.end() && *result == t,
                            "fitting parameter not set!");
                 return values_[result - times_.begin()];
             }
@@ -182,6 +190,7 @@ namespace QuantLib {
           private:
             std::vector<Time> times_;
             std::vector<Real> values_;
+            bool sorted_;
             Handle<YieldTermStructure> termStructure_;
         };
 
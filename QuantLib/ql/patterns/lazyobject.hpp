@@ -32,6 +32,7 @@ namespace QuantLib {
     /*! \ingroup patterns */
     class LazyObject : public virtual Observable,
                        public virtual Observer {
+        friend class LazyObjectScheduler;
       public:
         LazyObject();
         virtual ~LazyObject() {}
@@ -0,0 +1,212 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/patterns/lazyobjectscheduler.hpp>
+#include <ql/pricingengine.hpp>
+#include <ql/utilities/null.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <algorithm>
+#include <string>
+
+using boost::posix_time::ptime;
+using boost::posix_time::microsec_clock;
+
+namespace QuantLib {
+
+    namespace {
+
+        bool lowerLevel(const LazyObjectScheduler::Node& n1,
+                        const LazyObjectScheduler::Node& n2) {
+            return n1.level < n2.level;
+        }
+
+        Real secondsBetween(const ptime& t1, const ptime& t2) {
+            return (t2-t1).total_microseconds()*1.0e-6;
+        }
+
+    }
+
+    LazyObjectScheduler::LazyObjectScheduler(Size threads)
+    : threads_(threads), elapsed_(0.0) {
+        QL_REQUIRE(threads > 0, "at least one thread required");
+    }
+
+    void LazyObjectScheduler::add(const boost::shared_ptr<LazyObject>& o) {
+        QL_REQUIRE(o, "null object given");
+        roots_.push_back(o);
+    }
+
+    Observer::set_type
+    LazyObjectScheduler::observables(const Observer& observer) {
+        #ifdef QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
+        boost::lock_guard<boost::recursive_mutex> lock(observer.mutex_);
+        #endif
+        return observer.observables_;
+    }
+
+    Size LazyObjectScheduler::visit(const boost::shared_ptr<Observable>& o,
+                                    std::map<Observable*, Size>& depths) {
+        // returns the number of lazy objects in the longest chain of
+        // dependencies ending with the given observable.
+        std::map<Observable*, Size>::iterator i = depths.find(o.get());
+        if (i != depths.end())
+            // a null depth marks an observable being visited, i.e.,
+            // a cycle; we break it here.
+            return i->second == Null<Size>() ? 0 : i->second;
+        depths[o.get()] = Null<Size>();
+
+        Size depth = 0;
+        Observer* observer = dynamic_cast<Observer*>(o.get());
+        if (observer) {
+            Observer::set_type observables = this->observables(*observer);
+            for (Observer::iterator j=observables.begin();
+                 j!=observables.end(); ++j)
+                depth = std::max(depth, visit(*j, depths));
+        }
+
+        boost::shared_ptr<LazyObject> lazy =
+            boost::dynamic_pointer_cast<LazyObject>(o);
+        if (lazy) {
+            Node node;
+            node.object = lazy;
+            node.level = depth;
+            node.calculated = false;
+            node.seconds = 0.0;
+            nodes_.push_back(node);
+            ++depth;
+        }
+
+        depths[o.get()] = depth;
+        return depth;
+    }
+
+    void LazyObjectScheduler::calculate() {
+
+        ptime start = microsec_clock::universal_time();
+
+        // the dependencies might have changed since the last run
+        // (e.g., because a handle was relinked) so the graph is
+        // walked again.
+        nodes_.clear();
+        std::map<Observable*, Size> depths;
+        for (Size i=0; i<roots_.size(); ++i)
+            visit(roots_[i], depths);
+        std::stable_sort(nodes_.begin(), nodes_.end(), lowerLevel);
+
+        Size begin = 0;
+        while (begin < nodes_.size()) {
+            Size end = begin;
+            while (end < nodes_.size() &&
+                   nodes_[end].level == nodes_[begin].level)
+                ++end;
+
+            // objects in the same level don't depend on one another;
+            // however, instruments sharing a pricing engine would
+            // overwrite each other's arguments and results, so they
+            // are calculated in sequence as a single task.
+            std::vector<std::vector<Size> > tasks;
+            std::map<Observable*, Size> engineTasks;
+            for (Size i=begin; i<end; ++i) {
+                const LazyObject& o = *nodes_[i].object;
+                if (o.calculated_ || o.frozen_)
+                    continue;
+
+                std::vector<Observable*> engines;
+                Observer::set_type observables = this->observables(o);
+                for (Observer::iterator j=observables.begin();
+                     j!=observables.end(); ++j) {
+                    if (dynamic_cast<PricingEngine*>(j->get()))
+                        engines.push_back(j->get());
+                }
+
+                Size task = Null<Size>();
+                for (Size k=0; k<engines.size(); ++k) {
+                    std::map<Observable*, Size>::iterator e =
+                        engineTasks.find(engines[k]);
+                    if (e == engineTasks.end() || e->second == task)
+                        continue;
+                    if (task == Null<Size>()) {
+                        task = e->second;
+                    } else {
+                        // the object joins two tasks; merge them
+                        Size other = e->second;
+                        tasks[task].insert(tasks[task].end(),
+                                           tasks[other].begin(),
+                                           tasks[other].end());
+                        tasks[other].clear();
+                        for (e=engineTasks.begin();
+                             e!=engineTasks.end(); ++e)
+                            if (e->second == other)
+                                e->second = task;
+                    }
+                }
+                if (task == Null<Size>()) {
+                    task = tasks.size();
+                    tasks.push_back(std::vector<Size>());
+                }
+                tasks[task].push_back(i);
+                for (Size k=0; k<engines.size(); ++k)
+                    engineTasks[engines[k]] = task;
+            }
+
+            std::vector<std::string> errors(end-begin);
+            #pragma omp parallel for schedule(dynamic) num_threads(threads_)
+            for (Size t=0; t<tasks.size(); ++t) {
+                for (Size k=0; k<tasks[t].size(); ++k) {
+                    Size i = tasks[t][k];
+                    Node& node = nodes_[i];
+                    try {
+                        ptime t0 = microsec_clock::universal_time();
+                        node.object->calculate();
+                        node.seconds = secondsBetween(
+                                     t0, microsec_clock::universal_time());
+                        node.calculated = true;
+                    } catch (std::exception& e) {
+                        errors[i-begin] = e.what();
+                    } catch (...) {
+                        errors[i-begin] = "unknown error";
+                    }
+                }
+            }
+            for (Size i=0; i<errors.size(); ++i)
+                QL_REQUIRE(errors[i].empty(), errors[i]);
+
+            begin = end;
+        }
+
+        elapsed_ = secondsBetween(start, microsec_clock::universal_time());
+    }
+
+    const std::vector<LazyObjectScheduler::Node>&
+    LazyObjectScheduler::nodes() const {
+        return nodes_;
+    }
+
+    Size LazyObjectScheduler::calculated() const {
+        Size n = 0;
+        for (Size i=0; i<nodes_.size(); ++i)
+            if (nodes_[i].calculated)
+                ++n;
+        return n;
+    }
+
+    Real LazyObjectScheduler::elapsed() const {
+        return elapsed_;
+    }
+
+}
+
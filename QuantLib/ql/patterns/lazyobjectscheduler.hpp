@@ -0,0 +1,104 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file lazyobjectscheduler.hpp
+    \brief dependency-ordered recalculation of lazy objects
+*/
+
+#ifndef quantlib_lazy_object_scheduler_hpp
+#define quantlib_lazy_object_scheduler_hpp
+
+#include <ql/patterns/lazyobject.hpp>
+#include <map>
+#include <vector>
+
+namespace QuantLib {
+
+    //! Dependency-ordered recalculation of a set of lazy objects
+    /*! The scheduler walks the observables the given objects depend
+        upon (directly or through non-lazy observables such as
+        handles) and collects the lazy objects it finds.  When
+        calculate() is called, the ones needing recalculation are
+        sorted into levels, so that each object comes after all the
+        lazy objects it depends upon; the objects in each level are
+        independent of one another and are recalculated concurrently
+        when the library is compiled with OpenMP support.
+
+        The time spent recalculating each object is recorded and can
+        be retrieved after each run.
+
+        Instruments sharing a pricing engine are calculated in
+        sequence within a single task, since the engine stores their
+        arguments and results.
+
+        \warning Apart from pricing engines, objects in the same level
+                 are calculated in parallel.  This is only safe if
+                 their calculations don't modify other shared
+                 state---e.g., by relinking handles or registering
+                 with observables shared with other objects.  If in
+                 doubt, use a single thread.
+
+        \ingroup patterns
+
+        \test the calculation order and the results are checked
+              against those of the usual on-demand calculation, also
+              for instruments sharing an engine.
+    */
+    class LazyObjectScheduler {
+      public:
+        //! timing for a single object
+        struct Node {
+            boost::shared_ptr<LazyObject> object;
+            //! 0 for objects not depending on other lazy objects
+            Size level;
+            //! whether the object was recalculated in the last run
+            bool calculated;
+            //! wall-clock time spent in the last recalculation
+            Real seconds;
+        };
+        explicit LazyObjectScheduler(Size threads = 1);
+        //! adds an object to be kept up to date
+        void add(const boost::shared_ptr<LazyObject>&);
+        /*! recalculates all the added objects and the lazy objects
+            they depend upon that are out of date.
+        */
+        void calculate();
+        //! \name Inspectors
+        //@{
+        /*! the objects known to the scheduler, sorted by level, and
+            the outcome of the last run.
+        */
+        const std::vector<Node>& nodes() const;
+        //! number of objects recalculated in the last run
+        Size calculated() const;
+        //! total wall-clock time of the last run, in seconds
+        Real elapsed() const;
+        //@}
+      private:
+        static Observer::set_type observables(const Observer&);
+        Size visit(const boost::shared_ptr<Observable>&,
+                   std::map<Observable*, Size>& depths);
+        Size threads_;
+        std::vector<boost::shared_ptr<LazyObject> > roots_;
+        std::vector<Node> nodes_;
+        Real elapsed_;
+    };
+
+}
+
+
+#endif
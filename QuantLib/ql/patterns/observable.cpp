@@ -23,19 +23,89 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 
 #ifndef QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
 
+#include <boost/unordered_map.hpp>
+#include <vector>
+
 namespace QuantLib {
 
     void ObservableSettings::enableUpdates() {
-        updatesEnabled_  = true;
-        updatesDeferred_ = false;
 
         // if there are outstanding deferred updates, do the notification
         if (deferredObservers_.size()) {
             bool successful = true;
             std::string errMsg;
 
-            for (iterator i=deferredObservers_.begin();
-                i!=deferredObservers_.end(); ++i) {
+            // Collect the observers reachable from the deferred ones
+            // (an observer forwards notifications if it's also an
+            // observable) and count, for each of them, the number of
+            // reachable observables it depends upon.
+            std::vector<Observer*> nodes(deferredObservers_.begin(),
+                                         deferredObservers_.end());
+            boost::unordered_map<Observer*, Size> dependencies;
+            for (Size i=0; i<nodes.size(); ++i)
+                dependencies[nodes[i]] = 0;
+            for (Size i=0; i<nodes.size(); ++i) {
+                Observable* o = dynamic_cast<Observable*>(nodes[i]);
+                if (o) {
+                    for (Observable::iterator j=o->observers_.begin();
+                         j!=o->observers_.end(); ++j) {
+                        std::pair<boost::unordered_map<Observer*,
+                                                       Size>::iterator,
+                                  bool> k =
+                            dependencies.insert(std::make_pair(*j, Size(0)));
+                        if (k.second)
+                            nodes.push_back(*j);
+                        ++(k.first->second);
+                    }
+                }
+            }
+
+            // Sort them so that each one comes after its observables.
+            // Observers involved in cycles are left out; they will be
+            // notified in the usual way below.
+            std::vector<Observer*> sorted;
+            sorted.reserve(nodes.size());
+            for (Size i=0; i<nodes.size(); ++i)
+                if (dependencies[nodes[i]] == 0)
+                    sorted.push_back(nodes[i]);
+            for (Size i=0; i<sorted.size(); ++i) {
+                Observable* o = dynamic_cast<Observable*>(sorted[i]);
+                if (o) {
+                    for (Observable::iterator j=o->observers_.begin();
+                         j!=o->observers_.end(); ++j) {
+                        if (--dependencies[*j] == 0)
+                            sorted.push_back(*j);
+                    }
+                }
+            }
+
+            // Update them in order while updates are still deferred,
+            // so that the notifications they send only add their
+            // observers to the deferred set, i.e., mark them for
+            // update later in the pass.  Observers unregistering in
+            // the meantime (e.g., because they're being destroyed)
+            // are removed from the set and thus skipped.
+            for (Size i=0; i<sorted.size(); ++i) {
+                if (deferredObservers_.erase(sorted[i]) != 0) {
+                    try {
+                        sorted[i]->update();
+                    } catch (std::exception& e) {
+                        successful = false;
+                        errMsg = e.what();
+                    } catch (...) {
+                        successful = false;
+                    }
+                }
+            }
+
+            updatesEnabled_  = true;
+            updatesDeferred_ = false;
+
+            // whatever is left (observers in cycles, or registered
+            // during the pass) is notified with cascading updates
+            set_type remaining;
+            remaining.swap(deferredObservers_);
+            for (iterator i=remaining.begin(); i!=remaining.end(); ++i) {
                 try {
                     (*i)->update();
                 } catch (std::exception& e) {
@@ -46,10 +116,11 @@ namespace QuantLib {
                 }
             }
 
-            deferredObservers_.clear();
-
             QL_ENSURE(successful,
                   "could not notify one or more observers: " << errMsg);
+        } else {
+            updatesEnabled_  = true;
+            updatesDeferred_ = false;
         }
     }
 
@@ -52,8 +52,19 @@ namespace QuantLib {
     class Observable;
 
     //! global repository for run-time library settings
-    class ObservableSettings : public Singleton<ObservableSettings> {
-        friend class Singleton<ObservableSettings>;
+    /*! When updates are disabled with deferred notification, the
+        observers notified in the meantime are collected and updated
+        when enableUpdates() is called.  The latter propagates the
+        changes in a single pass: the observers reachable from the
+        collected ones are sorted so that each of them comes after
+        all the notifying objects it depends upon, and each one is
+        updated at most once, provided that at least one of its
+        observables notified it.  This way, a batch of quote changes
+        causes a single update of the objects that depend on several
+        of them instead of one cascade per quote.
+    */
+    class ObservableSettings : public Singleton<ObservableSettings, true> {
+        friend class Singleton<ObservableSettings, true>;
         friend class Observable;
       public:
         void disableUpdates(bool deferred=false) {
@@ -84,6 +95,7 @@ namespace QuantLib {
     /*! \ingroup patterns */
     class Observable {
         friend class Observer;
+        friend class ObservableSettings;
       public:
         // constructors, assignment, destructor
         Observable() : settings_(ObservableSettings::instance()) {}
@@ -105,6 +117,7 @@ namespace QuantLib {
     //! Object that gets notified when a given observable changes
     /*! \ingroup patterns */
     class Observer {
+        friend class LazyObjectScheduler;
       public:
 #if BOOST_VERSION < 104700
         typedef std::set<boost::shared_ptr<Observable> > set_type;
@@ -264,6 +277,7 @@ namespace QuantLib {
     class Observer : public boost::enable_shared_from_this<Observer> {
         friend class Observable;
         friend class ObservableSettings;
+        friend class LazyObjectScheduler;
       public:
         typedef boost::unordered_set<boost::shared_ptr<Observable> > set_type;
         typedef set_type::iterator iterator;
@@ -365,8 +379,8 @@ namespace QuantLib {
     };
 
     //! global repository for run-time library settings
-    class ObservableSettings : public Singleton<ObservableSettings> {
-        friend class Singleton<ObservableSettings>;
+    class ObservableSettings : public Singleton<ObservableSettings, true> {
+        friend class Singleton<ObservableSettings, true>;
         friend class Observable;
 
     public:
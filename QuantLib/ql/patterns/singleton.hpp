@@ -34,6 +34,11 @@
     #pragma managed(pop)
 #endif
 #include <map>
+#if defined(QL_ENABLE_EVALUATION_CONTEXTS)
+#include <boost/thread/locks.hpp>
+#include <boost/thread/recursive_mutex.hpp>
+#include <boost/thread/tss.hpp>
+#endif
 
 #if (_MANAGED == 1) || (_M_CEE == 1)
 // One of the Visual C++ /clr modes. In this case, the global instance
@@ -52,6 +57,16 @@ namespace QuantLib {
     Integer sessionId();
     #endif
 
+    #if defined(QL_ENABLE_EVALUATION_CONTEXTS)
+    namespace detail {
+        // see ql/evaluationcontext.hpp
+        Integer currentEvaluationContext();
+        boost::recursive_mutex& singletonMutex();
+        void registerEvaluationContextCleanup(Integer context,
+                                              void (*cleanup)(Integer));
+    }
+    #endif
+
     // this is required on VC++ when CLR support is enabled
     #if defined(QL_PATCH_MSVC)
         #pragma managed(push, off)
@@ -73,13 +88,31 @@ namespace QuantLib {
         as a single implemementation point should synchronization
         features be added.
 
+        When evaluation contexts are enabled, singletons declared as
+        <tt>Singleton<Foo, true></tt> return a separate instance for
+        each EvaluationContext; the others keep a single instance
+        shared by all contexts.  Each thread keeps the instance it
+        last used; the instances shared between threads are only
+        looked up, under a lock, when a thread changes context.
+
         \ingroup patterns
     */
-    template <class T>
+    template <class T, bool PerContext = false>
     class Singleton : private boost::noncopyable {
     #if (QL_MANAGED == 1)
       private:
         static std::map<Integer, boost::shared_ptr<T> > instances_;
+    #endif
+    #if defined(QL_ENABLE_EVALUATION_CONTEXTS)
+      private:
+        // the instance last used by a thread, and its context
+        struct CachedInstance {
+            Integer context;
+            T* instance;
+        };
+        static boost::thread_specific_ptr<CachedInstance>& cachedInstance();
+        static std::map<Integer, boost::shared_ptr<T> >& contextInstances();
+        static void release(Integer context);
     #endif
       public:
         //! access to the unique instance
@@ -90,14 +123,87 @@ namespace QuantLib {
 
     #if (QL_MANAGED == 1)
     // static member definition
-    template <class T>
-    std::map<Integer, boost::shared_ptr<T> > Singleton<T>::instances_;
+    template <class T, bool PerContext>
+    std::map<Integer, boost::shared_ptr<T> >
+    Singleton<T, PerContext>::instances_;
     #endif
 
     // template definitions
 
-    template <class T>
-    T& Singleton<T>::instance() {
+    #if defined(QL_ENABLE_EVALUATION_CONTEXTS)
+
+    template <class T, bool PerContext>
+    std::map<Integer, boost::shared_ptr<T> >&
+    Singleton<T, PerContext>::contextInstances() {
+        #if (QL_MANAGED == 0)
+        static std::map<Integer, boost::shared_ptr<T> > instances_;
+        #endif
+        return instances_;
+    }
+
+    template <class T, bool PerContext>
+    boost::thread_specific_ptr<
+                      typename Singleton<T, PerContext>::CachedInstance>&
+    Singleton<T, PerContext>::cachedInstance() {
+        static boost::thread_specific_ptr<CachedInstance> cachedInstance_;
+        return cachedInstance_;
+    }
+
+    template <class T, bool PerContext>
+    void Singleton<T, PerContext>::release(Integer context) {
+        boost::shared_ptr<T> instance;
+        {
+            boost::lock_guard<boost::recursive_mutex> lock(
+                                                   detail::singletonMutex());
+            std::map<Integer, boost::shared_ptr<T> >& instances =
+                contextInstances();
+            typename std::map<Integer, boost::shared_ptr<T> >::iterator i =
+                instances.find(context);
+            if (i != instances.end()) {
+                instance = i->second;
+                instances.erase(i);
+            }
+        }
+        // the instance is destroyed here, outside the lock
+    }
+
+    template <class T, bool PerContext>
+    T& Singleton<T, PerContext>::instance() {
+        // singletons not owned by contexts live in the default one
+        Integer id = PerContext ? detail::currentEvaluationContext() : 0;
+        // context ids are not reused, so the instance cached for the
+        // current context can't have been released while in use
+        CachedInstance* cached = cachedInstance().get();
+        if (cached && cached->context == id)
+            return *cached->instance;
+
+        T* instance;
+        {
+            boost::lock_guard<boost::recursive_mutex> lock(
+                                                   detail::singletonMutex());
+            boost::shared_ptr<T>& p = contextInstances()[id];
+            if (!p) {
+                p = boost::shared_ptr<T>(new T);
+                if (id != 0)
+                    detail::registerEvaluationContextCleanup(
+                                      id, &Singleton<T, PerContext>::release);
+            }
+            instance = p.get();
+        }
+
+        if (!cached) {
+            cached = new CachedInstance;
+            cachedInstance().reset(cached);
+        }
+        cached->context = id;
+        cached->instance = instance;
+        return *instance;
+    }
+
+    #else
+
+    template <class T, bool PerContext>
+    T& Singleton<T, PerContext>::instance() {
         #if (QL_MANAGED == 0)
         static std::map<Integer, boost::shared_ptr<T> > instances_;
         #endif
@@ -112,6 +218,8 @@ namespace QuantLib {
         return *instance;
     }
 
+    #endif
+
     // reverts the change above
     #if defined(QL_PATCH_MSVC)
         #pragma managed(pop)
@@ -50,7 +50,8 @@ namespace QuantLib {
              Size requiredSamples,
              Real requiredTolerance,
              Size maxSamples,
-             BigNatural seed);
+             BigNatural seed,
+             Size threads = 1);
       protected:
         boost::shared_ptr<path_pricer_type> pathPricer() const;
     };
@@ -83,7 +84,8 @@ namespace QuantLib {
              Size requiredSamples,
              Real requiredTolerance,
              Size maxSamples,
-             BigNatural seed)
+             BigNatural seed,
+             Size threads)
     : MCDiscreteAveragingAsianEngine<RNG,S>(process,
                                             brownianBridge,
                                             antitheticVariate,
@@ -91,7 +93,8 @@ namespace QuantLib {
                                             requiredSamples,
                                             requiredTolerance,
                                             maxSamples,
-                                            seed) {}
+                                            seed,
+                                            threads) {}
 
     template <class RNG, class S>
     inline
@@ -133,6 +136,7 @@ namespace QuantLib {
         MakeMCDiscreteArithmeticASEngine& withMaxSamples(Size samples);
         MakeMCDiscreteArithmeticASEngine& withSeed(BigNatural seed);
         MakeMCDiscreteArithmeticASEngine& withAntitheticVariate(bool b = true);
+        MakeMCDiscreteArithmeticASEngine& withThreads(Size threads);
         // conversion to pricing engine
         operator boost::shared_ptr<PricingEngine>() const;
       private:
@@ -142,6 +146,7 @@ namespace QuantLib {
         Real tolerance_;
         bool brownianBridge_;
         BigNatural seed_;
+        Size threads_;
     };
 
     template <class RNG, class S>
@@ -150,7 +155,8 @@ namespace QuantLib {
              const boost::shared_ptr<GeneralizedBlackScholesProcess>& process)
     : process_(process), antithetic_(false),
       samples_(Null<Size>()), maxSamples_(Null<Size>()),
-      tolerance_(Null<Real>()), brownianBridge_(true), seed_(0) {}
+      tolerance_(Null<Real>()), brownianBridge_(true), seed_(0),
+      threads_(1) {}
 
     template <class RNG, class S>
     inline MakeMCDiscreteArithmeticASEngine<RNG,S>&
@@ -202,6 +208,13 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S>
+    inline MakeMCDiscreteArithmeticASEngine<RNG,S>&
+    MakeMCDiscreteArithmeticASEngine<RNG,S>::withThreads(Size threads) {
+        threads_ = threads;
+        return *this;
+    }
+
     template <class RNG, class S>
     inline
     MakeMCDiscreteArithmeticASEngine<RNG,S>::
@@ -212,7 +225,8 @@ namespace QuantLib {
                                                     antithetic_,
                                                     samples_, tolerance_,
                                                     maxSamples_,
-                                                    seed_));
+                                                    seed_,
+                                                    threads_));
     }
 
 }
@@ -0,0 +1,279 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/pricingengines/blackbatchcalculator.hpp>
+#include <ql/math/distributions/normaldistribution.hpp>
+#include <ql/math/comparison.hpp>
+
+namespace QuantLib {
+
+    BlackBatchCalculator::BlackBatchCalculator(
+                                const std::vector<Option::Type>& optionTypes,
+                                const std::vector<Real>& strikes,
+                                const std::vector<Real>& forwards,
+                                const std::vector<Real>& stdDevs,
+                                const std::vector<Real>& discounts)
+    : strikes_(strikes), forwards_(forwards), stdDevs_(stdDevs),
+      discounts_(discounts) {
+
+        const Size n = strikes_.size();
+        QL_REQUIRE(optionTypes.size() == n,
+                   "wrong number of option types ("
+                   << optionTypes.size() << ", " << n << " required)");
+        QL_REQUIRE(forwards_.size() == n,
+                   "wrong number of forwards ("
+                   << forwards_.size() << ", " << n << " required)");
+        QL_REQUIRE(stdDevs_.size() == n,
+                   "wrong number of standard deviations ("
+                   << stdDevs_.size() << ", " << n << " required)");
+        QL_REQUIRE(discounts_.size() == n,
+                   "wrong number of discounts ("
+                   << discounts_.size() << ", " << n << " required)");
+
+        // 1 for puts, 0 for calls; used to avoid branching later
+        std::vector<Real> isPut(n);
+        // options for which the closed formula for d1 and d2 can't
+        // be used; they're expected to be rare, and are patched
+        // separately after the main loops
+        std::vector<Size> degenerate;
+        for (Size i=0; i<n; ++i) {
+            QL_REQUIRE(strikes_[i]>=0.0,
+                       "strike (" << strikes_[i] << ") must be non-negative");
+            QL_REQUIRE(forwards_[i]>0.0,
+                       "forward (" << forwards_[i] << ") must be positive");
+            QL_REQUIRE(stdDevs_[i]>=0.0,
+                       "stdDev (" << stdDevs_[i] << ") must be non-negative");
+            QL_REQUIRE(discounts_[i]>0.0,
+                       "discount (" << discounts_[i] << ") must be positive");
+            switch (optionTypes[i]) {
+              case Option::Call:
+                isPut[i] = 0.0;
+                break;
+              case Option::Put:
+                isPut[i] = 1.0;
+                break;
+              default:
+                QL_FAIL("invalid option type");
+            }
+            if (stdDevs_[i] < QL_EPSILON || close(strikes_[i], 0.0))
+                degenerate.push_back(i);
+        }
+
+        d1_.resize(n);
+        d2_.resize(n);
+        std::vector<Real> cum_d1(n), cum_d2(n), n_d1(n), n_d2(n);
+
+        // the degenerate entries are given harmless values here
+        // and overwritten below.
+        for (Size i=0; i<n; ++i) {
+            Real s = stdDevs_[i] < QL_EPSILON ? 1.0 : stdDevs_[i];
+            Real k = close(strikes_[i], 0.0) ? forwards_[i] : strikes_[i];
+            d1_[i] = std::log(forwards_[i]/k)/s + 0.5*s;
+            d2_[i] = d1_[i]-s;
+        }
+
+        CumulativeNormalDistribution f;
+        for (Size i=0; i<n; ++i) {
+            cum_d1[i] = f(d1_[i]);
+            cum_d2[i] = f(d2_[i]);
+        }
+
+        // same as f.derivative(), written out so that it can be vectorized
+        const Real normalizationFactor = M_SQRT_2*M_1_SQRTPI;
+        for (Size i=0; i<n; ++i) {
+            Real e1 = -(d1_[i]*d1_[i])/2.0;
+            Real e2 = -(d2_[i]*d2_[i])/2.0;
+            n_d1[i] = e1 <= -690.0 ? 0.0 : normalizationFactor*std::exp(e1);
+            n_d2[i] = e2 <= -690.0 ? 0.0 : normalizationFactor*std::exp(e2);
+        }
+
+        for (Size j=0; j<degenerate.size(); ++j) {
+            Size i = degenerate[j];
+            Real d, cum, density;
+            if (stdDevs_[i] >= QL_EPSILON) {
+                // null strike
+                d = QL_MAX_REAL; cum = 1.0; density = 0.0;
+            } else if (close(forwards_[i], strikes_[i])) {
+                d = 0.0; cum = 0.5; density = normalizationFactor;
+            } else if (forwards_[i] > strikes_[i]) {
+                d = QL_MAX_REAL; cum = 1.0; density = 0.0;
+            } else {
+                d = QL_MIN_REAL; cum = 0.0; density = 0.0;
+            }
+            d1_[i] = d2_[i] = d;
+            cum_d1[i] = cum_d2[i] = cum;
+            n_d1[i] = n_d2[i] = density;
+        }
+
+        alpha_.resize(n);
+        beta_.resize(n);
+        DalphaDd1_.resize(n);
+        DbetaDd2_.resize(n);
+        for (Size i=0; i<n; ++i) {
+            // call: alpha = N(d1), beta = -N(d2)
+            // put:  alpha = -N(-d1), beta = N(-d2)
+            alpha_[i] = cum_d1[i] - isPut[i];
+            beta_[i] = isPut[i] - cum_d2[i];
+            DalphaDd1_[i] = n_d1[i];
+            DbetaDd2_[i] = -n_d2[i];
+        }
+    }
+
+    std::vector<Real> BlackBatchCalculator::value() const {
+        const Size n = size();
+        std::vector<Real> result(n);
+        for (Size i=0; i<n; ++i)
+            result[i] = discounts_[i] *
+                (forwards_[i]*alpha_[i] + strikes_[i]*beta_[i]);
+        return result;
+    }
+
+    std::vector<Real> BlackBatchCalculator::deltaForward() const {
+        const Size n = size();
+        std::vector<Real> result(n);
+        for (Size i=0; i<n; ++i) {
+            Real temp = stdDevs_[i]*forwards_[i];
+            Real DalphaDforward = DalphaDd1_[i]/temp;
+            Real DbetaDforward  = DbetaDd2_[i]/temp;
+            result[i] = discounts_[i] *
+                (DalphaDforward*forwards_[i] + alpha_[i]
+                 + DbetaDforward*strikes_[i]);
+        }
+        return result;
+    }
+
+    std::vector<Real> BlackBatchCalculator::delta(
+                                     const std::vector<Real>& spots) const {
+        const Size n = size();
+        QL_REQUIRE(spots.size() == n,
+                   "wrong number of spots ("
+                   << spots.size() << ", " << n << " required)");
+        for (Size i=0; i<n; ++i)
+            QL_REQUIRE(spots[i] > 0.0, "positive spot value required: "
+                       << spots[i] << " not allowed");
+
+        std::vector<Real> result(n);
+        for (Size i=0; i<n; ++i) {
+            Real DforwardDs = forwards_[i]/spots[i];
+            Real temp = stdDevs_[i]*spots[i];
+            Real DalphaDs = DalphaDd1_[i]/temp;
+            Real DbetaDs  = DbetaDd2_[i]/temp;
+            result[i] = discounts_[i] *
+                (DalphaDs*forwards_[i] + alpha_[i]*DforwardDs
+                 + DbetaDs*strikes_[i]);
+        }
+        return result;
+    }
+
+    std::vector<Real> BlackBatchCalculator::gammaForward() const {
+        const Size n = size();
+        std::vector<Real> result(n);
+        for (Size i=0; i<n; ++i) {
+            Real temp = stdDevs_[i]*forwards_[i];
+            Real DalphaDforward = DalphaDd1_[i]/temp;
+            Real DbetaDforward  = DbetaDd2_[i]/temp;
+            Real D2alphaDforward2 =
+                -DalphaDforward/forwards_[i]*(1+d1_[i]/stdDevs_[i]);
+            Real D2betaDforward2 =
+                -DbetaDforward/forwards_[i]*(1+d2_[i]/stdDevs_[i]);
+            result[i] = discounts_[i] *
+                (D2alphaDforward2*forwards_[i] + 2.0*DalphaDforward
+                 + D2betaDforward2*strikes_[i]);
+        }
+        return result;
+    }
+
+    std::vector<Real> BlackBatchCalculator::gamma(
+                                     const std::vector<Real>& spots) const {
+        const Size n = size();
+        QL_REQUIRE(spots.size() == n,
+                   "wrong number of spots ("
+                   << spots.size() << ", " << n << " required)");
+        for (Size i=0; i<n; ++i)
+            QL_REQUIRE(spots[i] > 0.0, "positive spot value required: "
+                       << spots[i] << " not allowed");
+
+        std::vector<Real> result(n);
+        for (Size i=0; i<n; ++i) {
+            Real DforwardDs = forwards_[i]/spots[i];
+            Real temp = stdDevs_[i]*spots[i];
+            Real DalphaDs = DalphaDd1_[i]/temp;
+            Real DbetaDs  = DbetaDd2_[i]/temp;
+            Real D2alphaDs2 = -DalphaDs/spots[i]*(1+d1_[i]/stdDevs_[i]);
+            Real D2betaDs2  = -DbetaDs/spots[i]*(1+d2_[i]/stdDevs_[i]);
+            result[i] = discounts_[i] *
+                (D2alphaDs2*forwards_[i] + 2.0*DalphaDs*DforwardDs
+                 + D2betaDs2*strikes_[i]);
+        }
+        return result;
+    }
+
+    std::vector<Real> BlackBatchCalculator::vega(
+                                const std::vector<Time>& maturities) const {
+        const Size n = size();
+        QL_REQUIRE(maturities.size() == n,
+                   "wrong number of maturities ("
+                   << maturities.size() << ", " << n << " required)");
+        for (Size i=0; i<n; ++i)
+            QL_REQUIRE(maturities[i] >= 0.0,
+                       "negative maturity not allowed");
+
+        std::vector<Real> result(n);
+        for (Size i=0; i<n; ++i) {
+            Real temp = std::log(strikes_[i]/forwards_[i])
+                      / (stdDevs_[i]*stdDevs_[i]);
+            // actually DalphaDsigma / SQRT(T)
+            Real DalphaDsigma = DalphaDd1_[i]*(temp+0.5);
+            Real DbetaDsigma  = DbetaDd2_[i]*(temp-0.5);
+            result[i] = discounts_[i] * std::sqrt(maturities[i]) *
+                (DalphaDsigma*forwards_[i] + DbetaDsigma*strikes_[i]);
+        }
+        return result;
+    }
+
+    std::vector<Real> BlackBatchCalculator::theta(
+                                const std::vector<Real>& spots,
+                                const std::vector<Time>& maturities) const {
+        const Size n = size();
+        QL_REQUIRE(maturities.size() == n,
+                   "wrong number of maturities ("
+                   << maturities.size() << ", " << n << " required)");
+        for (Size i=0; i<n; ++i)
+            QL_REQUIRE(maturities[i] >= 0.0,
+                       "maturity (" << maturities[i]
+                       << ") must be non-negative");
+
+        const std::vector<Real> values = value();
+        const std::vector<Real> deltas = delta(spots);
+        const std::vector<Real> gammas = gamma(spots);
+
+        std::vector<Real> result(n);
+        for (Size i=0; i<n; ++i) {
+            Real variance = stdDevs_[i]*stdDevs_[i];
+            result[i] = -( std::log(discounts_[i])*values[i]
+                          +std::log(forwards_[i]/spots[i])*spots[i]*deltas[i]
+                          +0.5*variance*spots[i]*spots[i]*gammas[i])
+                        / maturities[i];
+        }
+        for (Size i=0; i<n; ++i) {
+            if (close(maturities[i], 0.0))
+                result[i] = 0.0;
+        }
+        return result;
+    }
+
+}
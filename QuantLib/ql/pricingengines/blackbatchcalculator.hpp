@@ -0,0 +1,87 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file blackbatchcalculator.hpp
+    \brief Black-formula calculator for batches of plain-vanilla options
+*/
+
+#ifndef quantlib_black_batch_calculator_hpp
+#define quantlib_black_batch_calculator_hpp
+
+#include <ql/option.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    //! Black 1976 calculator for batches of plain-vanilla options
+    /*! This class returns the same results as a BlackCalculator
+        built on a PlainVanillaPayoff for each of the given options,
+        but works on whole batches at once.  Inputs and results are
+        stored as separate arrays (one per quantity) and each
+        quantity is calculated by a loop without branches on the
+        option type, so that the compiler can vectorize the
+        calculations across options.
+
+        \bug As in BlackCalculator, division by zero occurs in the
+             greeks of options with null variance.
+
+        \test the results are checked against BlackCalculator on a
+              grid of strikes, forwards, volatilities and option
+              types, including degenerate cases.
+    */
+    class BlackBatchCalculator {
+      public:
+        BlackBatchCalculator(const std::vector<Option::Type>& optionTypes,
+                             const std::vector<Real>& strikes,
+                             const std::vector<Real>& forwards,
+                             const std::vector<Real>& stdDevs,
+                             const std::vector<Real>& discounts);
+        Size size() const { return strikes_.size(); }
+        //! option values
+        std::vector<Real> value() const;
+        /*! Sensitivities to change in the underlying forward price. */
+        std::vector<Real> deltaForward() const;
+        /*! Sensitivities to change in the underlying spot price. */
+        std::vector<Real> delta(const std::vector<Real>& spots) const;
+        /*! Second order derivatives with respect to change in the
+            underlying forward price. */
+        std::vector<Real> gammaForward() const;
+        /*! Second order derivatives with respect to change in the
+            underlying spot price. */
+        std::vector<Real> gamma(const std::vector<Real>& spots) const;
+        /*! Sensitivities to volatility. */
+        std::vector<Real> vega(const std::vector<Time>& maturities) const;
+        /*! Sensitivities to time to maturity. */
+        std::vector<Real> theta(const std::vector<Real>& spots,
+                                const std::vector<Time>& maturities) const;
+        //! \name inspectors
+        //@{
+        const std::vector<Real>& d1() const { return d1_; }
+        const std::vector<Real>& d2() const { return d2_; }
+        const std::vector<Real>& alpha() const { return alpha_; }
+        const std::vector<Real>& beta() const { return beta_; }
+        //@}
+      private:
+        std::vector<Real> strikes_, forwards_, stdDevs_, discounts_;
+        std::vector<Real> d1_, d2_;
+        std::vector<Real> alpha_, beta_, DalphaDd1_, DbetaDd2_;
+    };
+
+}
+
+
+#endif
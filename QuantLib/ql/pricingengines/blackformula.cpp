@@ -341,6 +341,140 @@ namespace QuantLib {
             forward, blackPrice, discount, displacement, guess, accuracy, maxIterations);
     }
 
+    std::vector<Real> blackFormulaImpliedStdDev(
+                        const std::vector<Option::Type>& optionTypes,
+                        const std::vector<Real>& strikes,
+                        const std::vector<Real>& forwards,
+                        const std::vector<Real>& blackPrices,
+                        const std::vector<Real>& discounts,
+                        std::vector<bool>& converged,
+                        Real displacement,
+                        Real accuracy,
+                        Natural maxIterations) {
+
+        const Size n = strikes.size();
+        QL_REQUIRE(optionTypes.size() == n,
+                   "wrong number of option types ("
+                   << optionTypes.size() << ", " << n << " required)");
+        QL_REQUIRE(forwards.size() == n,
+                   "wrong number of forwards ("
+                   << forwards.size() << ", " << n << " required)");
+        QL_REQUIRE(blackPrices.size() == n,
+                   "wrong number of prices ("
+                   << blackPrices.size() << ", " << n << " required)");
+        QL_REQUIRE(discounts.size() == n,
+                   "wrong number of discounts ("
+                   << discounts.size() << ", " << n << " required)");
+        QL_REQUIRE(accuracy > 0.0,
+                   "accuracy (" << accuracy << ") must be positive");
+
+        std::vector<Real> result(n, Null<Real>());
+        converged.assign(n, false);
+
+        // data of the out-of-the-money options, on which we solve
+        std::vector<Real> theta(n), strike(n), forward(n), price(n),
+                          moneyness(n), lower(n, 0.0), upper(n, QL_MAX_REAL);
+        std::vector<Size> active;
+        active.reserve(n);
+
+        QL_REQUIRE(displacement >= 0.0, "displacement ("
+                                            << displacement
+                                            << ") must be non-negative");
+
+        for (Size i=0; i<n; ++i) {
+            // invalid quotes are left as null instead of raising an
+            // error as in checkParameters; negated to catch NaN as well
+            if (!(strikes[i] + displacement >= 0.0
+                  && forwards[i] + displacement > 0.0
+                  && discounts[i] > 0.0
+                  && blackPrices[i] >= 0.0))
+                continue;
+
+            Real otherOptionPrice = blackPrices[i]
+                - optionTypes[i]*(forwards[i]-strikes[i])*discounts[i];
+            if (!(otherOptionPrice >= 0.0))
+                continue;
+
+            Option::Type type = optionTypes[i];
+            Real p = blackPrices[i];
+            if ((type==Option::Put && strikes[i]>forwards[i]) ||
+                (type==Option::Call && strikes[i]<forwards[i])) {
+                type = Option::Type(-1*type);
+                p = otherOptionPrice;
+            }
+            p /= discounts[i];
+
+            theta[i] = type;
+            strike[i] = strikes[i] + displacement;
+            forward[i] = forwards[i] + displacement;
+            price[i] = p;
+
+            // out-of-the-money prices are bounded by the forward
+            // (for calls) or by the strike (for puts)
+            if (p >= (type == Option::Call ? forward[i] : strike[i]))
+                continue;
+            if (p == 0.0) {
+                result[i] = 0.0;
+                converged[i] = true;
+                continue;
+            }
+
+            moneyness[i] = std::log(forward[i]/strike[i]);
+            Real guess = blackFormulaImpliedStdDevApproximation(
+                                    type, strike[i], forward[i], p, 1.0);
+            if (guess <= 0.0)
+                // Manaster-Koehler (1982) seed
+                guess = std::sqrt(2.0*std::fabs(moneyness[i]));
+            result[i] = guess;
+            active.push_back(i);
+        }
+
+        CumulativeNormalDistribution N;
+        const Real normalizationFactor = M_SQRT_2*M_1_SQRTPI;
+        for (Natural iteration=0;
+             iteration<maxIterations && !active.empty(); ++iteration) {
+            Size stillActive = 0;
+            for (Size j=0; j<active.size(); ++j) {
+                const Size i = active[j];
+                const Real s = result[i], x = moneyness[i], t = theta[i];
+
+                Real d1 = x/s + 0.5*s;
+                Real d2 = d1 - s;
+                Real f = t*(forward[i]*N(t*d1) - strike[i]*N(t*d2))
+                       - price[i];
+                if (f < 0.0)
+                    lower[i] = s;
+                else if (f > 0.0)
+                    upper[i] = s;
+
+                // Householder step of order 3; the ratios of the
+                // derivatives don't depend on the option type
+                Real vega = forward[i]*normalizationFactor
+                          * std::exp(-0.5*d1*d1);
+                Real nu = -f/vega;
+                Real h2 = x*x/(s*s*s) - 0.25*s;
+                Real h3 = h2*h2 - 3.0*x*x/(s*s*s*s) - 0.25;
+                Real next = s + nu*(1.0+0.5*h2*nu)
+                              / (1.0+nu*(h2+h3*nu/6.0));
+
+                // negated to catch NaN as well
+                if (!(next > lower[i] && next < upper[i]))
+                    next = upper[i] < QL_MAX_REAL ?
+                        0.5*(lower[i]+upper[i]) :
+                        2.0*s;
+
+                result[i] = next;
+                if (std::fabs(next-s) < accuracy)
+                    converged[i] = true;
+                else
+                    active[stillActive++] = i;
+            }
+            active.resize(stillActive);
+        }
+
+        return result;
+    }
+
     Real blackFormulaCashItmProbability(Option::Type optionType,
                                         Real strike,
                                         Real forward,
@@ -33,6 +33,7 @@
 
 #include <ql/option.hpp>
 #include <ql/instruments/payoffs.hpp>
+#include <vector>
 
 namespace QuantLib {
 
@@ -144,6 +145,32 @@ namespace QuantLib {
                         Real accuracy = 1.0e-6,
                         Natural maxIterations = 100);
 
+    /*! Black 1976 implied standard deviations for a batch of quotes,
+        i.e. volatility*sqrt(timeToMaturity)
+
+        All quotes are iterated in lockstep with third-order
+        Householder steps on the out-of-the-money option, starting
+        from the Corrado-Miller approximation and falling back to
+        bisection when a step leaves the bracket of the solution.
+        Converged quotes are dropped from the following iterations.
+
+        On return, converged[i] tells whether the i-th standard
+        deviation was found to the given accuracy; invalid quotes
+        (e.g., with negative prices, discounts or displaced strikes)
+        and quotes with no solution (i.e., outside the no-arbitrage
+        bounds) are returned as Null<Real>().
+    */
+    std::vector<Real> blackFormulaImpliedStdDev(
+                        const std::vector<Option::Type>& optionTypes,
+                        const std::vector<Real>& strikes,
+                        const std::vector<Real>& forwards,
+                        const std::vector<Real>& blackPrices,
+                        const std::vector<Real>& discounts,
+                        std::vector<bool>& converged,
+                        Real displacement = 0.0,
+                        Real accuracy = 1.0e-6,
+                        Natural maxIterations = 100);
+
 
     /*! Black 1976 probability of being in the money (in the bond martingale
         measure), i.e. N(d2).
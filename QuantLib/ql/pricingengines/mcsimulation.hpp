@@ -37,6 +37,10 @@ namespace QuantLib {
         Carlo engine.
 
         See McVanillaEngine as an example.
+
+        If more than one thread is requested, the samples are drawn
+        from independent random streams derived from the given seed;
+        see MonteCarloModel for details.
     */
 
     template <template <class> class MC, class RNG, class S = Statistics>
@@ -67,9 +71,12 @@ namespace QuantLib {
                        Size maxSamples) const;
       protected:
         McSimulation(bool antitheticVariate,
-                     bool controlVariate)
+                     bool controlVariate,
+                     Size threads = 1,
+                     BigNatural seed = 0)
         : antitheticVariate_(antitheticVariate),
-          controlVariate_(controlVariate) {}
+          controlVariate_(controlVariate),
+          threads_(threads), streamSeed_(seed) {}
         virtual boost::shared_ptr<path_pricer_type> pathPricer() const = 0;
         virtual boost::shared_ptr<path_generator_type> pathGenerator()
                                                                    const = 0;
@@ -97,6 +104,8 @@ namespace QuantLib {
         
         mutable boost::shared_ptr<MonteCarloModel<MC,RNG,S> > mcModel_;
         bool antitheticVariate_, controlVariate_;
+        Size threads_;
+        BigNatural streamSeed_;
     };
 
 
@@ -186,13 +195,18 @@ namespace QuantLib {
                     new MonteCarloModel<MC,RNG,S>(
                            pathGenerator(), this->pathPricer(), stats_type(),
                            this->antitheticVariate_, controlPP,
-                           controlVariateValue, controlPG));
+                           controlVariateValue, controlPG,
+                           this->threads_, this->streamSeed_));
         } else {
             this->mcModel_ =
                 boost::shared_ptr<MonteCarloModel<MC,RNG,S> >(
                     new MonteCarloModel<MC,RNG,S>(
                            pathGenerator(), this->pathPricer(), S(),
-                           this->antitheticVariate_));
+                           this->antitheticVariate_,
+                           boost::shared_ptr<path_pricer_type>(),
+                           result_type(),
+                           boost::shared_ptr<path_generator_type>(),
+                           this->threads_, this->streamSeed_));
         }
 
         if (requiredTolerance != Null<Real>()) {
@@ -0,0 +1,192 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/pricingengines/swaption/treeswaptionbatchengine.hpp>
+#include <ql/pricingengines/swaption/discretizedswaption.hpp>
+#include <algorithm>
+#include <functional>
+
+namespace QuantLib {
+
+    namespace {
+
+        // whether the two swaptions are priced the same
+        bool sameTerms(const Swaption::arguments& a1,
+                       const Swaption::arguments& a2) {
+            return a1.settlementType == a2.settlementType
+                && a1.type == a2.type
+                && a1.nominal == a2.nominal
+                && a1.fixedResetDates == a2.fixedResetDates
+                && a1.fixedPayDates == a2.fixedPayDates
+                && a1.floatingAccrualTimes == a2.floatingAccrualTimes
+                && a1.floatingResetDates == a2.floatingResetDates
+                && a1.floatingFixingDates == a2.floatingFixingDates
+                && a1.floatingPayDates == a2.floatingPayDates
+                && a1.fixedCoupons == a2.fixedCoupons
+                && a1.floatingSpreads == a2.floatingSpreads
+                && a1.floatingCoupons == a2.floatingCoupons;
+        }
+
+    }
+
+    TreeSwaptionBatchEngine::TreeSwaptionBatchEngine(
+                              const boost::shared_ptr<ShortRateModel>& model,
+                              Size timeSteps,
+                              const Handle<YieldTermStructure>& termStructure)
+    : LatticeShortRateModelEngine<Swaption::arguments,
+                                  Swaption::results>(model, timeSteps),
+      termStructure_(termStructure), calculated_(false) {
+        registerWith(termStructure_);
+    }
+
+    TreeSwaptionBatchEngine::TreeSwaptionBatchEngine(
+                              const Handle<ShortRateModel>& model,
+                              Size timeSteps,
+                              const Handle<YieldTermStructure>& termStructure)
+    : LatticeShortRateModelEngine<Swaption::arguments,
+                                  Swaption::results>(model, timeSteps),
+      termStructure_(termStructure), calculated_(false) {
+        registerWith(termStructure_);
+    }
+
+    void TreeSwaptionBatchEngine::addToBatch(
+                 const std::vector<boost::shared_ptr<Swaption> >& swaptions) {
+        for (Size i=0; i<swaptions.size(); ++i) {
+            Swaption::arguments arguments;
+            swaptions[i]->setupArguments(&arguments);
+            arguments.validate();
+            QL_REQUIRE(arguments.settlementType==Settlement::Physical,
+                       "cash-settled swaptions not priced with tree engine");
+            store(arguments);
+        }
+    }
+
+    void TreeSwaptionBatchEngine::update() {
+        calculated_ = false;
+        tree_.reset();
+        LatticeShortRateModelEngine<Swaption::arguments,
+                                    Swaption::results>::update();
+    }
+
+    void TreeSwaptionBatchEngine::calculate() const {
+
+        QL_REQUIRE(arguments_.settlementType==Settlement::Physical,
+                   "cash-settled swaptions not priced with tree engine");
+        QL_REQUIRE(!model_.empty(), "no model specified");
+
+        const Size i = store(arguments_);
+
+        if (!calculated_) {
+            calculateBatch();
+            calculated_ = true;
+        }
+
+        results_.value = batch_[i].value;
+    }
+
+    Size TreeSwaptionBatchEngine::store(
+                               const Swaption::arguments& arguments) const {
+        for (Size i=0; i<batch_.size(); ++i) {
+            if (batch_[i].arguments.swap == arguments.swap
+                && batch_[i].arguments.exercise == arguments.exercise) {
+                // the terms of the swap might have changed since the
+                // swaption was stored (e.g., because of new fixings)
+                if (!sameTerms(batch_[i].arguments, arguments)) {
+                    batch_[i].arguments = arguments;
+                    calculated_ = false;
+                }
+                return i;
+            }
+        }
+        batch_.push_back(Entry(arguments));
+        calculated_ = false;
+        return batch_.size()-1;
+    }
+
+    void TreeSwaptionBatchEngine::calculateBatch() const {
+
+        Date referenceDate;
+        DayCounter dayCounter;
+
+        boost::shared_ptr<TermStructureConsistentModel> tsmodel =
+            boost::dynamic_pointer_cast<TermStructureConsistentModel>(*model_);
+        if (tsmodel) {
+            referenceDate = tsmodel->termStructure()->referenceDate();
+            dayCounter = tsmodel->termStructure()->dayCounter();
+        } else {
+            referenceDate = termStructure_->referenceDate();
+            dayCounter = termStructure_->dayCounter();
+        }
+
+        const Size n = batch_.size();
+        std::vector<boost::shared_ptr<DiscretizedSwaption> > swaptions(n);
+        std::vector<Time> times, initialTimes(n), finalTimes(n);
+        for (Size i=0; i<n; ++i) {
+            const Swaption::arguments& arguments = batch_[i].arguments;
+            swaptions[i] = boost::shared_ptr<DiscretizedSwaption>(
+                new DiscretizedSwaption(arguments, referenceDate, dayCounter));
+            std::vector<Time> mandatoryTimes =
+                swaptions[i]->mandatoryTimes();
+            times.insert(times.end(),
+                         mandatoryTimes.begin(), mandatoryTimes.end());
+
+            std::vector<Time> stoppingTimes(arguments.exercise->dates().size());
+            for (Size j=0; j<stoppingTimes.size(); ++j)
+                stoppingTimes[j] =
+                    dayCounter.yearFraction(referenceDate,
+                                            arguments.exercise->date(j));
+            initialTimes[i] = stoppingTimes.back();
+            finalTimes[i] =
+                *std::find_if(stoppingTimes.begin(),
+                              stoppingTimes.end(),
+                              std::bind2nd(std::greater_equal<Time>(), 0.0));
+        }
+
+        // a single tree for the whole batch, unless the previous one
+        // spans the same times
+        TimeGrid timeGrid(times.begin(), times.end(), timeSteps_);
+        if (!tree_ || treeGrid_.size() != timeGrid.size()
+            || !std::equal(timeGrid.begin(), timeGrid.end(),
+                           treeGrid_.begin())) {
+            tree_ = model_->tree(timeGrid);
+            treeGrid_ = timeGrid;
+        }
+
+        for (Size i=0; i<n; ++i)
+            swaptions[i]->initialize(tree_, initialTimes[i]);
+
+        // the swaptions are rolled back together from one stopping
+        // time to the next; each is only rolled back between its
+        // initial and final times.
+        std::vector<Time> stops(initialTimes);
+        stops.insert(stops.end(), finalTimes.begin(), finalTimes.end());
+        std::sort(stops.begin(), stops.end(), std::greater<Time>());
+        stops.erase(std::unique(stops.begin(), stops.end()), stops.end());
+
+        for (Size k=0; k<stops.size(); ++k) {
+            for (Size i=0; i<n; ++i) {
+                if (finalTimes[i] <= stops[k]
+                    && stops[k] <= swaptions[i]->time())
+                    swaptions[i]->rollback(stops[k]);
+            }
+        }
+
+        for (Size i=0; i<n; ++i)
+            batch_[i].value = swaptions[i]->presentValue();
+    }
+
+}
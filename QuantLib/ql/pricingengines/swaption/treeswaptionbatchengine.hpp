@@ -0,0 +1,109 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file treeswaptionbatchengine.hpp
+    \brief Numerical lattice engine for batches of swaptions
+*/
+
+#ifndef quantlib_tree_swaption_batch_engine_hpp
+#define quantlib_tree_swaption_batch_engine_hpp
+
+#include <ql/instruments/swaption.hpp>
+#include <ql/pricingengines/latticeshortratemodelengine.hpp>
+
+namespace QuantLib {
+
+    //! Numerical lattice engine for batches of swaptions
+    /*! This engine prices together all the swaptions registered with
+        addToBatch() and caches their results until the model or the
+        term structure change.  A single tree is built on a time grid
+        containing the mandatory times of all the swaptions, with the
+        given number of steps over its whole length; the swaptions
+        are then rolled back on it simultaneously, stopping at each
+        of their initial and exercise times in turn.  The tree is
+        kept and reused as long as the model doesn't change and the
+        batch spans the same times.
+
+        Swaptions are identified by their underlying swap and
+        exercise; swaptions not registered in advance are added to
+        the batch when they're priced, and swaptions whose terms
+        changed since they were added (e.g., because of new fixings)
+        replace their previous entry.  Both cause the whole batch to
+        be recalculated.
+
+        Only swaptions are batched; caps and floors priced with the
+        TreeCapFloorEngine and swaps priced with the TreeSwapEngine
+        still build a tree each.
+
+        \ingroup swaptionengines
+
+        \warning As for the TreeSwaptionEngine, the underlying swaps
+                 must not start before today's date.
+
+        \test the results are checked against those of the
+              TreeSwaptionEngine, both on the same time grid and on
+              the ones it builds for each swaption.
+    */
+    class TreeSwaptionBatchEngine
+    : public LatticeShortRateModelEngine<Swaption::arguments,
+                                         Swaption::results> {
+      public:
+        /*! \note the term structure is only needed when the short-rate
+                  model cannot provide one itself.
+        */
+        TreeSwaptionBatchEngine(
+                           const boost::shared_ptr<ShortRateModel>&,
+                           Size timeSteps,
+                           const Handle<YieldTermStructure>& termStructure =
+                                                Handle<YieldTermStructure>());
+        TreeSwaptionBatchEngine(
+                           const Handle<ShortRateModel>&,
+                           Size timeSteps,
+                           const Handle<YieldTermStructure>& termStructure =
+                                                Handle<YieldTermStructure>());
+
+        //! adds the given swaptions to the batch
+        void addToBatch(
+                   const std::vector<boost::shared_ptr<Swaption> >& swaptions);
+
+        void calculate() const;
+        void update();
+
+      private:
+        struct Entry {
+            explicit Entry(const Swaption::arguments& arguments)
+            : arguments(arguments) {}
+            Swaption::arguments arguments;
+            Real value;
+        };
+        // returns the position of the swaption in the batch, after
+        // adding or updating it if needed
+        Size store(const Swaption::arguments& arguments) const;
+        void calculateBatch() const;
+
+        Handle<YieldTermStructure> termStructure_;
+        mutable std::vector<Entry> batch_;
+        mutable bool calculated_;
+        // the tree used for the latest batch, and its grid
+        mutable TimeGrid treeGrid_;
+        mutable boost::shared_ptr<Lattice> tree_;
+    };
+
+}
+
+
+#endif
@@ -106,6 +106,11 @@ namespace QuantLib {
 
         Real operator()(Real phi)      const;
 
+        /* exponent of the integrand without the strike-dependent
+           term, i.e., the integrand is
+           Im(exp(characteristicExponent(phi) - i phi log(K)))/phi */
+        std::complex<Real> characteristicExponent(Real phi) const;
+
     private:
         const Size j_;
         //     const VanillaOption::arguments& arg_;
@@ -205,6 +210,36 @@ namespace QuantLib {
 
 
     Real AnalyticHestonEngine::Fj_Helper::operator()(Real phi) const
+    {
+        if (cpxLog_ == Gatheral && phi == 0.0) {
+            // use l'Hospital's rule to get lim_{phi->0}
+            if (j_ == 1) {
+                const Real kmr = rsigma_-kappa_;
+                if (std::fabs(kmr) > 1e-7) {
+                    return dd_-sx_
+                        + (std::exp(kmr*term_)*kappa_*theta_
+                           -kappa_*theta_*(kmr*term_+1.0) ) / (2*kmr*kmr)
+                        - v0_*(1.0-std::exp(kmr*term_)) / (2.0*kmr);
+                }
+                else
+                    // \kappa = \rho * \sigma
+                    return dd_-sx_ + 0.25*kappa_*theta_*term_*term_
+                                   + 0.5*v0_*term_;
+            }
+            else {
+                return dd_-sx_
+                    - (std::exp(-kappa_*term_)*kappa_*theta_
+                       +kappa_*theta_*(kappa_*term_-1.0))/(2*kappa_*kappa_)
+                    - v0_*(1.0-std::exp(-kappa_*term_))/(2*kappa_);
+            }
+        }
+
+        return std::exp(characteristicExponent(phi)
+                        - std::complex<Real>(0.0, phi*sx_)).imag()/phi;
+    }
+
+    std::complex<Real>
+    AnalyticHestonEngine::Fj_Helper::characteristicExponent(Real phi) const
     {
         const Real rpsig(rsigma_*phi);
 
@@ -214,57 +249,29 @@ namespace QuantLib {
                       *std::complex<Real>(-phi, (j_== 1)? 1 : -1));
         const std::complex<Real> ex = std::exp(-d*term_);
         const std::complex<Real> addOnTerm
-            = engine_ > 0 ? engine_->addOnTerm(phi, term_, j_) : Real(0.0);
+            = engine_ != 0 ? engine_->addOnTerm(phi, term_, j_) : Real(0.0);
 
         if (cpxLog_ == Gatheral) {
-            if (phi != 0.0) {
-                if (sigma_ > 1e-5) {
-                    const std::complex<Real> p = (t1-d)/(t1+d);
-                    const std::complex<Real> g
-                                            = std::log((1.0 - p*ex)/(1.0 - p));
-
-                    return
-                        std::exp(v0_*(t1-d)*(1.0-ex)/(sigma2_*(1.0-ex*p))
-                                 + (kappa_*theta_)/sigma2_*((t1-d)*term_-2.0*g)
-                                 + std::complex<Real>(0.0, phi*(dd_-sx_))
-                                 + addOnTerm
-                                 ).imag()/phi;
-                }
-                else {
-                    const std::complex<Real> td = phi/(2.0*t1)
-                                   *std::complex<Real>(-phi, (j_== 1)? 1 : -1);
-                    const std::complex<Real> p = td*sigma2_/(t1+d);
-                    const std::complex<Real> g = p*(1.0-ex);
-
-                    return
-                        std::exp(v0_*td*(1.0-ex)/(1.0-p*ex)
-                                 + (kappa_*theta_)*(td*term_-2.0*g/sigma2_)
-                                 + std::complex<Real>(0.0, phi*(dd_-sx_))
-                                 + addOnTerm
-                                 ).imag()/phi;
-                }
+            if (sigma_ > 1e-5) {
+                const std::complex<Real> p = (t1-d)/(t1+d);
+                const std::complex<Real> g
+                                        = std::log((1.0 - p*ex)/(1.0 - p));
+
+                return v0_*(t1-d)*(1.0-ex)/(sigma2_*(1.0-ex*p))
+                    + (kappa_*theta_)/sigma2_*((t1-d)*term_-2.0*g)
+                    + std::complex<Real>(0.0, phi*dd_)
+                    + addOnTerm;
             }
             else {
-                // use l'Hospital's rule to get lim_{phi->0}
-                if (j_ == 1) {
-                    const Real kmr = rsigma_-kappa_;
-                    if (std::fabs(kmr) > 1e-7) {
-                        return dd_-sx_
-                            + (std::exp(kmr*term_)*kappa_*theta_
-                               -kappa_*theta_*(kmr*term_+1.0) ) / (2*kmr*kmr)
-                            - v0_*(1.0-std::exp(kmr*term_)) / (2.0*kmr);
-                    }
-                    else
-                        // \kappa = \rho * \sigma
-                        return dd_-sx_ + 0.25*kappa_*theta_*term_*term_
-                                       + 0.5*v0_*term_;
-                }
-                else {
-                    return dd_-sx_
-                        - (std::exp(-kappa_*term_)*kappa_*theta_
-                           +kappa_*theta_*(kappa_*term_-1.0))/(2*kappa_*kappa_)
-                        - v0_*(1.0-std::exp(-kappa_*term_))/(2*kappa_);
-                }
+                const std::complex<Real> td = phi/(2.0*t1)
+                               *std::complex<Real>(-phi, (j_== 1)? 1 : -1);
+                const std::complex<Real> p = td*sigma2_/(t1+d);
+                const std::complex<Real> g = p*(1.0-ex);
+
+                return v0_*td*(1.0-ex)/(1.0-p*ex)
+                    + (kappa_*theta_)*(td*term_-2.0*g/sigma2_)
+                    + std::complex<Real>(0.0, phi*dd_)
+                    + addOnTerm;
             }
         }
         else if (cpxLog_ == BranchCorrection) {
@@ -310,11 +317,10 @@ namespace QuantLib {
             g_km1_ = g.imag();
             g += std::complex<Real>(0, 2*b_*M_PI);
 
-            return std::exp(v0_*(t1+d)*(ex-1.0)/(sigma2_*(ex-p))
-                            + (kappa_*theta_)/sigma2_*((t1+d)*term_-2.0*g)
-                            + std::complex<Real>(0,phi*(dd_-sx_))
-                            + addOnTerm
-                            ).imag()/phi;
+            return v0_*(t1+d)*(ex-1.0)/(sigma2_*(ex-p))
+                + (kappa_*theta_)/sigma2_*((t1+d)*term_-2.0*g)
+                + std::complex<Real>(0,phi*dd_)
+                + addOnTerm;
         }
         else {
             QL_FAIL("unknown complex logarithm formula");
@@ -365,6 +371,62 @@ namespace QuantLib {
         return evaluations_;
     }
 
+    void AnalyticHestonEngine::update() {
+        strips_.clear();
+        GenericModelEngine<HestonModel,
+                           VanillaOption::arguments,
+                           VanillaOption::results>::update();
+    }
+
+    const AnalyticHestonEngine::Strip& AnalyticHestonEngine::strip(
+                                                   Real riskFreeDiscount,
+                                                   Real dividendDiscount,
+                                                   Real spotPrice,
+                                                   Time term) const {
+        const Real ratio = riskFreeDiscount/dividendDiscount;
+        const Real dd = std::log(spotPrice) - std::log(ratio);
+
+        std::map<Time, Strip>::iterator iter = strips_.find(term);
+        if (iter != strips_.end() && iter->second.dd == dd) {
+            evaluations_ = 0;
+            return iter->second;
+        }
+
+        const Real kappa = model_->kappa();
+        const Real theta = model_->theta();
+        const Real sigma = model_->sigma();
+        const Real v0    = model_->v0();
+        const Real rho   = model_->rho();
+
+        const Real c_inf = std::min(10.0, std::max(0.0001,
+                std::sqrt(1.0-square<Real>()(rho))/sigma))
+                *(v0 + kappa*theta*term);
+
+        Strip& s = strips_[term];
+        s.dd = dd;
+
+        std::vector<Real> weights;
+        integration_->nodes(c_inf, s.phi, weights);
+
+        // the strike doesn't enter the characteristic exponent
+        const Fj_Helper f1(kappa, theta, sigma, v0, spotPrice, rho, this,
+                           cpxLog_, term, 1.0, ratio, 1);
+        const Fj_Helper f2(kappa, theta, sigma, v0, spotPrice, rho, this,
+                           cpxLog_, term, 1.0, ratio, 2);
+
+        const Size n = s.phi.size();
+        s.f1.resize(n);
+        s.f2.resize(n);
+        for (Size k=0; k < n; ++k) {
+            const Real phi = s.phi[k];
+            s.f1[k] = weights[k]*std::exp(f1.characteristicExponent(phi))/phi;
+            s.f2[k] = weights[k]*std::exp(f2.characteristicExponent(phi))/phi;
+        }
+        evaluations_ = 2*n;
+
+        return s;
+    }
+
     void AnalyticHestonEngine::doCalculation(Real riskFreeDiscount,
                                              Real dividendDiscount,
                                              Real spotPrice,
@@ -435,6 +497,38 @@ namespace QuantLib {
         const Real strikePrice = payoff->strike();
         const Real term = process->time(arguments_.exercise->lastDate());
 
+        if (!integration_->isAdaptiveIntegration()) {
+            const Strip& s = strip(riskFreeDiscount, dividendDiscount,
+                                   spotPrice, term);
+
+            const Real sx = std::log(strikePrice);
+            Real p1 = 0.0, p2 = 0.0;
+            for (Size k=0; k < s.phi.size(); ++k) {
+                const Real phi = s.phi[k];
+                const std::complex<Real> e(std::cos(phi*sx),
+                                           -std::sin(phi*sx));
+                p1 += (s.f1[k]*e).imag();
+                p2 += (s.f2[k]*e).imag();
+            }
+            p1 /= M_PI;
+            p2 /= M_PI;
+
+            switch (payoff->optionType())
+            {
+              case Option::Call:
+                results_.value = spotPrice*dividendDiscount*(p1+0.5)
+                               - strikePrice*riskFreeDiscount*(p2+0.5);
+                break;
+              case Option::Put:
+                results_.value = spotPrice*dividendDiscount*(p1-0.5)
+                               - strikePrice*riskFreeDiscount*(p2-0.5);
+                break;
+              default:
+                QL_FAIL("unknown option type");
+            }
+            return;
+        }
+
         doCalculation(riskFreeDiscount,
                       dividendDiscount,
                       spotPrice,
@@ -546,6 +640,40 @@ namespace QuantLib {
         }
     }
 
+    void AnalyticHestonEngine::Integration::nodes(
+                                        Real c_inf,
+                                        std::vector<Real>& x,
+                                        std::vector<Real>& weights) const {
+        QL_REQUIRE(gaussianQuadrature_,
+                   "nodes are only available for non-adaptive algorithms");
+
+        const Array& xs = gaussianQuadrature_->x();
+        const Array& ws = gaussianQuadrature_->weights();
+
+        x.clear();
+        weights.clear();
+        for (Integer i = gaussianQuadrature_->order()-1; i >= 0; --i) {
+            switch(intAlgo_) {
+              case GaussLaguerre:
+                x.push_back(xs[i]);
+                weights.push_back(ws[i]);
+                break;
+              case GaussLegendre:
+              case GaussChebyshev:
+              case GaussChebyshev2nd:
+                // same mapping as integrand1; nodes it sets to zero
+                // are skipped
+                if ((xs[i]+1.0)*c_inf > QL_EPSILON) {
+                    x.push_back(-std::log(0.5*xs[i]+0.5)/c_inf);
+                    weights.push_back(ws[i]/((xs[i]+1.0)*c_inf));
+                }
+                break;
+              default:
+                QL_FAIL("unknwon integration algorithm");
+            }
+        }
+    }
+
     bool AnalyticHestonEngine::Integration::isAdaptiveIntegration() const {
         return intAlgo_ == GaussLobatto
             || intAlgo_ == GaussKronrod
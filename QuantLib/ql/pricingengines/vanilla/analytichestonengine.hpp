@@ -33,6 +33,7 @@
 
 #include <boost/function.hpp>
 #include <complex>
+#include <map>
 
 namespace QuantLib {
 
@@ -47,6 +48,15 @@ namespace QuantLib {
         needs some sort of "branch correction" to work properly.
         Gatheral's version does also work with adaptive integration
         routines and should be preferred over the original Heston version.
+
+        Strike strips:
+        with non-adaptive integration algorithms the characteristic
+        function is only evaluated at the nodes of the quadrature,
+        which don't depend on the strike. Its values are cached for
+        each maturity until the model changes, so that further options
+        with the same maturity (e.g., the calibration helpers of a
+        volatility surface sharing this engine) are priced by a sum
+        over the cached values.
     */
 
     /*! References:
@@ -74,6 +84,10 @@ namespace QuantLib {
         \test the correctness of the returned value is tested by
               reproducing results available in web/literature
               and comparison with Black pricing.
+
+        \test the values of strike strips priced with the cached
+              characteristic function are checked against those
+              obtained without caching.
     */
     class AnalyticHestonEngine
         : public GenericModelEngine<HestonModel,
@@ -103,6 +117,10 @@ namespace QuantLib {
 
 
         void calculate() const;
+        void update();
+        /*! number of evaluations of the integrand for the latest
+            option; options priced from cached values need none.
+        */
         Size numberOfEvaluations() const;
 
         static void doCalculation(Real riskFreeDiscount,
@@ -128,9 +146,22 @@ namespace QuantLib {
       private:
         class Fj_Helper;
 
+        /* weighted values of the integrands at the quadrature nodes,
+           without the strike-dependent factor */
+        struct Strip {
+            Real dd;
+            std::vector<Real> phi;
+            std::vector<std::complex<Real> > f1, f2;
+        };
+        const Strip& strip(Real riskFreeDiscount,
+                           Real dividendDiscount,
+                           Real spotPrice,
+                           Time term) const;
+
         mutable Size evaluations_;
         const ComplexLogFormula cpxLog_;
         const boost::shared_ptr<Integration> integration_;
+        mutable std::map<Time, Strip> strips_;
     };
 
 
@@ -160,6 +191,14 @@ namespace QuantLib {
         Real calculate(Real c_inf,
                        const boost::function1<Real, Real>& f) const;
 
+        /*! nodes and weights of the non-adaptive algorithms, mapped
+            onto \f$ [0, \infty) \f$ and in the order in which
+            calculate() evaluates them.
+        */
+        void nodes(Real c_inf,
+                   std::vector<Real>& x,
+                   std::vector<Real>& weights) const;
+
         Size numberOfEvaluations() const;
         bool isAdaptiveIntegration() const;
 
@@ -0,0 +1,185 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/exercise.hpp>
+#include <ql/instruments/payoffs.hpp>
+#include <ql/pricingengines/vanilla/coshestonengine.hpp>
+
+namespace QuantLib {
+
+    COSHestonEngine::COSHestonEngine(
+                                const boost::shared_ptr<HestonModel>& model,
+                                Real L, Size N)
+    : GenericModelEngine<HestonModel,
+                         VanillaOption::arguments,
+                         VanillaOption::results>(model),
+      L_(L), N_(N) {
+        QL_REQUIRE(L_ > 0.0, "non-positive truncation parameter given");
+        QL_REQUIRE(N_ > 1, "at least two terms required");
+    }
+
+    void COSHestonEngine::update() {
+        expiries_.clear();
+        GenericModelEngine<HestonModel,
+                           VanillaOption::arguments,
+                           VanillaOption::results>::update();
+    }
+
+    std::complex<Real> COSHestonEngine::chF(Real u, Time t) const {
+        const Real kappa = model_->kappa();
+        const Real theta = model_->theta();
+        const Real sigma = model_->sigma();
+        const Real v0    = model_->v0();
+        const Real rho   = model_->rho();
+        const Real sigma2 = sigma*sigma;
+
+        const std::complex<Real> iu(0.0, u);
+        const std::complex<Real> beta = kappa - rho*sigma*iu;
+        const std::complex<Real> d = std::sqrt(beta*beta + sigma2*(u*u+iu));
+
+        // (beta - d)/sigma^2, written so that it stays finite
+        // for vanishing sigma
+        const std::complex<Real> td = -(u*u+iu)/(beta + d);
+        const std::complex<Real> g = sigma2*td/(beta + d);
+        const std::complex<Real> ex = std::exp(-d*t);
+
+        // log((1 - g e^{-dt})/(1 - g))/sigma^2
+        const std::complex<Real> gs = (sigma > 1e-5)
+            ? std::log((1.0 - g*ex)/(1.0 - g))/sigma2
+            : td*(1.0-ex)/(beta + d);
+
+        return std::exp(v0*td*(1.0-ex)/(1.0-g*ex)
+                        + kappa*theta*(td*t - 2.0*gs));
+    }
+
+    Real COSHestonEngine::c1(Time t) const {
+        const Real kappa = model_->kappa();
+        const Real theta = model_->theta();
+        const Real v0    = model_->v0();
+
+        return (1.0-std::exp(-kappa*t))*(theta-v0)/(2.0*kappa)
+            - 0.5*theta*t;
+    }
+
+    Real COSHestonEngine::c2(Time t) const {
+        const Real kappa = model_->kappa();
+        const Real theta = model_->theta();
+        const Real sigma = model_->sigma();
+        const Real v0    = model_->v0();
+        const Real rho   = model_->rho();
+
+        const Real e1 = std::exp(-kappa*t);
+        const Real e2 = e1*e1;
+
+        return 1.0/(8.0*kappa*kappa*kappa)*(
+              sigma*t*kappa*e1*(v0-theta)*(8.0*kappa*rho - 4.0*sigma)
+            + kappa*rho*sigma*(1.0-e1)*(16.0*theta - 8.0*v0)
+            + 2.0*theta*kappa*t*(-4.0*kappa*rho*sigma + sigma*sigma
+                                 + 4.0*kappa*kappa)
+            + sigma*sigma*((theta - 2.0*v0)*e2
+                           + theta*(6.0*e1 - 7.0) + 2.0*v0)
+            + 8.0*kappa*kappa*(v0-theta)*(1.0-e1));
+    }
+
+    const COSHestonEngine::Expiry& COSHestonEngine::expiry(Time t) const {
+        std::map<Time, Expiry>::iterator iter = expiries_.find(t);
+        if (iter != expiries_.end())
+            return iter->second;
+
+        const Real m = c1(t);
+        const Real s = L_*std::sqrt(std::fabs(c2(t)));
+
+        // stored only when complete, so that a failure doesn't
+        // leave an unusable entry behind
+        Expiry e;
+        e.a = m - s;
+        e.b = m + s;
+        QL_REQUIRE(e.a < 0.0 && e.b > 0.0,
+                   "truncation range does not contain the forward");
+
+        const Real a = e.a, b = e.b;
+        e.terms.resize(N_);
+        for (Size k=0; k < N_; ++k) {
+            const Real u = k*M_PI/(b-a);
+
+            // cosine coefficients of the put payoff K (1 - e^y)^+
+            const Real chi = (std::cos(-u*a) - std::exp(a)
+                              + u*std::sin(-u*a))/(1.0 + u*u);
+            const Real psi = (k == 0) ? -a : std::sin(-u*a)/u;
+            Real U = 2.0/(b-a)*(psi - chi);
+            if (k == 0)
+                U *= 0.5;
+
+            const std::complex<Real> phi =
+                (k == 0) ? std::complex<Real>(1.0, 0.0) : chF(u, t);
+            e.terms[k] = U*phi*std::exp(std::complex<Real>(0.0, -u*a));
+        }
+
+        return expiries_.insert(std::make_pair(t, e)).first->second;
+    }
+
+    void COSHestonEngine::calculate() const {
+        // this is a european option pricer
+        QL_REQUIRE(arguments_.exercise->type() == Exercise::European,
+                   "not an European option");
+
+        // plain vanilla
+        boost::shared_ptr<PlainVanillaPayoff> payoff =
+            boost::dynamic_pointer_cast<PlainVanillaPayoff>(arguments_.payoff);
+        QL_REQUIRE(payoff, "non plain vanilla payoff given");
+
+        const boost::shared_ptr<HestonProcess>& process = model_->process();
+
+        const Date maturityDate = arguments_.exercise->lastDate();
+        const Real riskFreeDiscount =
+            process->riskFreeRate()->discount(maturityDate);
+        const Real dividendDiscount =
+            process->dividendYield()->discount(maturityDate);
+
+        const Real spotPrice = process->s0()->value();
+        QL_REQUIRE(spotPrice > 0.0, "negative or null underlying given");
+
+        const Real strikePrice = payoff->strike();
+        const Time t = process->time(maturityDate);
+
+        const Expiry& e = expiry(t);
+
+        const Real fwd = spotPrice*dividendDiscount/riskFreeDiscount;
+        const Real x = std::log(fwd/strikePrice);
+
+        Real sum = 0.0;
+        for (Size k=0; k < N_; ++k) {
+            const Real u = k*M_PI/(e.b-e.a);
+            sum += e.terms[k].real()*std::cos(u*x)
+                 - e.terms[k].imag()*std::sin(u*x);
+        }
+
+        const Real put = strikePrice*riskFreeDiscount*sum;
+
+        switch (payoff->optionType()) {
+          case Option::Put:
+            results_.value = put;
+            break;
+          case Option::Call:
+            results_.value = put + (fwd - strikePrice)*riskFreeDiscount;
+            break;
+          default:
+            QL_FAIL("unknown option type");
+        }
+    }
+
+}
@@ -0,0 +1,90 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file coshestonengine.hpp
+    \brief Heston engine based on Fourier-cosine series expansions
+*/
+
+#ifndef quantlib_cos_heston_engine_hpp
+#define quantlib_cos_heston_engine_hpp
+
+#include <ql/pricingengines/genericmodelengine.hpp>
+#include <ql/models/equity/hestonmodel.hpp>
+#include <ql/instruments/vanillaoption.hpp>
+#include <complex>
+#include <map>
+
+namespace QuantLib {
+
+    //! Heston-model engine for European options based on the COS method
+    /*! The option value is expanded in a Fourier-cosine series on
+        the truncation range \f$ [c_1 - L\sqrt{c_2}, c_1 + L\sqrt{c_2}] \f$
+        of the log-return, \f$ c_1 \f$ and \f$ c_2 \f$ being its first
+        two cumulants.  Neither the range nor the values of the
+        characteristic function at the \f$ N \f$ frequencies of the
+        series depend on the strike; they are cached for each
+        maturity until the model changes, and each further option
+        with the same maturity is priced by a sum over \f$ N \f$
+        terms.  This makes the engine well suited to dense strike
+        grids.
+
+        References:
+
+        F. Fang and C.W. Oosterlee, A Novel Pricing Method for
+        European Options Based on Fourier-Cosine Series Expansions,
+        SIAM Journal on Scientific Computing, 31(2), 826-848, 2008.
+
+        \ingroup vanillaengines
+
+        \test the correctness of the returned values is tested by
+              comparison with the AnalyticHestonEngine.
+    */
+    class COSHestonEngine
+        : public GenericModelEngine<HestonModel,
+                                    VanillaOption::arguments,
+                                    VanillaOption::results> {
+      public:
+        COSHestonEngine(const boost::shared_ptr<HestonModel>& model,
+                        Real L = 16, Size N = 200);
+
+        void calculate() const;
+        void update();
+
+        //! characteristic function of \f$ \ln(S_t/F_t) \f$
+        std::complex<Real> chF(Real u, Time t) const;
+
+        //! first two cumulants of \f$ \ln(S_t/F_t) \f$
+        Real c1(Time t) const;
+        Real c2(Time t) const;
+
+      private:
+        /* truncation range and the strike-independent factors of
+           the terms of the series */
+        struct Expiry {
+            Real a, b;
+            std::vector<std::complex<Real> > terms;
+        };
+        const Expiry& expiry(Time t) const;
+
+        const Real L_;
+        const Size N_;
+        mutable std::map<Time, Expiry> expiries_;
+    };
+
+}
+
+#endif
@@ -0,0 +1,230 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/exercise.hpp>
+#include <ql/processes/blackscholesprocess.hpp>
+#include <ql/math/interpolations/cubicinterpolation.hpp>
+#include <ql/methods/finitedifferences/operators/fdmblackscholesop.hpp>
+#include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
+#include <ql/methods/finitedifferences/utilities/fdminnervaluecalculator.hpp>
+#include <ql/methods/finitedifferences/meshers/fdmmeshercomposite.hpp>
+#include <ql/methods/finitedifferences/meshers/predefined1dmesher.hpp>
+#include <ql/methods/finitedifferences/meshers/fdmblackscholesmultistrikemesher.hpp>
+#include <ql/methods/finitedifferences/stepconditions/fdmstepconditioncomposite.hpp>
+#include <ql/methods/finitedifferences/stepconditions/fdmsnapshotcondition.hpp>
+#include <ql/pricingengines/vanilla/fdblackscholesbatchengine.hpp>
+
+namespace QuantLib {
+
+    FdBlackScholesBatchEngine::FdBlackScholesBatchEngine(
+            const boost::shared_ptr<GeneralizedBlackScholesProcess>& process,
+            Size tGrid, Size xGrid, Size dampingSteps,
+            const FdmSchemeDesc& schemeDesc,
+            bool localVol, Real illegalLocalVolOverwrite)
+    : process_(process),
+      tGrid_(tGrid), xGrid_(xGrid), dampingSteps_(dampingSteps),
+      schemeDesc_(schemeDesc),
+      localVol_(localVol),
+      illegalLocalVolOverwrite_(illegalLocalVolOverwrite),
+      calculated_(false) {
+
+        registerWith(process_);
+    }
+
+    void FdBlackScholesBatchEngine::addToBatch(
+              const std::vector<boost::shared_ptr<VanillaOption> >& options) {
+        for (Size i=0; i < options.size(); ++i) {
+            const boost::shared_ptr<PlainVanillaPayoff> payoff =
+                boost::dynamic_pointer_cast<PlainVanillaPayoff>(
+                                                     options[i]->payoff());
+            QL_REQUIRE(payoff, "non-plain payoff given");
+            const boost::shared_ptr<Exercise> exercise =
+                options[i]->exercise();
+
+            if (find(payoff, exercise) == batch_.size()) {
+                batch_.push_back(Entry(payoff, exercise));
+                calculated_ = false;
+            }
+        }
+    }
+
+    void FdBlackScholesBatchEngine::update() {
+        calculated_ = false;
+        VanillaOption::engine::update();
+    }
+
+    void FdBlackScholesBatchEngine::calculate() const {
+        const boost::shared_ptr<PlainVanillaPayoff> payoff =
+            boost::dynamic_pointer_cast<PlainVanillaPayoff>(arguments_.payoff);
+        QL_REQUIRE(payoff, "non-plain payoff given");
+
+        const Size i = find(payoff, arguments_.exercise);
+        if (i == batch_.size()) {
+            batch_.push_back(Entry(payoff, arguments_.exercise));
+            calculated_ = false;
+        }
+
+        if (!calculated_) {
+            calculateBatch();
+            calculated_ = true;
+        }
+
+        results_.value = batch_[i].value;
+        results_.delta = batch_[i].delta;
+        results_.gamma = batch_[i].gamma;
+        results_.theta = batch_[i].theta;
+    }
+
+    namespace {
+
+        bool sameExercise(const Exercise& e1, const Exercise& e2) {
+            return e1.type() == e2.type() && e1.dates() == e2.dates();
+        }
+
+    }
+
+    Size FdBlackScholesBatchEngine::find(
+                        const boost::shared_ptr<PlainVanillaPayoff>& payoff,
+                        const boost::shared_ptr<Exercise>& exercise) const {
+        for (Size i=0; i < batch_.size(); ++i) {
+            const Entry& e = batch_[i];
+            if (e.payoff->optionType() == payoff->optionType()
+                && e.payoff->strike() == payoff->strike()
+                && sameExercise(*e.exercise, *exercise))
+                return i;
+        }
+        return batch_.size();
+    }
+
+    void FdBlackScholesBatchEngine::calculateBatch() const {
+        // options sharing the same exercise are rolled back together
+        std::vector<bool> done(batch_.size(), false);
+        for (Size i=0; i < batch_.size(); ++i) {
+            if (done[i])
+                continue;
+
+            std::vector<Size> group;
+            for (Size j=i; j < batch_.size(); ++j) {
+                if (!done[j] && sameExercise(*batch_[i].exercise,
+                                             *batch_[j].exercise)) {
+                    group.push_back(j);
+                    done[j] = true;
+                }
+            }
+            calculateGroup(group);
+        }
+    }
+
+    void FdBlackScholesBatchEngine::calculateGroup(
+                                       const std::vector<Size>& group) const {
+        const boost::shared_ptr<Exercise> exercise =
+            batch_[group.front()].exercise;
+        const Time maturity = process_->time(exercise->lastDate());
+
+        const Size n = group.size();
+        std::vector<Real> strikes(n), indices(n);
+        for (Size j=0; j < n; ++j) {
+            strikes[j] = batch_[group[j]].payoff->strike();
+            indices[j] = Real(j);
+        }
+
+        // 1. Mesher
+        const boost::shared_ptr<Fdm1dMesher> equityMesher(
+            new FdmBlackScholesMultiStrikeMesher(
+                                     xGrid_, process_, maturity, strikes));
+        const boost::shared_ptr<FdmMesher> mesher(
+            new FdmMesherComposite(
+                equityMesher,
+                boost::shared_ptr<Fdm1dMesher>(
+                                         new Predefined1dMesher(indices))));
+
+        // 2. Calculator
+        std::vector<boost::shared_ptr<FdmInnerValueCalculator> >
+                                                           calculators(n);
+        for (Size j=0; j < n; ++j)
+            calculators[j] = boost::shared_ptr<FdmInnerValueCalculator>(
+                new FdmLogInnerValue(batch_[group[j]].payoff, mesher, 0));
+        const boost::shared_ptr<FdmInnerValueCalculator> calculator(
+                                   new FdmBatchInnerValue(calculators, 1));
+
+        // 3. Step conditions
+        const boost::shared_ptr<FdmStepConditionComposite> conditions =
+            FdmStepConditionComposite::vanillaComposite(
+                                    DividendSchedule(), exercise,
+                                    mesher, calculator,
+                                    process_->riskFreeRate()->referenceDate(),
+                                    process_->riskFreeRate()->dayCounter());
+
+        const boost::shared_ptr<FdmSnapshotCondition> thetaCondition(
+            new FdmSnapshotCondition(
+                0.99*std::min(1.0/365.0,
+                              conditions->stoppingTimes().empty()
+                                  ? maturity
+                                  : conditions->stoppingTimes().front())));
+
+        // 4. Boundary conditions
+        const FdmBoundaryConditionSet boundaries;
+
+        // 5. Solver
+        boost::shared_ptr<FdmLinearOpComposite> op;
+        if (localVol_)
+            op = boost::shared_ptr<FdmLinearOpComposite>(
+                new FdmBlackScholesOp(mesher, process_, strikes.front(),
+                                      true, illegalLocalVolOverwrite_));
+        else
+            op = boost::shared_ptr<FdmLinearOpComposite>(
+                new FdmBlackScholesOp(mesher, process_, strikes, 1));
+
+        const boost::shared_ptr<FdmLinearOpLayout> layout = mesher->layout();
+        Array rhs(layout->size());
+        const FdmLinearOpIterator endIter = layout->end();
+        for (FdmLinearOpIterator iter = layout->begin(); iter != endIter;
+             ++iter) {
+            rhs[iter.index()] = calculator->avgInnerValue(iter, maturity);
+        }
+
+        FdmBackwardSolver(op, boundaries,
+                          FdmStepConditionComposite::joinConditions(
+                                                 thetaCondition, conditions),
+                          schemeDesc_)
+            .rollback(rhs, maturity, 0.0, tGrid_, dampingSteps_);
+
+        // 6. Results, read off the grid line of each option
+        const std::vector<Real>& x = equityMesher->locations();
+        const Size m = x.size();
+        const Array& thetaValues = thetaCondition->getValues();
+
+        const Real spot = process_->x0();
+        const Real logSpot = std::log(spot);
+        for (Size j=0; j < n; ++j) {
+            Entry& e = batch_[group[j]];
+
+            const MonotonicCubicNaturalSpline interpolation(
+                x.begin(), x.end(), rhs.begin() + j*m);
+            const Real dx  = interpolation.derivative(logSpot);
+            const Real dxx = interpolation.secondDerivative(logSpot);
+
+            e.value = interpolation(logSpot);
+            e.delta = dx/spot;
+            e.gamma = (dxx - dx)/(spot*spot);
+            e.theta = (MonotonicCubicNaturalSpline(
+                           x.begin(), x.end(),
+                           thetaValues.begin() + j*m)(logSpot) - e.value)
+                / thetaCondition->getTime();
+        }
+    }
+}
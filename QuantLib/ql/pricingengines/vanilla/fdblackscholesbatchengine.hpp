@@ -0,0 +1,95 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fdblackscholesbatchengine.hpp
+    \brief Finite-Differences Black Scholes engine for batches of options
+*/
+
+#ifndef quantlib_fd_black_scholes_batch_engine_hpp
+#define quantlib_fd_black_scholes_batch_engine_hpp
+
+#include <ql/instruments/vanillaoption.hpp>
+#include <ql/instruments/payoffs.hpp>
+#include <ql/methods/finitedifferences/solvers/fdmbackwardsolver.hpp>
+
+namespace QuantLib {
+
+    class GeneralizedBlackScholesProcess;
+
+    //! Finite-Differences Black Scholes engine for batches of options
+    /*! This engine prices together all the plain-vanilla options
+        registered with addToBatch() and caches their results until
+        the process changes.  The options sharing the same exercise
+        are priced by a single backward solve on a two-dimensional
+        grid: the first direction is the log-spot, discretized by an
+        FdmBlackScholesMultiStrikeMesher suited to all the strikes,
+        while the second one runs over the options.  Each option thus
+        gets a grid line of its own, with the volatility implied at
+        its strike (or the local volatility, if requested); the
+        tridiagonal systems of all the lines are solved together at
+        each step.
+
+        Options not registered in advance are added to the batch when
+        they're priced; this causes the whole batch to be recalculated.
+
+        \ingroup vanillaengines
+
+        \test the results are checked against those of the
+              FdBlackScholesVanillaEngine for a batch of European and
+              American options with different strikes and expiries.
+    */
+    class FdBlackScholesBatchEngine : public VanillaOption::engine {
+      public:
+        FdBlackScholesBatchEngine(
+                const boost::shared_ptr<GeneralizedBlackScholesProcess>&,
+                Size tGrid = 100, Size xGrid = 100, Size dampingSteps = 0,
+                const FdmSchemeDesc& schemeDesc = FdmSchemeDesc::Douglas(),
+                bool localVol = false,
+                Real illegalLocalVolOverwrite = -Null<Real>());
+
+        //! adds the given options to the batch
+        void addToBatch(
+               const std::vector<boost::shared_ptr<VanillaOption> >& options);
+
+        void calculate() const;
+        void update();
+
+      private:
+        struct Entry {
+            Entry(const boost::shared_ptr<PlainVanillaPayoff>& payoff,
+                  const boost::shared_ptr<Exercise>& exercise)
+            : payoff(payoff), exercise(exercise) {}
+            boost::shared_ptr<PlainVanillaPayoff> payoff;
+            boost::shared_ptr<Exercise> exercise;
+            Real value, delta, gamma, theta;
+        };
+        Size find(const boost::shared_ptr<PlainVanillaPayoff>& payoff,
+                  const boost::shared_ptr<Exercise>& exercise) const;
+        void calculateBatch() const;
+        void calculateGroup(const std::vector<Size>& group) const;
+
+        const boost::shared_ptr<GeneralizedBlackScholesProcess> process_;
+        const Size tGrid_, xGrid_, dampingSteps_;
+        const FdmSchemeDesc schemeDesc_;
+        const bool localVol_;
+        const Real illegalLocalVolOverwrite_;
+        mutable std::vector<Entry> batch_;
+        mutable bool calculated_;
+    };
+}
+
+#endif
@@ -35,12 +35,14 @@ namespace QuantLib {
             const boost::shared_ptr<GeneralizedBlackScholesProcess>& process,
             Size tGrid, Size xGrid, Size dampingSteps, 
             const FdmSchemeDesc& schemeDesc,
-            bool localVol, Real illegalLocalVolOverwrite)
+            bool localVol, Real illegalLocalVolOverwrite,
+            FdmSolverDesc::TimeStepping timeStepping, Real tolerance)
     : process_(process),
       tGrid_(tGrid), xGrid_(xGrid), dampingSteps_(dampingSteps),
       schemeDesc_(schemeDesc), 
       localVol_(localVol),
-      illegalLocalVolOverwrite_(illegalLocalVolOverwrite) {
+      illegalLocalVolOverwrite_(illegalLocalVolOverwrite),
+      timeStepping_(timeStepping), tolerance_(tolerance) {
 
         registerWith(process_);
     }
@@ -78,7 +80,8 @@ namespace QuantLib {
 
         // 5. Solver
         FdmSolverDesc solverDesc = { mesher, boundaries, conditions, calculator,
-                                     maturity, tGrid_, dampingSteps_ };
+                                     maturity, tGrid_, dampingSteps_,
+                                     timeStepping_, tolerance_ };
 
         const boost::shared_ptr<FdmBlackScholesSolver> solver(
                 new FdmBlackScholesSolver(
@@ -91,5 +94,6 @@ namespace QuantLib {
         results_.delta = solver->deltaAt(spot);
         results_.gamma = solver->gammaAt(spot);
         results_.theta = solver->thetaAt(spot);
+        results_.additionalResults["timeSteps"] = solver->numberOfSteps();
     }
 }
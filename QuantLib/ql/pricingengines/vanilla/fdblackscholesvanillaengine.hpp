@@ -28,6 +28,7 @@
 
 #include <ql/pricingengine.hpp>
 #include <ql/instruments/dividendvanillaoption.hpp>
+#include <ql/methods/finitedifferences/solvers/fdmsolverdesc.hpp>
 #include <ql/methods/finitedifferences/solvers/fdmbackwardsolver.hpp>
 
 namespace QuantLib {
@@ -39,6 +40,10 @@ namespace QuantLib {
         \test the correctness of the returned value is tested by
               reproducing results available in web/literature
               and comparison with Black pricing.
+
+        The time stepping and its tolerance are passed to the solver
+        description (see FdmSolverDesc); the number of time steps
+        taken is returned as the "timeSteps" additional result.
     */
     class GeneralizedBlackScholesProcess;
 
@@ -50,7 +55,10 @@ namespace QuantLib {
                 Size tGrid = 100, Size xGrid = 100, Size dampingSteps = 0,
                 const FdmSchemeDesc& schemeDesc = FdmSchemeDesc::Douglas(),
                 bool localVol = false,
-                Real illegalLocalVolOverwrite = -Null<Real>());
+                Real illegalLocalVolOverwrite = -Null<Real>(),
+                FdmSolverDesc::TimeStepping timeStepping
+                                                = FdmSolverDesc::FixedSteps,
+                Real tolerance = 1.0e-4);
 
         void calculate() const;
 
@@ -60,6 +68,8 @@ namespace QuantLib {
         const FdmSchemeDesc schemeDesc_;
         const bool localVol_;
         const Real illegalLocalVolOverwrite_;
+        const FdmSolverDesc::TimeStepping timeStepping_;
+        const Real tolerance_;
     };
 }
 
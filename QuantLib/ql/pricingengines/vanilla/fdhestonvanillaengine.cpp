@@ -36,13 +36,15 @@ namespace QuantLib {
     FdHestonVanillaEngine::FdHestonVanillaEngine(
             const boost::shared_ptr<HestonModel>& model,
             Size tGrid, Size xGrid, Size vGrid, Size dampingSteps,
-            const FdmSchemeDesc& schemeDesc)
+            const FdmSchemeDesc& schemeDesc,
+            FdmSolverDesc::TimeStepping timeStepping, Real tolerance)
     : GenericModelEngine<HestonModel,
                         DividendVanillaOption::arguments,
                         DividendVanillaOption::results>(model),
       tGrid_(tGrid), xGrid_(xGrid), 
       vGrid_(vGrid), dampingSteps_(dampingSteps),
-      schemeDesc_(schemeDesc) {
+      schemeDesc_(schemeDesc),
+      timeStepping_(timeStepping), tolerance_(tolerance) {
     }
 
 
@@ -107,7 +109,8 @@ namespace QuantLib {
         // 5. Solver
         FdmSolverDesc solverDesc = { mesher, boundaries, conditions,
                                      calculator, maturity,
-                                     tGrid_, dampingSteps_ };
+                                     tGrid_, dampingSteps_,
+                                     timeStepping_, tolerance_ };
 
        return solverDesc;
     }
@@ -151,6 +154,7 @@ namespace QuantLib {
         results_.delta = solver->deltaAt(spot, v0);
         results_.gamma = solver->gammaAt(spot, v0);
         results_.theta = solver->thetaAt(spot, v0);
+        results_.additionalResults["timeSteps"] = solver->numberOfSteps();
         
         cachedArgs2results_.resize(strikes_.size());
         const boost::shared_ptr<StrikedTypePayoff> payoff =
@@ -168,6 +172,7 @@ namespace QuantLib {
             results.delta = solver->deltaAt(spot*d, v0);
             results.gamma = solver->gammaAt(spot*d, v0)*d;
             results.theta = solver->thetaAt(spot*d, v0)/d;                
+            results.additionalResults = results_.additionalResults;
         }
     }
     
@@ -41,6 +41,10 @@ namespace QuantLib {
         \test the correctness of the returned value is tested by
               reproducing results available in web/literature
               and comparison with Black pricing.
+
+        The time stepping and its tolerance are passed to the solver
+        description (see FdmSolverDesc); the number of time steps
+        taken is returned as the "timeSteps" additional result.
     */
     class FdHestonVanillaEngine
         : public GenericModelEngine<HestonModel,
@@ -52,7 +56,10 @@ namespace QuantLib {
             const boost::shared_ptr<HestonModel>& model,
             Size tGrid = 100, Size xGrid = 100, 
             Size vGrid = 50, Size dampingSteps = 0,
-            const FdmSchemeDesc& schemeDesc = FdmSchemeDesc::Hundsdorfer());
+            const FdmSchemeDesc& schemeDesc = FdmSchemeDesc::Hundsdorfer(),
+            FdmSolverDesc::TimeStepping timeStepping
+                                                = FdmSolverDesc::FixedSteps,
+            Real tolerance = 1.0e-4);
 
         void calculate() const;
         
@@ -66,6 +73,8 @@ namespace QuantLib {
       private:
         const Size tGrid_, xGrid_, vGrid_, dampingSteps_;
         const FdmSchemeDesc schemeDesc_;
+        const FdmSolverDesc::TimeStepping timeStepping_;
+        const Real tolerance_;
         
         std::vector<Real> strikes_;
         mutable std::vector<std::pair<DividendVanillaOption::arguments,
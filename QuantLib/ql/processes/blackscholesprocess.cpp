@@ -93,6 +93,31 @@ namespace QuantLib {
                                  stdDeviation(t0, x0, dt) * dw);
     }
 
+    void GeneralizedBlackScholesProcess::evolveBlock(Time t0,
+                                                     const Real* x0,
+                                                     Time dt,
+                                                     const Real* dw,
+                                                     Real* x,
+                                                     Size n) const {
+        localVolatility(); // trigger update if necessary
+        if (isStrikeIndependent_) {
+            // same as evolve(), with the path-independent terms
+            // calculated only once for the whole block
+            Real variance = blackVolatility_->blackVariance(t0 + dt, 0.01) -
+                            blackVolatility_->blackVariance(t0, 0.01);
+            Real drift = (riskFreeRate_->forwardRate(t0, t0 + dt, Continuous,
+                                                     NoFrequency, true) -
+                          dividendYield_->forwardRate(t0, t0 + dt, Continuous,
+                                                      NoFrequency, true)) *
+                dt - 0.5 * variance;
+            Real stdDev = std::sqrt(variance);
+            for (Size k=0; k<n; ++k)
+                x[k] = x0[k] * std::exp( stdDev * dw[k] + drift );
+        } else {
+            StochasticProcess1D::evolveBlock(t0, x0, dt, dw, x, n);
+        }
+    }
+
     Time GeneralizedBlackScholesProcess::time(const Date& d) const {
         return riskFreeRate_->dayCounter().yearFraction(
                                            riskFreeRate_->referenceDate(), d);
@@ -503,6 +503,109 @@ namespace QuantLib {
         return retVal;
     }
 
+    void HestonProcess::evolveBlock(Time t0, const Real* x0, Time dt,
+                                    const Real* dw, Real* x, Size n) const {
+        const Real sdt = std::sqrt(dt);
+        const Real sqrhov = std::sqrt(1.0 - rho_*rho_);
+
+        const Real* s0 = x0;
+        const Real* v0 = x0 + n;
+        const Real* dw0 = dw;
+        const Real* dw1 = dw + n;
+        Real* s = x;
+        Real* v = x + n;
+
+        switch (discretization_) {
+          case PartialTruncation:
+          case FullTruncation:
+          case Reflection:
+          {
+            // the rates don't depend on the path; see evolve() for
+            // the definition of the schemes
+            const Real rq = riskFreeRate_->forwardRate(t0, t0+dt, Continuous)
+                          - dividendYield_->forwardRate(t0, t0+dt, Continuous);
+            for (Size k=0; k<n; ++k) {
+                Real vol;
+                if (discretization_ == Reflection)
+                    vol = std::sqrt(std::fabs(v0[k]));
+                else
+                    vol = (v0[k] > 0.0) ? std::sqrt(v0[k]) : 0.0;
+                const Real vol2 = sigma_ * vol;
+                const Real mu = rq - 0.5 * vol * vol;
+                const Real nu = (discretization_ == PartialTruncation)
+                              ? kappa_*(theta_ - v0[k])
+                              : kappa_*(theta_ - vol*vol);
+                const Real vBase =
+                    (discretization_ == Reflection) ? vol*vol : v0[k];
+
+                s[k] = s0[k] * std::exp(mu*dt+vol*dw0[k]*sdt);
+                v[k] = vBase + nu*dt
+                     + vol2*sdt*(rho_*dw0[k] + sqrhov*dw1[k]);
+            }
+          }
+          break;
+          case QuadraticExponential:
+          case QuadraticExponentialMartingale:
+          {
+            const Real ex = std::exp(-kappa_*dt);
+
+            const Real g1 =  0.5;
+            const Real g2 =  0.5;
+            const Real k1 =  g1*dt*(kappa_*rho_/sigma_-0.5)-rho_/sigma_;
+            const Real k2 =  g2*dt*(kappa_*rho_/sigma_-0.5)+rho_/sigma_;
+            const Real k3 =  g1*dt*(1-rho_*rho_);
+            const Real k4 =  g2*dt*(1-rho_*rho_);
+            const Real A  =  k2+0.5*k4;
+
+            const Real mu = riskFreeRate_->forwardRate(t0, t0+dt, Continuous)
+                          - dividendYield_->forwardRate(t0, t0+dt, Continuous);
+            const CumulativeNormalDistribution cnd;
+
+            for (Size k=0; k<n; ++k) {
+                const Real m  =  theta_+(v0[k]-theta_)*ex;
+                const Real s2 =  v0[k]*sigma_*sigma_*ex/kappa_*(1-ex)
+                    + theta_*sigma_*sigma_/(2*kappa_)*(1-ex)*(1-ex);
+                const Real psi = s2/(m*m);
+
+                Real k0 = -rho_*kappa_*theta_*dt/sigma_;
+                if (psi < 1.5) {
+                    const Real b2 = 2/psi-1+std::sqrt(2/psi*(2/psi-1));
+                    const Real b  = std::sqrt(b2);
+                    const Real a  = m/(1+b2);
+
+                    if (discretization_ == QuadraticExponentialMartingale) {
+                        // martingale correction
+                        QL_REQUIRE(A < 1/(2*a), "illegal value");
+                        k0 = -A*b2*a/(1-2*A*a)+0.5*std::log(1-2*A*a)
+                             -(k1+0.5*k3)*v0[k];
+                    }
+                    v[k] = a*(b+dw1[k])*(b+dw1[k]);
+                }
+                else {
+                    const Real p = (psi-1)/(psi+1);
+                    const Real beta = (1-p)/m;
+
+                    const Real u = cnd(dw1[k]);
+
+                    if (discretization_ == QuadraticExponentialMartingale) {
+                        // martingale correction
+                        QL_REQUIRE(A < beta, "illegal value");
+                        k0 = -std::log(p+beta*(1-p)/(beta-A))
+                             -(k1+0.5*k3)*v0[k];
+                    }
+                    v[k] = ((u <= p) ? 0.0 : std::log((1-p)/(1-u))/beta);
+                }
+
+                s[k] = s0[k]*std::exp(mu*dt + k0 + k1*v0[k] + k2*v[k]
+                                      +std::sqrt(k3*v0[k]+k4*v[k])*dw0[k]);
+            }
+          }
+          break;
+          default:
+            StochasticProcess::evolveBlock(t0, x0, dt, dw, x, n);
+        }
+    }
+
     const Handle<Quote>& HestonProcess::s0() const {
         return s0_;
     }
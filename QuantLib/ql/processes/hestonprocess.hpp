@@ -71,6 +71,12 @@ namespace QuantLib {
         Disposable<Array> apply(const Array& x0, const Array& dx) const;
         Disposable<Array> evolve(Time t0, const Array& x0,
                                  Time dt, const Array& dw) const;
+        /*! The truncation, reflection and quadratic-exponential
+            schemes are evaluated across the whole block; the
+            other schemes fall back to the path-by-path evolution.
+        */
+        void evolveBlock(Time t0, const Real* x0, Time dt,
+                         const Real* dw, Real* x, Size n) const;
 
         Real v0()    const { return v0_; }
         Real rho()   const { return rho_; }
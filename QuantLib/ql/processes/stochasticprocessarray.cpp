@@ -107,6 +107,25 @@ namespace QuantLib {
         return tmp;
     }
 
+    void StochasticProcessArray::evolveBlock(Time t0, const Real* x0,
+                                             Time dt, const Real* dw,
+                                             Real* x, Size n) const {
+        const Size m = size();
+        std::vector<Real> dz(m*n, 0.0);
+        for (Size i=0; i<m; ++i) {
+            Real* dzi = &dz[i*n];
+            for (Size j=0; j<m; ++j) {
+                const Real c = sqrtCorrelation_[i][j];
+                const Real* dwj = dw + j*n;
+                for (Size k=0; k<n; ++k)
+                    dzi[k] += c*dwj[k];
+            }
+        }
+
+        for (Size i=0; i<m; ++i)
+            processes_[i]->evolveBlock(t0, x0+i*n, dt, &dz[i*n], x+i*n, n);
+    }
+
     Disposable<Array> StochasticProcessArray::apply(const Array& x0,
                                                     const Array& dx) const {
         Array tmp(size());
@@ -115,6 +115,10 @@
         #error Boost version 1.58 or higher is required for the thread-safe observer pattern
     #endif
 #endif
+
+#if defined(QL_ENABLE_SESSIONS) && defined(QL_ENABLE_EVALUATION_CONTEXTS)
+    #error Sessions and evaluation contexts cannot be both enabled
+#endif
 // ensure that needed math constants are defined
 #include <ql/mathconstants.hpp>
 
@@ -34,8 +34,8 @@
 namespace QuantLib {
 
     //! global repository for run-time library settings
-    class Settings : public Singleton<Settings> {
-        friend class Singleton<Settings>;
+    class Settings : public Singleton<Settings, true> {
+        friend class Singleton<Settings, true>;
       private:
         Settings();
         class DateProxy : public ObservableValue<Date> {
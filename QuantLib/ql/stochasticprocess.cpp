@@ -64,6 +64,22 @@ namespace QuantLib {
         return x0 + dx;
     }
 
+    void StochasticProcess::evolveBlock(Time t0, const Real* x0, Time dt,
+                                        const Real* dw, Real* x,
+                                        Size n) const {
+        const Size m = size(), f = factors();
+        Array y0(m), dz(f);
+        for (Size k=0; k<n; ++k) {
+            for (Size i=0; i<m; ++i)
+                y0[i] = x0[i*n+k];
+            for (Size i=0; i<f; ++i)
+                dz[i] = dw[i*n+k];
+            const Array y = evolve(t0, y0, dt, dz);
+            for (Size i=0; i<m; ++i)
+                x[i*n+k] = y[i];
+        }
+    }
+
     Time StochasticProcess::time(const Date& ) const {
         QL_FAIL("date/time conversion not supported");
     }
@@ -102,4 +118,11 @@ namespace QuantLib {
         return x0 + dx;
     }
 
+    void StochasticProcess1D::evolveBlock(Time t0, const Real* x0, Time dt,
+                                          const Real* dw, Real* x,
+                                          Size n) const {
+        for (Size k=0; k<n; ++k)
+            x[k] = evolve(t0, x0[k], dt, dw[k]);
+    }
+
 }
@@ -128,6 +128,23 @@ namespace QuantLib {
         */
         virtual Disposable<Array> apply(const Array& x0,
                                         const Array& dx) const;
+        /*! evolves a block of n paths over a time interval \f$
+            \Delta t \f$.  State variables and Brownian increments
+            are stored in structure-of-arrays layout, i.e., the i-th
+            state variable of the k-th path is x0[i*n+k] and the i-th
+            increment for the k-th path is dw[i*n+k].  The evolved
+            values are written into x in the same layout as x0.
+
+            By default, evolve() is called for each path; derived
+            classes can override this method to vectorize the
+            calculation across paths.
+        */
+        virtual void evolveBlock(Time t0,
+                                 const Real* x0,
+                                 Time dt,
+                                 const Real* dw,
+                                 Real* x,
+                                 Size n) const;
         //@}
 
         //! \name utilities
@@ -220,6 +237,11 @@ namespace QuantLib {
             returns \f$ x + \Delta x \f$.
         */
         virtual Real apply(Real x0, Real dx) const;
+        /*! evolves a block of n paths; by default, it calls
+            evolve() for each of them.
+        */
+        virtual void evolveBlock(Time t0, const Real* x0, Time dt,
+                                 const Real* dw, Real* x, Size n) const;
         //@}
       protected:
         StochasticProcess1D();
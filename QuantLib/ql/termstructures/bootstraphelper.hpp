@@ -252,6 +252,40 @@ namespace QuantLib {
             }
         };
 
+        // raised when the observed helper notifies a change; the
+        // notification is forwarded to the observers of the flag
+        class BootstrapHelperFlag : public Observable, public Observer {
+          public:
+            explicit BootstrapHelperFlag(
+                               const boost::shared_ptr<Observable>& helper)
+            : helper_(helper.get()), up_(true), notifying_(false) {
+                registerWith(helper);
+            }
+            const Observable* helper() const { return helper_; }
+            bool isUp() const { return up_; }
+            //! whether the flag is forwarding a notification
+            bool isNotifying() const { return notifying_; }
+            void lower() { up_ = false; }
+            void update() {
+                up_ = notifying_ = true;
+                try {
+                    notifyObservers();
+                } catch (...) {
+                    notifying_ = false;
+                    throw;
+                }
+                notifying_ = false;
+            }
+          private:
+            const Observable* helper_;
+            bool up_, notifying_;
+        };
+
+        // called by piecewise curves when notified of a change; only
+        // bootstraps keeping track of the changes need to know
+        template <class Bootstrap>
+        inline void notifyBootstrap(Bootstrap&) {}
+
     }
 
 }
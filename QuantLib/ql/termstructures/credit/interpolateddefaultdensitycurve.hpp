@@ -94,6 +94,9 @@ namespace QuantLib {
         //@{
         Real defaultDensityImpl(Time) const;
         Probability survivalProbabilityImpl(Time) const;
+        void survivalProbabilitiesImpl(const Time* t,
+                                       Probability* p,
+                                       Size n) const;
         //@}
         mutable std::vector<Date> dates_;
       private:
@@ -174,6 +177,23 @@ namespace QuantLib {
         return std::max<Real>(P, 0.0);
     }
 
+    template <class T>
+    void InterpolatedDefaultDensityCurve<T>::survivalProbabilitiesImpl(
+                                                       const Time* t,
+                                                       Probability* p,
+                                                       Size n) const {
+        // integrals of the default densities first, then probabilities
+        this->interpolation_.primitive(t, p, n, true);
+
+        Time tMax = this->times_.back();
+        for (Size i=0; i<n; ++i) {
+            if (t[i] == 0.0 || t[i] > tMax)
+                p[i] = survivalProbabilityImpl(t[i]);
+            else
+                p[i] = std::max<Real>(1.0 - p[i], 0.0);
+        }
+    }
+
     template <class T>
     InterpolatedDefaultDensityCurve<T>::InterpolatedDefaultDensityCurve(
                                     const DayCounter& dayCounter,
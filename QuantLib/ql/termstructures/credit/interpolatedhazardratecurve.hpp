@@ -95,6 +95,9 @@ namespace QuantLib {
         //@{
         Real hazardRateImpl(Time) const;
         Probability survivalProbabilityImpl(Time) const;
+        void survivalProbabilitiesImpl(const Time* t,
+                                       Probability* p,
+                                       Size n) const;
         //@}
         mutable std::vector<Date> dates_;
       private:
@@ -172,6 +175,23 @@ namespace QuantLib {
         return std::exp(-integral);
     }
 
+    template <class T>
+    void InterpolatedHazardRateCurve<T>::survivalProbabilitiesImpl(
+                                                       const Time* t,
+                                                       Probability* p,
+                                                       Size n) const {
+        // integrals of the hazard rates first, then probabilities
+        this->interpolation_.primitive(t, p, n, true);
+
+        Time tMax = this->times_.back();
+        for (Size i=0; i<n; ++i) {
+            if (t[i] == 0.0 || t[i] > tMax)
+                p[i] = survivalProbabilityImpl(t[i]);
+            else
+                p[i] = std::exp(-p[i]);
+        }
+    }
+
     template <class T>
     InterpolatedHazardRateCurve<T>::InterpolatedHazardRateCurve(
                                     const DayCounter& dayCounter,
@@ -79,6 +79,9 @@ namespace QuantLib {
         //! \name DefaultProbabilityTermStructure implementation
         //@{
         Probability survivalProbabilityImpl(Time) const;
+        void survivalProbabilitiesImpl(const Time* t,
+                                       Probability* p,
+                                       Size n) const;
         Real defaultDensityImpl(Time) const;
         //@}
         mutable std::vector<Date> dates_;
@@ -142,6 +145,21 @@ namespace QuantLib {
         return sMax * std::exp(- hazardMax * (t-tMax));
     }
 
+    template <class T>
+    void InterpolatedSurvivalProbabilityCurve<T>::survivalProbabilitiesImpl(
+                                                       const Time* t,
+                                                       Probability* p,
+                                                       Size n) const {
+        this->interpolation_(t, p, n, true);
+
+        // extrapolated probabilities are replaced
+        Time tMax = this->times_.back();
+        for (Size i=0; i<n; ++i) {
+            if (t[i] > tMax)
+                p[i] = survivalProbabilityImpl(t[i]);
+        }
+    }
+
     template <class T>
     Real
     InterpolatedSurvivalProbabilityCurve<T>::defaultDensityImpl(Time t) const {
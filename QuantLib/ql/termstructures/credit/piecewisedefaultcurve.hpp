@@ -159,6 +159,9 @@ namespace QuantLib {
         //@}
         // methods
         Probability survivalProbabilityImpl(Time) const;
+        void survivalProbabilitiesImpl(const Time* t,
+                                       Probability* p,
+                                       Size n) const;
         Real defaultDensityImpl(Time) const;
         Real hazardRateImpl(Time) const;
         // data members
@@ -213,6 +216,7 @@ namespace QuantLib {
 
     template <class C, class I, template <class> class B>
     inline void PiecewiseDefaultCurve<C,I,B>::update() {
+        detail::notifyBootstrap(bootstrap_);
         base_curve::update();
         LazyObject::update();
     }
@@ -224,6 +228,15 @@ namespace QuantLib {
         return base_curve::survivalProbabilityImpl(t);
     }
 
+    template <class C, class I, template <class> class B>
+    inline void PiecewiseDefaultCurve<C,I,B>::survivalProbabilitiesImpl(
+                                                       const Time* t,
+                                                       Probability* p,
+                                                       Size n) const {
+        calculate();
+        base_curve::survivalProbabilitiesImpl(t, p, n);
+    }
+
     template <class C, class I, template <class> class B>
     inline Real PiecewiseDefaultCurve<C,I,B>::defaultDensityImpl(Time t) const {
         calculate();
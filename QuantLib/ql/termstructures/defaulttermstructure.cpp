@@ -87,21 +87,48 @@ namespace QuantLib {
                                                      bool extrapolate) const {
         checkRange(t, extrapolate);
 
+        if (!jumps_.empty())
+            return jumpEffect(t) * survivalProbabilityImpl(t);
+
+        return survivalProbabilityImpl(t);
+    }
+
+    void DefaultProbabilityTermStructure::survivalProbability(
+                                                     const Time* t,
+                                                     Probability* p,
+                                                     Size n,
+                                                     bool extrapolate) const {
+        for (Size i=0; i<n; ++i)
+            checkRange(t[i], extrapolate);
+
+        survivalProbabilitiesImpl(t, p, n);
+
         if (!jumps_.empty()) {
-            Probability jumpEffect = 1.0;
-            for (Size i=0; i<nJumps_ && jumpTimes_[i]<t; ++i) {
-                QL_REQUIRE(jumps_[i]->isValid(),
-                           "invalid " << io::ordinal(i+1) << " jump quote");
-                DiscountFactor thisJump = jumps_[i]->value();
-                QL_REQUIRE(thisJump > 0.0 && thisJump <= 1.0,
-                           "invalid " << io::ordinal(i+1) << " jump value: " <<
-                           thisJump);
-                jumpEffect *= thisJump;
-            }
-            return jumpEffect * survivalProbabilityImpl(t);
+            for (Size i=0; i<n; ++i)
+                p[i] *= jumpEffect(t[i]);
         }
+    }
 
-        return survivalProbabilityImpl(t);
+    void DefaultProbabilityTermStructure::survivalProbabilitiesImpl(
+                                                     const Time* t,
+                                                     Probability* p,
+                                                     Size n) const {
+        for (Size i=0; i<n; ++i)
+            p[i] = survivalProbabilityImpl(t[i]);
+    }
+
+    Probability DefaultProbabilityTermStructure::jumpEffect(Time t) const {
+        Probability jumpEffect = 1.0;
+        for (Size i=0; i<nJumps_ && jumpTimes_[i]<t; ++i) {
+            QL_REQUIRE(jumps_[i]->isValid(),
+                       "invalid " << io::ordinal(i+1) << " jump quote");
+            DiscountFactor thisJump = jumps_[i]->value();
+            QL_REQUIRE(thisJump > 0.0 && thisJump <= 1.0,
+                       "invalid " << io::ordinal(i+1) << " jump value: " <<
+                       thisJump);
+            jumpEffect *= thisJump;
+        }
+        return jumpEffect;
     }
 
     Probability DefaultProbabilityTermStructure::defaultProbability(
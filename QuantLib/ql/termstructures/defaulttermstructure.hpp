@@ -77,6 +77,15 @@ namespace QuantLib {
         */
         Probability survivalProbability(Time t,
                                         bool extrapolate = false) const;
+        /*! Writes the survival probabilities at the n given times.
+            The results are the same as those of the single-time
+            method; however, interpolated curves retrieve them faster
+            when the times are sorted.
+        */
+        void survivalProbability(const Time* t,
+                                 Probability* p,
+                                 Size n,
+                                 bool extrapolate = false) const;
         //@}
 
         /*! \name Default probabilities
@@ -153,12 +162,21 @@ namespace QuantLib {
         //@{
         //! survival probability calculation
         virtual Probability survivalProbabilityImpl(Time) const = 0;
+        /*! survival probability calculation at n given times; the
+            default implementation calls survivalProbabilityImpl(Time)
+            for each of them.  Derived classes should override it if
+            a more efficient implementation is available.
+        */
+        virtual void survivalProbabilitiesImpl(const Time* t,
+                                               Probability* p,
+                                               Size n) const;
         //! default density calculation
         virtual Real defaultDensityImpl(Time) const = 0;
         //@}
       private:
         // methods
         void setJumps();
+        Probability jumpEffect(Time t) const;
         // data members
         std::vector<Handle<Quote> > jumps_;
         std::vector<Date> jumpDates_;
@@ -0,0 +1,371 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file globalbootstrap.hpp
+    \brief global Newton bootstrapper for piecewise term structures
+*/
+
+#ifndef quantlib_global_bootstrap_hpp
+#define quantlib_global_bootstrap_hpp
+
+#include <ql/termstructures/bootstraphelper.hpp>
+#include <ql/math/interpolations/linearinterpolation.hpp>
+#include <ql/math/broydensolver.hpp>
+#include <ql/utilities/dataformatters.hpp>
+
+namespace QuantLib {
+
+    //! Global Newton bootstrapper for piecewise term structures
+    /*! Unlike the IterativeBootstrap class, which solves for one
+        pillar at a time, this bootstrapper solves for all the pillars
+        at once: the quote errors of the helpers are driven to zero by
+        Newton steps on the whole vector of curve data.  The Jacobian
+        of the errors with respect to the data is estimated by finite
+        differences and then kept up to date by Broyden updates, so
+        that each further step costs a single revaluation of the
+        helpers.  With global interpolators (e.g., cubic or convex
+        monotone) this replaces the repeated pillar loops of the
+        iterative bootstrap.
+
+        The solution and the Jacobian are kept between calculations
+        and used as a starting point when the quotes move, e.g., on
+        intraday ticks; the new curve is then usually obtained in a
+        couple of steps.
+
+        The Jacobian at the solution is returned by jacobian(); its
+        inverse gives the sensitivities of the curve data to the
+        quotes, as returned by quoteSensitivities().
+
+        \test
+        - the correctness of the returned values is tested by
+          checking them against the original inputs.
+        - the sensitivities to the quotes are checked against those
+          obtained by bumping the quotes.
+    */
+    template <class Curve>
+    class GlobalBootstrap {
+        typedef typename Curve::traits_type Traits;
+        typedef typename Curve::interpolator_type Interpolator;
+      public:
+        GlobalBootstrap();
+        void setup(Curve* ts);
+        void calculate() const;
+        //! Jacobian of the quote errors with respect to the curve data
+        /*! The element \f$ (i,j) \f$ is the derivative of the error of
+            the \f$ i \f$-th alive helper, sorted by pillar, with
+            respect to the curve data at the \f$ (j+1) \f$-th node.
+        */
+        const Matrix& jacobian() const;
+        //! sensitivities of the curve data to the quotes of the helpers
+        /*! The element \f$ (i,j) \f$ is the derivative of the curve
+            data at the \f$ (i+1) \f$-th node with respect to the quote
+            of the \f$ j \f$-th alive helper.
+        */
+        Disposable<Matrix> quoteSensitivities() const;
+      private:
+        class ErrorFunction;
+        class JacobianFunction;
+        friend class ErrorFunction;
+        friend class JacobianFunction;
+        void initialize() const;
+        void setData(const Array& x) const;
+        void errors(Array& e) const;
+        Disposable<Matrix> computeJacobian(const Array& x,
+                                           const Array& e) const;
+        Curve* ts_;
+        Size n_;
+        mutable bool initialized_, validCurve_, exactJacobian_;
+        mutable Size firstAliveHelper_, alive_;
+        mutable Matrix jacobian_;
+    };
+
+
+    namespace detail {
+
+        /* Sorts the helpers of a curve solved for all its pillars at
+           once, skips the expired ones and sets the pillar dates and
+           times; returns the index of the first alive helper. */
+        template <class Curve, class Helper>
+        Size initializeGlobalBootstrap(
+                          const Curve* ts,
+                          std::vector<boost::shared_ptr<Helper> >& helpers,
+                          std::vector<Date>& dates,
+                          std::vector<Time>& times,
+                          Date& maxDate) {
+            typedef typename Curve::traits_type Traits;
+            typedef typename Curve::interpolator_type Interpolator;
+
+            const Size n = helpers.size();
+            // ensure helpers are sorted
+            std::sort(helpers.begin(), helpers.end(),
+                      detail::BootstrapHelperSorter());
+            // skip expired helpers
+            Date firstDate = Traits::initialDate(ts);
+            QL_REQUIRE(helpers[n-1]->pillarDate()>firstDate,
+                       "all instruments expired");
+            Size firstAliveHelper = 0;
+            while (helpers[firstAliveHelper]->pillarDate() <= firstDate)
+                ++firstAliveHelper;
+            Size alive = n-firstAliveHelper;
+            QL_REQUIRE(alive>=Interpolator::requiredPoints-1,
+                       "not enough alive instruments: " << alive <<
+                       " provided, " << Interpolator::requiredPoints-1 <<
+                       " required");
+
+            // calculate dates and times
+            dates.resize(alive+1);
+            times.resize(alive+1);
+            dates[0] = firstDate;
+            times[0] = ts->timeFromReference(dates[0]);
+
+            Date latestRelevantDate;
+            maxDate = firstDate;
+            // pillar counter: i
+            // helper counter: j
+            for (Size i=1, j=firstAliveHelper; j<n; ++i, ++j) {
+                const boost::shared_ptr<Helper>& helper = helpers[j];
+                dates[i] = helper->pillarDate();
+                times[i] = ts->timeFromReference(dates[i]);
+                // check for duplicated pillars
+                QL_REQUIRE(dates[i-1]!=dates[i],
+                           "more than one instrument with pillar " <<
+                           dates[i]);
+
+                latestRelevantDate = helper->latestRelevantDate();
+                // check that the helper is really extending the curve,
+                // i.e. that pillar-sorted helpers are also sorted by
+                // latestRelevantDate
+                QL_REQUIRE(latestRelevantDate > maxDate,
+                           io::ordinal(j+1) << " instrument (pillar: " <<
+                           dates[i] << ") has latestRelevantDate (" <<
+                           latestRelevantDate << ") before or equal to "
+                           "previous instrument's latestRelevantDate (" <<
+                           maxDate << ")");
+                maxDate = latestRelevantDate;
+            }
+            return firstAliveHelper;
+        }
+
+        /* Links the alive helpers to the curve, sets the data to an
+           initial guess unless the previous ones can be used, and
+           sets the interpolation of the curve on them. */
+        template <class Curve, class Helper, class Interpolator>
+        void setupGlobalBootstrap(
+                    Curve* ts,
+                    const std::vector<boost::shared_ptr<Helper> >& helpers,
+                    Size firstAliveHelper,
+                    bool validData,
+                    const std::vector<Time>& times,
+                    std::vector<Real>& data,
+                    Interpolation& interpolation,
+                    const Interpolator& interpolator) {
+            typedef typename Curve::traits_type Traits;
+
+            for (Size j=firstAliveHelper; j<helpers.size(); ++j) {
+                const boost::shared_ptr<Helper>& helper = helpers[j];
+                // check for valid quote
+                QL_REQUIRE(helper->quote()->isValid(),
+                           io::ordinal(j + 1) << " instrument (maturity: " <<
+                           helper->maturityDate() << ", pillar: " <<
+                           helper->pillarDate() << ") has an invalid quote");
+                // don't try this at home!
+                // This call creates helpers, and removes "const".
+                // There is a significant interaction with observability.
+                helper->setTermStructure(ts);
+            }
+
+            if (!validData || data.size() != times.size()) {
+                // guess the data a pillar at a time, as the iterative
+                // bootstrap does on its first pass
+                data = std::vector<Real>(times.size(),
+                                         Traits::initialValue(ts));
+                for (Size i=1; i<times.size(); ++i) {
+                    Traits::updateGuess(data,
+                                        Traits::guess(i, ts, false,
+                                                      firstAliveHelper),
+                                        i);
+                    interpolation = Linear().interpolate(
+                            times.begin(), times.begin()+i+1, data.begin());
+                    interpolation.update();
+                }
+            }
+
+            interpolation = interpolator.interpolate(
+                                  times.begin(), times.end(), data.begin());
+            interpolation.update();
+        }
+
+    }
+
+
+    template <class Curve>
+    class GlobalBootstrap<Curve>::ErrorFunction {
+      public:
+        explicit ErrorFunction(const GlobalBootstrap* bootstrap)
+        : bootstrap_(bootstrap) {}
+        void operator()(const Array& x, Array& e) const {
+            bootstrap_->setData(x);
+            bootstrap_->errors(e);
+        }
+      private:
+        const GlobalBootstrap* bootstrap_;
+    };
+
+    template <class Curve>
+    class GlobalBootstrap<Curve>::JacobianFunction {
+      public:
+        explicit JacobianFunction(const GlobalBootstrap* bootstrap)
+        : bootstrap_(bootstrap) {}
+        Disposable<Matrix> operator()(const Array& x,
+                                      const Array& e) const {
+            return bootstrap_->computeJacobian(x, e);
+        }
+      private:
+        const GlobalBootstrap* bootstrap_;
+    };
+
+
+    // template definitions
+
+    template <class Curve>
+    GlobalBootstrap<Curve>::GlobalBootstrap()
+    : ts_(0), initialized_(false), validCurve_(false),
+      exactJacobian_(false) {}
+
+    template <class Curve>
+    void GlobalBootstrap<Curve>::setup(Curve* ts) {
+
+        ts_ = ts;
+        n_ = ts_->instruments_.size();
+        QL_REQUIRE(n_ > 0, "no bootstrap helpers given")
+        for (Size j=0; j<n_; ++j)
+            ts_->registerWith(ts_->instruments_[j]);
+
+        // do not initialize yet: instruments could be invalid here
+        // but valid later when bootstrapping is actually required
+    }
+
+    template <class Curve>
+    void GlobalBootstrap<Curve>::initialize() const {
+        firstAliveHelper_ = detail::initializeGlobalBootstrap(
+                                      ts_, ts_->instruments_, ts_->dates_,
+                                      ts_->times_, ts_->maxDate_);
+        alive_ = n_-firstAliveHelper_;
+
+        // the previous solution can only be used as guess if the
+        // number of pillars didn't change; the Jacobian is only an
+        // approximation if the times moved.
+        if (!validCurve_ || ts_->data_.size()!=alive_+1) {
+            validCurve_ = false;
+            Matrix empty;
+            jacobian_.swap(empty);
+        }
+        exactJacobian_ = false;
+        initialized_ = true;
+    }
+
+    template <class Curve>
+    void GlobalBootstrap<Curve>::calculate() const {
+
+        // as in the iterative bootstrap, helpers might be date
+        // relative and change with the evaluation date
+        if (!initialized_ || ts_->moving_)
+            initialize();
+
+        detail::setupGlobalBootstrap(ts_, ts_->instruments_,
+                                     firstAliveHelper_, validCurve_,
+                                     ts_->times_, ts_->data_,
+                                     ts_->interpolation_,
+                                     ts_->interpolator_);
+
+        Array x(alive_), e;
+        for (Size i=0; i<alive_; ++i)
+            x[i] = ts_->data_[i+1];
+
+        detail::broydenSolve(ErrorFunction(this), JacobianFunction(this),
+                             x, e, jacobian_, exactJacobian_,
+                             ts_->accuracy_, Traits::maxIterations(),
+                             "global bootstrap");
+        validCurve_ = true;
+    }
+
+    template <class Curve>
+    void GlobalBootstrap<Curve>::setData(const Array& x) const {
+        std::vector<Real>& data = ts_->data_;
+        for (Size i=0; i<alive_; ++i)
+            Traits::updateGuess(data, x[i], i+1);
+        ts_->interpolation_.update();
+    }
+
+    template <class Curve>
+    void GlobalBootstrap<Curve>::errors(Array& e) const {
+        for (Size i=0; i<alive_; ++i)
+            e[i] = ts_->instruments_[firstAliveHelper_+i]->quoteError();
+    }
+
+    template <class Curve>
+    Disposable<Matrix> GlobalBootstrap<Curve>::computeJacobian(
+                                                 const Array& x,
+                                                 const Array& e) const {
+        Matrix jacobian(alive_, alive_, 0.0);
+        const std::vector<Date>& dates = ts_->dates_;
+        Array xBumped(x), eBumped(alive_);
+        for (Size k=0; k<alive_; ++k) {
+            Real h = 1.0e-6*std::max(std::fabs(x[k]), 0.01);
+            xBumped[k] = x[k] + h;
+            setData(xBumped);
+            for (Size i=0; i<alive_; ++i) {
+                const boost::shared_ptr<typename Traits::helper>& helper =
+                                        ts_->instruments_[firstAliveHelper_+i];
+                // with local interpolators, helpers ending before the
+                // bumped node are not affected
+                if (!Interpolator::global
+                    && helper->latestRelevantDate() <= dates[k])
+                    continue;
+                jacobian[i][k] = (helper->quoteError() - e[i])/h;
+            }
+            xBumped[k] = x[k];
+        }
+        setData(x);
+        return jacobian;
+    }
+
+    template <class Curve>
+    const Matrix& GlobalBootstrap<Curve>::jacobian() const {
+        ts_->calculate();
+        if (!exactJacobian_) {
+            Array x(alive_), e(alive_);
+            for (Size i=0; i<alive_; ++i)
+                x[i] = ts_->data_[i+1];
+            errors(e);
+            jacobian_ = computeJacobian(x, e);
+            exactJacobian_ = true;
+        }
+        return jacobian_;
+    }
+
+    template <class Curve>
+    Disposable<Matrix> GlobalBootstrap<Curve>::quoteSensitivities() const {
+        // the errors are quote minus implied quote
+        Matrix result = inverse(jacobian());
+        result *= -1.0;
+        return result;
+    }
+
+}
+
+#endif
@@ -75,6 +75,7 @@ namespace QuantLib {
         //! \name YoYInflationTermStructure interface
         //@{
         Rate yoyRateImpl(Time t) const;
+        void yoyRatesImpl(const Time* t, Rate* r, Size n) const;
         //@}
         mutable std::vector<Date> dates_;
 
@@ -190,6 +191,12 @@ namespace QuantLib {
         return this->interpolation_(t, true);
     }
 
+    template <class T>
+    inline void InterpolatedYoYInflationCurve<T>::yoyRatesImpl(
+                                   const Time* t, Rate* r, Size n) const {
+        this->interpolation_(t, r, n, true);
+    }
+
     template <class T>
     inline const std::vector<Time>&
     InterpolatedYoYInflationCurve<T>::times() const {
@@ -71,6 +71,7 @@ namespace QuantLib {
         //! \name ZeroInflationTermStructure Interface
         //@{
         Rate zeroRateImpl(Time t) const;
+        void zeroRatesImpl(const Time* t, Rate* r, Size n) const;
         //@}
         mutable std::vector<Date> dates_;
 
@@ -203,6 +204,12 @@ namespace QuantLib {
         return this->interpolation_(t, true);
     }
 
+    template <class T>
+    inline void InterpolatedZeroInflationCurve<T>::zeroRatesImpl(
+                                   const Time* t, Rate* r, Size n) const {
+        this->interpolation_(t, r, n, true);
+    }
+
     template <class T>
     inline const std::vector<Time>&
     InterpolatedZeroInflationCurve<T>::times() const {
@@ -152,6 +152,7 @@ namespace QuantLib {
 
     template <class I, template <class> class B, class T>
     void PiecewiseYoYInflationCurve<I,B,T>::update() {
+        detail::notifyBootstrap(bootstrap_);
         base_curve::update();
         LazyObject::update();
     }
@@ -150,6 +150,7 @@ namespace QuantLib {
 
     template <class I, template<class> class B, class T>
     void PiecewiseZeroInflationCurve<I,B,T>::update() {
+        detail::notifyBootstrap(bootstrap_);
         base_curve::update();
         LazyObject::update();
     }
@@ -194,6 +194,22 @@ namespace QuantLib {
         return zeroRateImpl(t);
     }
 
+    void ZeroInflationTermStructure::zeroRate(const Time* t,
+                                              Rate* r,
+                                              Size n,
+                                              bool extrapolate) const {
+        for (Size i=0; i<n; ++i)
+            checkRange(t[i], extrapolate);
+        zeroRatesImpl(t, r, n);
+    }
+
+    void ZeroInflationTermStructure::zeroRatesImpl(const Time* t,
+                                                   Rate* r,
+                                                   Size n) const {
+        for (Size i=0; i<n; ++i)
+            r[i] = zeroRateImpl(t[i]);
+    }
+
     YoYInflationTermStructure::YoYInflationTermStructure(
                                     const DayCounter& dayCounter,
                                     Rate baseYoYRate,
@@ -281,6 +297,22 @@ namespace QuantLib {
         return yoyRateImpl(t);
     }
 
+    void YoYInflationTermStructure::yoyRate(const Time* t,
+                                            Rate* r,
+                                            Size n,
+                                            bool extrapolate) const {
+        for (Size i=0; i<n; ++i)
+            checkRange(t[i], extrapolate);
+        yoyRatesImpl(t, r, n);
+    }
+
+    void YoYInflationTermStructure::yoyRatesImpl(const Time* t,
+                                                 Rate* r,
+                                                 Size n) const {
+        for (Size i=0; i<n; ++i)
+            r[i] = yoyRateImpl(t[i]);
+    }
+
 
 
 
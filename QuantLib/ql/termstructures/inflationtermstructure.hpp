@@ -181,10 +181,23 @@ namespace QuantLib {
         */
         Rate zeroRate(Time t,
                       bool extrapolate = false) const;
+        /*! Writes the zero-coupon inflation rates at the n given
+            times; the same warning as for the single-time method
+            applies.  Interpolated curves retrieve the rates faster
+            when the times are sorted.
+        */
+        void zeroRate(const Time* t,
+                      Rate* r,
+                      Size n,
+                      bool extrapolate = false) const;
         //@}
       protected:
         //! to be defined in derived classes
         virtual Rate zeroRateImpl(Time t) const = 0;
+        /*! rates at n given times; the default implementation calls
+            zeroRateImpl(Time) for each of them.
+        */
+        virtual void zeroRatesImpl(const Time* t, Rate* r, Size n) const;
     };
 
 
@@ -242,10 +255,23 @@ namespace QuantLib {
         */
         Rate yoyRate(Time t,
                      bool extrapolate = false) const;
+        /*! Writes the year-on-year inflation rates at the n given
+            times; the same warning as for the single-time method
+            applies.  Interpolated curves retrieve the rates faster
+            when the times are sorted.
+        */
+        void yoyRate(const Time* t,
+                     Rate* r,
+                     Size n,
+                     bool extrapolate = false) const;
         //@}
       protected:
         //! to be defined in derived classes
         virtual Rate yoyRateImpl(Time time) const = 0;
+        /*! rates at n given times; the default implementation calls
+            yoyRateImpl(Time) for each of them.
+        */
+        virtual void yoyRatesImpl(const Time* t, Rate* r, Size n) const;
     };
 
 
@@ -37,6 +37,15 @@
 namespace QuantLib {
 
     //! Universal piecewise-term-structure boostrapper.
+    /*! The bootstrapper keeps track of the helpers that changed since
+        the last calculation.  With local interpolators, the pillars
+        before the first one depending on a changed helper cannot
+        move; they are kept and the bootstrap is restarted from that
+        pillar.  Global interpolators always require a full solve, as
+        do changes notified by anything else than the helpers (e.g.,
+        jumps or the evaluation date for moving curves) and explicit
+        recalculations.
+    */
     template <class Curve>
     class IterativeBootstrap {
         typedef typename Curve::traits_type Traits;
@@ -45,16 +54,20 @@ namespace QuantLib {
         IterativeBootstrap();
         void setup(Curve* ts);
         void calculate() const;
+        //! called by the curve when it is notified of a change
+        void update();
       private:
         void initialize() const;
         Curve* ts_;
         Size n_;
         Brent firstSolver_;
         FiniteDifferenceNewtonSafe solver_;
-        mutable bool initialized_, validCurve_, loopRequired_;
+        mutable bool initialized_, validCurve_, loopRequired_, fullSolve_;
         mutable Size firstAliveHelper_, alive_;
         mutable std::vector<Real> previousData_;
         mutable std::vector<boost::shared_ptr<BootstrapError<Curve> > > errors_;
+        mutable std::vector<boost::shared_ptr<detail::BootstrapHelperFlag> >
+                                                                    changed_;
     };
 
 
@@ -63,7 +76,7 @@ namespace QuantLib {
     template <class Curve>
     IterativeBootstrap<Curve>::IterativeBootstrap()
         : ts_(0), initialized_(false), validCurve_(false), 
-          loopRequired_(Interpolator::global) {}
+          loopRequired_(Interpolator::global), fullSolve_(true) {}
 
     template <class Curve>
     void IterativeBootstrap<Curve>::setup(Curve* ts) {
@@ -71,8 +84,16 @@ namespace QuantLib {
         ts_ = ts;
         n_ = ts_->instruments_.size();
         QL_REQUIRE(n_ > 0, "no bootstrap helpers given")
-        for (Size j=0; j<n_; ++j)
-            ts_->registerWith(ts_->instruments_[j]);
+
+        // the curve observes the helpers through flags tracking their
+        // changes; the flags are raised at creation, so that all
+        // pillars are bootstrapped
+        changed_.resize(n_);
+        for (Size j=0; j<n_; ++j) {
+            changed_[j] = boost::shared_ptr<detail::BootstrapHelperFlag>(
+                new detail::BootstrapHelperFlag(ts_->instruments_[j]));
+            ts_->registerWith(changed_[j]);
+        }
 
         // do not initialize yet: instruments could be invalid here
         // but valid later when bootstrapping is actually required
@@ -96,6 +117,16 @@ namespace QuantLib {
                    " provided, " << Interpolator::requiredPoints-1 <<
                    " required");
 
+        // keep the flags in the order of the helpers
+        for (Size j=0; j<n_; ++j) {
+            if (changed_[j]->helper() != ts_->instruments_[j].get()) {
+                Size k = j+1;
+                while (changed_[k]->helper() != ts_->instruments_[j].get())
+                    ++k;
+                std::swap(changed_[j], changed_[k]);
+            }
+        }
+
         // calculate dates and times, create errors_
         std::vector<Date>& dates = ts_->dates_;
         std::vector<Time>& times = ts_->times_;
@@ -179,6 +210,26 @@ namespace QuantLib {
         const std::vector<Real>& data = ts_->data_;
         Real accuracy = ts_->accuracy_;
 
+        // with local interpolators, a valid curve only needs to be
+        // bootstrapped again from the first pillar affected by the
+        // changed helpers
+        Size firstPillar = 1;
+        if (validCurve_ && !fullSolve_ && !Interpolator::global) {
+            // if no helper changed, the calculation was requested
+            // explicitly and all pillars are bootstrapped again
+            for (Size i=1, j=firstAliveHelper_; j<n_; ++i, ++j) {
+                if (changed_[j]->isUp()) {
+                    firstPillar = i;
+                    break;
+                }
+            }
+            // helpers reaching beyond their pillar depend on the next one
+            while (firstPillar>1 && firstPillar<=alive_ &&
+                   errors_[firstPillar-1]->helper()->latestRelevantDate()
+                                                 > ts_->dates_[firstPillar-1])
+                --firstPillar;
+        }
+
         Size maxIterations = Traits::maxIterations()-1;
 
         // there might be a valid curve state to use as guess
@@ -187,7 +238,7 @@ namespace QuantLib {
         for (Size iteration=0; ; ++iteration) {
             previousData_ = ts_->data_;
 
-            for (Size i=1; i<=alive_; ++i) { // pillar loop
+            for (Size i=firstPillar; i<=alive_; ++i) { // pillar loop
 
                 // bracket root and calculate guess
                 Real min = Traits::minValueAfter(i, ts_, validData,
@@ -258,9 +309,34 @@ namespace QuantLib {
 
             validData = true;
         }
+
+        // the flags are only lowered after a successful calculation,
+        // so that a failed one is attempted again from the same pillar
+        for (Size j=0; j<n_; ++j)
+            changed_[j]->lower();
+        fullSolve_ = false;
         validCurve_ = true;
     }
 
+    template <class Curve>
+    void IterativeBootstrap<Curve>::update() {
+        // notifications forwarded by the flags were already recorded
+        for (Size j=0; j<changed_.size(); ++j) {
+            if (changed_[j]->isNotifying())
+                return;
+        }
+        fullSolve_ = true;
+    }
+
+    namespace detail {
+
+        template <class Curve>
+        inline void notifyBootstrap(IterativeBootstrap<Curve>& bootstrap) {
+            bootstrap.update();
+        }
+
+    }
+
 }
 
 #endif
@@ -0,0 +1,166 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file jointbootstrap.hpp
+    \brief bootstrapper taking part in a multi-curve bootstrap
+*/
+
+#ifndef quantlib_joint_bootstrap_hpp
+#define quantlib_joint_bootstrap_hpp
+
+#include <ql/termstructures/multicurvebootstrap.hpp>
+#include <ql/termstructures/globalbootstrap.hpp>
+
+namespace QuantLib {
+
+    //! Bootstrapper for piecewise curves solved together with others
+    /*! The curve is bootstrapped together with the other curves
+        passed the same MultiCurveBootstrap instance; see the
+        documentation of the latter for details.  The accuracy of the
+        curve is ignored in favor of the one of the multi-curve
+        bootstrap.
+
+        \warning The multi-curve bootstrap keeps a pointer to the
+                 curve, which is removed when the curve is destroyed.
+                 Copies of the curve don't take part in the bootstrap.
+    */
+    template <class Curve>
+    class JointBootstrap : public MultiCurveBootstrapContributor {
+        // the traits and interpolator of the curve are only used in
+        // the member functions, so that the bootstrapper can be
+        // instantiated before the curve.
+      public:
+        explicit JointBootstrap(
+                  const boost::shared_ptr<MultiCurveBootstrap>& multiCurve);
+        JointBootstrap(const JointBootstrap&);
+        ~JointBootstrap();
+        void setup(Curve* ts);
+        void calculate() const;
+        //! \name MultiCurveBootstrapContributor interface
+        //@{
+        Size initialize(bool validData) const;
+        void data(Array::iterator x) const;
+        void setData(Array::const_iterator x) const;
+        void errors(Array::iterator e) const;
+        void invalidate() const;
+        //@}
+      private:
+        JointBootstrap& operator=(const JointBootstrap&);
+        boost::shared_ptr<MultiCurveBootstrap> multiCurve_;
+        Curve* ts_;
+        Size n_;
+        mutable bool initialized_;
+        mutable Size firstAliveHelper_, alive_;
+    };
+
+
+    // template definitions
+
+    template <class Curve>
+    JointBootstrap<Curve>::JointBootstrap(
+                   const boost::shared_ptr<MultiCurveBootstrap>& multiCurve)
+    : multiCurve_(multiCurve), ts_(0), n_(0), initialized_(false) {
+        QL_REQUIRE(multiCurve_, "no multi-curve bootstrap given");
+    }
+
+    template <class Curve>
+    JointBootstrap<Curve>::JointBootstrap(const JointBootstrap& other)
+    : MultiCurveBootstrapContributor(), multiCurve_(other.multiCurve_),
+      ts_(0), n_(0), initialized_(false) {}
+
+    template <class Curve>
+    JointBootstrap<Curve>::~JointBootstrap() {
+        if (ts_)
+            multiCurve_->remove(this);
+    }
+
+    template <class Curve>
+    void JointBootstrap<Curve>::setup(Curve* ts) {
+
+        ts_ = ts;
+        n_ = ts_->instruments_.size();
+        QL_REQUIRE(n_ > 0, "no bootstrap helpers given");
+        for (Size j=0; j<n_; ++j) {
+            ts_->registerWith(ts_->instruments_[j]);
+            // changes to any curve require a new multi-curve bootstrap
+            multiCurve_->registerWith(ts_->instruments_[j]);
+        }
+        if (ts_->moving_)
+            multiCurve_->registerWith(Settings::instance().evaluationDate());
+        ts_->registerWith(multiCurve_);
+        multiCurve_->add(this);
+
+        // do not initialize yet: instruments could be invalid here
+        // but valid later when bootstrapping is actually required
+    }
+
+    template <class Curve>
+    void JointBootstrap<Curve>::calculate() const {
+        multiCurve_->bootstrap();
+    }
+
+    template <class Curve>
+    Size JointBootstrap<Curve>::initialize(bool validData) const {
+        if (!initialized_ || ts_->moving_) {
+            firstAliveHelper_ = detail::initializeGlobalBootstrap(
+                                      ts_, ts_->instruments_, ts_->dates_,
+                                      ts_->times_, ts_->maxDate_);
+            alive_ = n_-firstAliveHelper_;
+            initialized_ = true;
+        }
+
+        detail::setupGlobalBootstrap(ts_, ts_->instruments_,
+                                     firstAliveHelper_, validData,
+                                     ts_->times_, ts_->data_,
+                                     ts_->interpolation_,
+                                     ts_->interpolator_);
+
+        // the curve is flagged as calculated, so that its evaluation
+        // by the helpers of other curves doesn't trigger a nested
+        // bootstrap; its data are set by the multi-curve bootstrap.
+        ts_->calculate();
+
+        return alive_;
+    }
+
+    template <class Curve>
+    void JointBootstrap<Curve>::data(Array::iterator x) const {
+        std::copy(ts_->data_.begin()+1, ts_->data_.end(), x);
+    }
+
+    template <class Curve>
+    void JointBootstrap<Curve>::setData(Array::const_iterator x) const {
+        typedef typename Curve::traits_type Traits;
+        for (Size i=1; i<=alive_; ++i, ++x)
+            Traits::updateGuess(ts_->data_, *x, i);
+        ts_->interpolation_.update();
+    }
+
+    template <class Curve>
+    void JointBootstrap<Curve>::errors(Array::iterator e) const {
+        for (Size j=firstAliveHelper_; j<n_; ++j, ++e)
+            *e = ts_->instruments_[j]->quoteError();
+    }
+
+    template <class Curve>
+    void JointBootstrap<Curve>::invalidate() const {
+        ts_->update();
+    }
+
+}
+
+#endif
@@ -0,0 +1,347 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/termstructures/multicurvebootstrap.hpp>
+#include <ql/math/broydensolver.hpp>
+#include <ql/utilities/null.hpp>
+#include <algorithm>
+#include <string>
+
+namespace QuantLib {
+
+    namespace {
+
+        /* Tarjan's algorithm for the strongly connected components
+           of the dependency graph; each component is found after
+           the ones it depends upon. */
+        class ComponentFinder {
+          public:
+            explicit ComponentFinder(
+                           const std::vector<std::vector<bool> >& depends)
+            : depends_(depends), index_(depends.size(), Null<Size>()),
+              low_(depends.size()), onStack_(depends.size(), false),
+              counter_(0) {
+                for (Size i=0; i<depends_.size(); ++i)
+                    if (index_[i] == Null<Size>())
+                        visit(i);
+            }
+            const std::vector<std::vector<Size> >& components() const {
+                return components_;
+            }
+          private:
+            void visit(Size v) {
+                index_[v] = low_[v] = counter_++;
+                stack_.push_back(v);
+                onStack_[v] = true;
+                for (Size w=0; w<depends_.size(); ++w) {
+                    if (w == v || !depends_[v][w])
+                        continue;
+                    if (index_[w] == Null<Size>()) {
+                        visit(w);
+                        low_[v] = std::min(low_[v], low_[w]);
+                    } else if (onStack_[w]) {
+                        low_[v] = std::min(low_[v], index_[w]);
+                    }
+                }
+                if (low_[v] == index_[v]) {
+                    std::vector<Size> component;
+                    Size w;
+                    do {
+                        w = stack_.back();
+                        stack_.pop_back();
+                        onStack_[w] = false;
+                        component.push_back(w);
+                    } while (w != v);
+                    std::sort(component.begin(), component.end());
+                    components_.push_back(component);
+                }
+            }
+            const std::vector<std::vector<bool> >& depends_;
+            std::vector<Size> index_, low_, stack_;
+            std::vector<bool> onStack_;
+            Size counter_;
+            std::vector<std::vector<Size> > components_;
+        };
+
+    }
+
+
+    MultiCurveBootstrap::MultiCurveBootstrap(Real accuracy,
+                                             Size maxIterations,
+                                             Size threads)
+    : accuracy_(accuracy), maxIterations_(maxIterations),
+      threads_(threads), validData_(false) {
+        QL_REQUIRE(accuracy > 0.0, "non-positive accuracy given");
+        QL_REQUIRE(maxIterations > 0, "null number of iterations given");
+        QL_REQUIRE(threads > 0, "at least one thread required");
+    }
+
+    void MultiCurveBootstrap::add(MultiCurveBootstrapContributor* curve) {
+        QL_REQUIRE(curve, "null curve given");
+        curves_.push_back(curve);
+        sizes_.clear();
+        update();
+    }
+
+    void MultiCurveBootstrap::remove(MultiCurveBootstrapContributor* curve) {
+        // no notification: the remaining curves are not affected
+        std::vector<MultiCurveBootstrapContributor*>::iterator i =
+            std::find(curves_.begin(), curves_.end(), curve);
+        if (i != curves_.end()) {
+            curves_.erase(i);
+            sizes_.clear();
+        }
+    }
+
+    void MultiCurveBootstrap::bootstrap() const {
+        calculate();
+    }
+
+    std::vector<std::vector<Size> > MultiCurveBootstrap::components() const {
+        calculate();
+        std::vector<std::vector<Size> > result(components_.size());
+        for (Size i=0; i<components_.size(); ++i)
+            result[i] = components_[i].curves;
+        return result;
+    }
+
+    void MultiCurveBootstrap::performCalculations() const {
+        QL_REQUIRE(!curves_.empty(), "no curves given");
+
+        // a failed bootstrap leaves no valid guess behind
+        bool validData = validData_;
+        validData_ = false;
+
+        try {
+            solveAll(validData);
+        } catch (...) {
+            // the curves were flagged as calculated when initialized
+            for (Size i=0; i<curves_.size(); ++i)
+                curves_[i]->invalidate();
+            throw;
+        }
+
+        validData_ = true;
+    }
+
+    void MultiCurveBootstrap::solveAll(bool validData) const {
+        std::vector<Size> sizes(curves_.size());
+        for (Size i=0; i<curves_.size(); ++i)
+            sizes[i] = curves_[i]->initialize(validData);
+        if (sizes != sizes_) {
+            sizes_ = sizes;
+            analyze();
+        }
+
+        Size begin = 0;
+        while (begin < components_.size()) {
+            Size end = begin;
+            while (end < components_.size() &&
+                   components_[end].level == components_[begin].level)
+                ++end;
+
+            // components at the same level don't depend on one another
+            std::vector<std::string> errors(end-begin);
+            #pragma omp parallel for schedule(dynamic) num_threads(threads_)
+            for (Size i=begin; i<end; ++i) {
+                try {
+                    solve(components_[i]);
+                } catch (std::exception& e) {
+                    errors[i-begin] = e.what();
+                } catch (...) {
+                    errors[i-begin] = "unknown error";
+                }
+            }
+            for (Size i=0; i<errors.size(); ++i)
+                QL_REQUIRE(errors[i].empty(), errors[i]);
+
+            begin = end;
+        }
+    }
+
+    void MultiCurveBootstrap::analyze() const {
+        const Size n = curves_.size();
+        std::vector<Size> offsets(n+1, 0);
+        for (Size i=0; i<n; ++i)
+            offsets[i+1] = offsets[i] + sizes_[i];
+        const Size size = offsets[n];
+
+        Array x(size), e(size), eBumped(size);
+        for (Size i=0; i<n; ++i) {
+            curves_[i]->data(x.begin()+offsets[i]);
+            curves_[i]->errors(e.begin()+offsets[i]);
+        }
+
+        // Jacobian of all the errors with respect to all the data;
+        // its non-null blocks give the dependencies between curves
+        Matrix jacobian(size, size, 0.0);
+        depends_ = std::vector<std::vector<bool> >(
+                                           n, std::vector<bool>(n, false));
+        for (Size c=0; c<n; ++c) {
+            for (Size m=offsets[c]; m<offsets[c+1]; ++m) {
+                Real value = x[m];
+                Real h = 1.0e-6*std::max(std::fabs(value), 0.01);
+                x[m] = value + h;
+                curves_[c]->setData(x.begin()+offsets[c]);
+                for (Size b=0; b<n; ++b) {
+                    curves_[b]->errors(eBumped.begin()+offsets[b]);
+                    for (Size i=offsets[b]; i<offsets[b+1]; ++i) {
+                        jacobian[i][m] = (eBumped[i]-e[i])/h;
+                        if (jacobian[i][m] != 0.0)
+                            depends_[b][c] = true;
+                    }
+                }
+                x[m] = value;
+            }
+            curves_[c]->setData(x.begin()+offsets[c]);
+            depends_[c][c] = true;
+        }
+
+        ComponentFinder finder(depends_);
+        const std::vector<std::vector<Size> >& found = finder.components();
+        std::vector<Size> componentOf(n);
+        components_.resize(found.size());
+        for (Size k=0; k<found.size(); ++k) {
+            Component& component = components_[k];
+            component.curves = found[k];
+            component.offsets.resize(found[k].size());
+            component.size = 0;
+            component.level = 0;
+            for (Size p=0; p<found[k].size(); ++p) {
+                Size c = found[k][p];
+                componentOf[c] = k;
+                component.offsets[p] = component.size;
+                component.size += sizes_[c];
+                // the components depended upon were found before
+                for (Size d=0; d<n; ++d) {
+                    if (depends_[c][d]
+                        && std::find(found[k].begin(), found[k].end(), d)
+                                                        == found[k].end())
+                        component.level =
+                            std::max(component.level,
+                                     components_[componentOf[d]].level+1);
+                }
+            }
+
+            component.jacobian = Matrix(component.size, component.size);
+            for (Size p=0; p<found[k].size(); ++p) {
+                for (Size q=0; q<found[k].size(); ++q) {
+                    Size b = found[k][p], c = found[k][q];
+                    for (Size i=0; i<sizes_[b]; ++i)
+                        for (Size j=0; j<sizes_[c]; ++j)
+                            component.jacobian[component.offsets[p]+i]
+                                              [component.offsets[q]+j] =
+                                jacobian[offsets[b]+i][offsets[c]+j];
+                }
+            }
+            component.exactJacobian = true;
+        }
+
+        // the components are solved by level
+        std::vector<Component> sorted;
+        sorted.reserve(components_.size());
+        for (Size level=0; sorted.size()<components_.size(); ++level)
+            for (Size k=0; k<components_.size(); ++k)
+                if (components_[k].level == level)
+                    sorted.push_back(components_[k]);
+        components_.swap(sorted);
+    }
+
+    class MultiCurveBootstrap::ErrorFunction {
+      public:
+        ErrorFunction(const MultiCurveBootstrap* bootstrap,
+                      const Component& component)
+        : bootstrap_(bootstrap), component_(component) {}
+        void operator()(const Array& x, Array& e) const {
+            bootstrap_->setData(component_, x);
+            bootstrap_->errors(component_, e);
+        }
+      private:
+        const MultiCurveBootstrap* bootstrap_;
+        const Component& component_;
+    };
+
+    class MultiCurveBootstrap::JacobianFunction {
+      public:
+        JacobianFunction(const MultiCurveBootstrap* bootstrap,
+                         const Component& component)
+        : bootstrap_(bootstrap), component_(component) {}
+        Disposable<Matrix> operator()(const Array& x,
+                                      const Array& e) const {
+            // the curves might have been left at a rejected step
+            bootstrap_->setData(component_, x);
+            return bootstrap_->computeJacobian(component_, x, e);
+        }
+      private:
+        const MultiCurveBootstrap* bootstrap_;
+        const Component& component_;
+    };
+
+    void MultiCurveBootstrap::solve(Component& c) const {
+        Array x(c.size), e;
+        for (Size p=0; p<c.curves.size(); ++p)
+            curves_[c.curves[p]]->data(x.begin()+c.offsets[p]);
+
+        detail::broydenSolve(ErrorFunction(this, c),
+                             JacobianFunction(this, c),
+                             x, e, c.jacobian, c.exactJacobian,
+                             accuracy_, maxIterations_,
+                             "multi-curve bootstrap");
+    }
+
+    void MultiCurveBootstrap::setData(const Component& c,
+                                      const Array& x) const {
+        for (Size p=0; p<c.curves.size(); ++p)
+            curves_[c.curves[p]]->setData(x.begin()+c.offsets[p]);
+    }
+
+    void MultiCurveBootstrap::errors(const Component& c, Array& e) const {
+        for (Size p=0; p<c.curves.size(); ++p)
+            curves_[c.curves[p]]->errors(e.begin()+c.offsets[p]);
+    }
+
+    Disposable<Matrix> MultiCurveBootstrap::computeJacobian(
+                                              const Component& c,
+                                              const Array& x,
+                                              const Array& e) const {
+        Matrix jacobian(c.size, c.size, 0.0);
+        Array xBumped(x), eBumped(c.size);
+        for (Size q=0; q<c.curves.size(); ++q) {
+            MultiCurveBootstrapContributor* bumped = curves_[c.curves[q]];
+            Size begin = c.offsets[q], end = begin + sizes_[c.curves[q]];
+            for (Size m=begin; m<end; ++m) {
+                Real h = 1.0e-6*std::max(std::fabs(x[m]), 0.01);
+                xBumped[m] = x[m] + h;
+                bumped->setData(xBumped.begin()+begin);
+                // only the blocks of dependent curves are not null
+                for (Size p=0; p<c.curves.size(); ++p) {
+                    if (!depends_[c.curves[p]][c.curves[q]])
+                        continue;
+                    curves_[c.curves[p]]->errors(eBumped.begin()
+                                                 + c.offsets[p]);
+                    Size rows = sizes_[c.curves[p]];
+                    for (Size i=c.offsets[p]; i<c.offsets[p]+rows; ++i)
+                        jacobian[i][m] = (eBumped[i]-e[i])/h;
+                }
+                xBumped[m] = x[m];
+            }
+            bumped->setData(x.begin()+begin);
+        }
+        return jacobian;
+    }
+
+}
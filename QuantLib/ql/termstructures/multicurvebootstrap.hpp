@@ -0,0 +1,149 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file multicurvebootstrap.hpp
+    \brief simultaneous bootstrap of a set of dependent curves
+*/
+
+#ifndef quantlib_multi_curve_bootstrap_hpp
+#define quantlib_multi_curve_bootstrap_hpp
+
+#include <ql/patterns/lazyobject.hpp>
+#include <ql/math/matrix.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    //! curve taking part in a MultiCurveBootstrap
+    /*! This interface is implemented by the JointBootstrap class,
+        which exposes a piecewise curve to the multi-curve bootstrap.
+    */
+    class MultiCurveBootstrapContributor {
+      public:
+        virtual ~MultiCurveBootstrapContributor() {}
+        /*! prepares the curve and its helpers for the bootstrap and
+            returns the number of curve data to be solved for.  Unless
+            the previous data can be used as a guess, they are set to
+            an initial one.
+        */
+        virtual Size initialize(bool validData) const = 0;
+        //! writes the curve data being solved for
+        virtual void data(Array::iterator x) const = 0;
+        //! sets the curve data being solved for
+        virtual void setData(Array::const_iterator x) const = 0;
+        //! writes the quote errors of the alive helpers
+        virtual void errors(Array::iterator e) const = 0;
+        /*! marks the curve as not calculated; called when the
+            bootstrap fails, so that the curve doesn't keep data
+            which were not solved for.
+        */
+        virtual void invalidate() const = 0;
+    };
+
+
+    //! Simultaneous bootstrap of a set of dependent curves
+    /*! The curves to be bootstrapped together (e.g., an OIS discount
+        curve and the projection curves whose helpers discount on it)
+        are built as piecewise curves using the JointBootstrap class,
+        each one passed a pointer to the same instance of this class.
+        Bootstrapping any of them bootstraps them all.
+
+        The quote errors of all the helpers are driven to zero by
+        Newton steps on the data of all the curves.  At the first
+        bootstrap, the Jacobian of the errors is estimated by finite
+        differences; its blocks, i.e., the derivatives of the errors
+        of the helpers of a curve with respect to the data of
+        another, tell which curves depend upon which.  The curves are
+        then split into groups that must be solved together (e.g.,
+        the curves linked by basis instruments) and the groups are
+        solved in dependency order, each with its own Jacobian
+        maintained by Broyden updates.  No outer fixed-point loop is
+        needed for dependent curves.  Groups which are independent of
+        one another are solved concurrently when the library is
+        compiled with OpenMP support and more than one thread is
+        requested.
+
+        The dependencies are detected again when curves are added or
+        removed, or when the number of alive helpers changes.
+
+        \warning Independent groups of curves are solved in parallel
+                 when more than one thread is requested.  This is
+                 only safe if the evaluation of their helpers doesn't
+                 modify shared state.  If in doubt, use a single
+                 thread.
+
+        \test the consistency of the curves with the quotes of their
+              helpers is checked for a set of curves with both one-way
+              and mutual dependencies.
+    */
+    class MultiCurveBootstrap : public LazyObject {
+      public:
+        MultiCurveBootstrap(Real accuracy = 1.0e-12,
+                            Size maxIterations = 100,
+                            Size threads = 1);
+        //! \name Curve registration
+        //@{
+        /*! called by the contributing curves; not meant to be used
+            by client code.
+        */
+        void add(MultiCurveBootstrapContributor*);
+        void remove(MultiCurveBootstrapContributor*);
+        //@}
+        //! bootstraps all the curves, if needed
+        void bootstrap() const;
+        //! \name Inspectors
+        //@{
+        /*! the groups of curves solved together, in the order in
+            which they are solved.  Curves are identified by the
+            order in which they were added, i.e., in which they were
+            built.
+        */
+        std::vector<std::vector<Size> > components() const;
+        //@}
+      private:
+        struct Component {
+            std::vector<Size> curves, offsets;
+            Size size, level;
+            Matrix jacobian;
+            bool exactJacobian;
+        };
+        class ErrorFunction;
+        class JacobianFunction;
+        friend class ErrorFunction;
+        friend class JacobianFunction;
+        void performCalculations() const;
+        void solveAll(bool validData) const;
+        void analyze() const;
+        void solve(Component&) const;
+        void setData(const Component&, const Array& x) const;
+        void errors(const Component&, Array& e) const;
+        Disposable<Matrix> computeJacobian(const Component&,
+                                           const Array& x,
+                                           const Array& e) const;
+        Real accuracy_;
+        Size maxIterations_, threads_;
+        std::vector<MultiCurveBootstrapContributor*> curves_;
+        mutable std::vector<Size> sizes_;
+        mutable std::vector<std::vector<bool> > depends_;
+        mutable std::vector<Component> components_;
+        mutable bool validData_;
+    };
+
+}
+
+
+#endif
@@ -97,6 +97,10 @@ namespace QuantLib {
         Rate forwardImpl(Time t) const;
         Rate zeroYieldImpl(Time t) const;
         //@}
+        //! \name YieldTermStructure implementation
+        //@{
+        void discountsImpl(const Time* t, DiscountFactor* df, Size n) const;
+        //@}
         mutable std::vector<Date> dates_;
       private:
         void initialize();
@@ -179,6 +183,24 @@ namespace QuantLib {
         return integral/t;
     }
 
+    template <class T>
+    void InterpolatedForwardCurve<T>::discountsImpl(const Time* t,
+                                                    DiscountFactor* df,
+                                                    Size n) const {
+        // integrals of the forwards first, then discounts
+        this->interpolation_.primitive(t, df, n, true);
+
+        Time tMax = this->times_.back();
+        for (Size i=0; i<n; ++i) {
+            if (t[i] == 0.0 || t[i] > tMax) {
+                df[i] = discountImpl(t[i]);
+            } else {
+                Rate r = df[i]/t[i];
+                df[i] = DiscountFactor(std::exp(-r*t[i]));
+            }
+        }
+    }
+
     template <class T>
     InterpolatedForwardCurve<T>::InterpolatedForwardCurve(
                                     const DayCounter& dayCounter,
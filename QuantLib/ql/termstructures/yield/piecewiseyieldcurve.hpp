@@ -53,6 +53,8 @@ namespace QuantLib {
         - the correctness of the returned values is tested by
           checking them against the original inputs.
         - the observability of the term structure is tested.
+        - the batched discount factors are checked against the
+          single ones.
     */
     template <class Traits, class Interpolator,
               template <class> class Bootstrap = IterativeBootstrap>
@@ -167,6 +169,11 @@ namespace QuantLib {
         const std::vector<Real>& data() const;
         std::vector<std::pair<Date, Real> > nodes() const;
         //@}
+        //! \name Inspectors
+        //@{
+        //! the bootstrapper, after the curve was bootstrapped
+        const Bootstrap<this_curve>& bootstrap() const;
+        //@}
         //! \name Observer interface
         //@{
         void update();
@@ -178,6 +185,7 @@ namespace QuantLib {
         //@}
         // methods
         DiscountFactor discountImpl(Time) const;
+        void discountsImpl(const Time* t, DiscountFactor* df, Size n) const;
         // data members
         std::vector<boost::shared_ptr<typename Traits::helper> > instruments_;
         Real accuracy_;
@@ -226,9 +234,18 @@ namespace QuantLib {
         return base_curve::nodes();
     }
 
+    template <class C, class I, template <class> class B>
+    inline const B<PiecewiseYieldCurve<C,I,B> >&
+    PiecewiseYieldCurve<C,I,B>::bootstrap() const {
+        calculate();
+        return bootstrap_;
+    }
+
     template <class C, class I, template <class> class B>
     inline void PiecewiseYieldCurve<C,I,B>::update() {
 
+        detail::notifyBootstrap(bootstrap_);
+
         // it dispatches notifications only if (!calculated_ && !frozen_)
         LazyObject::update();
 
@@ -247,6 +264,14 @@ namespace QuantLib {
         return base_curve::discountImpl(t);
     }
 
+    template <class C, class I, template <class> class B>
+    inline void PiecewiseYieldCurve<C,I,B>::discountsImpl(const Time* t,
+                                                          DiscountFactor* df,
+                                                          Size n) const {
+        calculate();
+        base_curve::discountsImpl(t, df, n);
+    }
+
     template <class C, class I, template <class> class B>
     inline void PiecewiseYieldCurve<C,I,B>::performCalculations() const {
         // just delegate to the bootstrapper
@@ -104,6 +104,10 @@ namespace QuantLib {
         //@{
         Rate zeroYieldImpl(Time t) const;
         //@}
+        //! \name YieldTermStructure implementation
+        //@{
+        void discountsImpl(const Time* t, DiscountFactor* df, Size n) const;
+        //@}
         mutable std::vector<Date> dates_;
       private:
         void initialize(const Compounding& compounding, const Frequency& frequency);
@@ -170,6 +174,22 @@ namespace QuantLib {
         return (zMax * tMax + instFwdMax * (t-tMax)) / t;
     }
 
+    template <class T>
+    void InterpolatedZeroCurve<T>::discountsImpl(const Time* t,
+                                                 DiscountFactor* df,
+                                                 Size n) const {
+        // zero yields first, then discounts
+        this->interpolation_(t, df, n, true);
+
+        Time tMax = this->times_.back();
+        for (Size i=0; i<n; ++i) {
+            if (t[i] == 0.0 || t[i] > tMax)
+                df[i] = discountImpl(t[i]);
+            else
+                df[i] = DiscountFactor(std::exp(-df[i]*t[i]));
+        }
+    }
+
     template <class T>
     InterpolatedZeroCurve<T>::InterpolatedZeroCurve(
                                     const DayCounter& dayCounter,
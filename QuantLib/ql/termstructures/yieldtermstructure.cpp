@@ -93,6 +93,32 @@ namespace QuantLib {
         if (jumps_.empty())
             return discountImpl(t);
 
+        return jumpEffect(t) * discountImpl(t);
+    }
+
+    void YieldTermStructure::discount(const Time* t,
+                                      DiscountFactor* df,
+                                      Size n,
+                                      bool extrapolate) const {
+        for (Size i=0; i<n; ++i)
+            checkRange(t[i], extrapolate);
+
+        discountsImpl(t, df, n);
+
+        if (!jumps_.empty()) {
+            for (Size i=0; i<n; ++i)
+                df[i] *= jumpEffect(t[i]);
+        }
+    }
+
+    void YieldTermStructure::discountsImpl(const Time* t,
+                                           DiscountFactor* df,
+                                           Size n) const {
+        for (Size i=0; i<n; ++i)
+            df[i] = discountImpl(t[i]);
+    }
+
+    DiscountFactor YieldTermStructure::jumpEffect(Time t) const {
         DiscountFactor jumpEffect = 1.0;
         for (Size i=0; i<nJumps_; ++i) {
             if (jumpTimes_[i]>0 && jumpTimes_[i]<t) {
@@ -105,8 +131,7 @@ namespace QuantLib {
                 jumpEffect *= thisJump;
             }
         }
-        return jumpEffect * discountImpl(t);
-
+        return jumpEffect;
     }
 
     InterestRate YieldTermStructure::zeroRate(const Date& d,
@@ -77,6 +77,15 @@ namespace QuantLib {
         */
         DiscountFactor discount(Time t,
                                 bool extrapolate = false) const;
+        /*! Writes the discount factors at the n given times.  The
+            results are the same as those of the single-time method;
+            however, interpolated curves retrieve them faster when
+            the times are sorted, as those of the cash flows of a leg.
+        */
+        void discount(const Time* t,
+                      DiscountFactor* df,
+                      Size n,
+                      bool extrapolate = false) const;
         //@}
 
         /*! \name Zero-yield rates
@@ -167,10 +176,19 @@ namespace QuantLib {
         //@{
         //! discount factor calculation
         virtual DiscountFactor discountImpl(Time) const = 0;
+        /*! discount factor calculation at n given times; the default
+            implementation calls discountImpl(Time) for each of them.
+            Derived classes should override it if a more efficient
+            implementation is available.
+        */
+        virtual void discountsImpl(const Time* t,
+                                   DiscountFactor* df,
+                                   Size n) const;
         //@}
       private:
         // methods
         void setJumps();
+        DiscountFactor jumpEffect(Time t) const;
         // data members
         std::vector<Handle<Quote> > jumps_;
         std::vector<Date> jumpDates_;
@@ -80,6 +80,14 @@
 //#    define QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
 #endif
 
+/* Define this to have singletons return different instances for
+   each evaluation context bound to the current thread; see
+   ql/evaluationcontext.hpp. It cannot be defined together with
+   QL_ENABLE_SESSIONS and requires linking with Boost.Thread. */
+#ifndef QL_ENABLE_EVALUATION_CONTEXTS
+//#    define QL_ENABLE_EVALUATION_CONTEXTS
+#endif
+
 /* Define this to enable a date resolution down to microseconds and
    allow for accurate intraday pricing.*/
 #ifndef QL_HIGH_RESOLUTION_DATE
@@ -208,10 +208,55 @@ void ArrayTest::testArrayFunctions() {
 
 }
 
+void ArrayTest::testSmallArrays() {
+
+    BOOST_TEST_MESSAGE("Testing copy and swap of small and large arrays...");
+
+    const Size sizes[] = { 0, 1, 3, 4, 5, 8 };
+    for (Size i=0; i<LENGTH(sizes); ++i) {
+        for (Size j=0; j<LENGTH(sizes); ++j) {
+            Array a(sizes[i]), b(sizes[j]);
+            for (Size k=0; k<a.size(); ++k)
+                a[k] = Real(k);
+            for (Size k=0; k<b.size(); ++k)
+                b[k] = -Real(k);
+
+            a.swap(b);
+            if (a.size() != sizes[j] || b.size() != sizes[i])
+                BOOST_FAIL("wrong sizes after swapping arrays of size "
+                           << sizes[i] << " and " << sizes[j]);
+            for (Size k=0; k<a.size(); ++k)
+                if (a[k] != -Real(k))
+                    BOOST_FAIL("wrong value after swapping arrays of size "
+                               << sizes[i] << " and " << sizes[j]);
+            for (Size k=0; k<b.size(); ++k)
+                if (b[k] != Real(k))
+                    BOOST_FAIL("wrong value after swapping arrays of size "
+                               << sizes[i] << " and " << sizes[j]);
+
+            Array c(a);
+            a = b;
+            b = c;
+            if (a.size() != sizes[i] || b.size() != sizes[j])
+                BOOST_FAIL("wrong sizes after assigning arrays of size "
+                           << sizes[i] << " and " << sizes[j]);
+            for (Size k=0; k<a.size(); ++k)
+                if (a[k] != Real(k) || a.begin()+k != &a[k])
+                    BOOST_FAIL("wrong value after assigning arrays of size "
+                               << sizes[i] << " and " << sizes[j]);
+            for (Size k=0; k<b.size(); ++k)
+                if (b[k] != -Real(k) || b.begin()+k != &b[k])
+                    BOOST_FAIL("wrong value after assigning arrays of size "
+                               << sizes[i] << " and " << sizes[j]);
+        }
+    }
+}
+
 test_suite* ArrayTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("array tests");
     suite->add(QUANTLIB_TEST_CASE(&ArrayTest::testConstruction));
     suite->add(QUANTLIB_TEST_CASE(&ArrayTest::testArrayFunctions));
+    suite->add(QUANTLIB_TEST_CASE(&ArrayTest::testSmallArrays));
     return suite;
 }
 
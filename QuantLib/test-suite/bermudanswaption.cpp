@@ -21,9 +21,11 @@
 #include "utilities.hpp"
 #include <ql/instruments/swaption.hpp>
 #include <ql/pricingengines/swaption/treeswaptionengine.hpp>
+#include <ql/pricingengines/swaption/treeswaptionbatchengine.hpp>
 #include <ql/pricingengines/swap/discountingswapengine.hpp>
 #include <ql/pricingengines/swaption/fdhullwhiteswaptionengine.hpp>
 #include <ql/models/shortrate/onefactormodels/hullwhite.hpp>
+#include <ql/models/shortrate/twofactormodels/g2.hpp>
 #include <ql/cashflows/coupon.hpp>
 #include <ql/time/daycounters/thirty360.hpp>
 #include <ql/indexes/ibor/euribor.hpp>
@@ -224,10 +226,177 @@ void BermudanSwaptionTest::testCachedValues() {
                     << "expected:   " << otmValue);
 }
 
+void BermudanSwaptionTest::testCachedG2Values() {
+
+    BOOST_TEST_MESSAGE("Testing Bermudan swaption with G2 and wide trees "
+                       "against cached values...");
+
+    CommonVars vars;
+
+    vars.today = Date(15, February, 2002);
+
+    Settings::instance().evaluationDate() = vars.today;
+
+    vars.settlement = Date(19, February, 2002);
+    // flat yield term structure impling 1x5 swap at 5%
+    vars.termStructure.linkTo(flatRate(vars.settlement,
+                                          0.04875825,
+                                          Actual365Fixed()));
+
+    Rate atmRate = vars.makeSwap(0.0)->fairRate();
+
+    boost::shared_ptr<VanillaSwap> swaps[] = {
+        vars.makeSwap(0.8*atmRate),
+        vars.makeSwap(atmRate),
+        vars.makeSwap(1.2*atmRate)
+    };
+
+    std::vector<Date> exerciseDates;
+    const Leg& leg = swaps[1]->fixedLeg();
+    for (Size i=0; i<leg.size(); i++) {
+        boost::shared_ptr<Coupon> coupon =
+            boost::dynamic_pointer_cast<Coupon>(leg[i]);
+            exerciseDates.push_back(coupon->accrualStartDate());
+    }
+    boost::shared_ptr<Exercise> exercise(new BermudanExercise(exerciseDates));
+
+    boost::shared_ptr<G2> g2Model(new G2(vars.termStructure,
+                                         0.1, 0.01, 0.1, 0.01, -0.75));
+    boost::shared_ptr<PricingEngine> g2Engine(
+                                          new TreeSwaptionEngine(g2Model, 50));
+
+    // the Hull-White tree is wider than a thousand nodes at most steps
+    boost::shared_ptr<HullWhite> hwModel(new HullWhite(vars.termStructure,
+                                                       0.048696, 0.0058904));
+    boost::shared_ptr<PricingEngine> hwEngine(
+                                        new TreeSwaptionEngine(hwModel, 2000));
+
+    #if defined(QL_USE_INDEXED_COUPON)
+    Real g2Values[] = { 42.4968, 13.7842, 2.9703 };
+    Real hwValues[] = { 42.2053, 12.8847, 2.4438 };
+    #else
+    Real g2Values[] = { 42.5028, 13.7880, 2.9715 };
+    Real hwValues[] = { 42.2111, 12.8884, 2.4448 };
+    #endif
+
+    Real tolerance = 1.0e-4;
+
+    for (Size i=0; i<LENGTH(swaps); i++) {
+        Swaption swaption(swaps[i], exercise);
+
+        swaption.setPricingEngine(g2Engine);
+        if (std::fabs(swaption.NPV()-g2Values[i]) > tolerance)
+            BOOST_ERROR("failed to reproduce cached G2 swaption value:\n"
+                        << std::setprecision(8)
+                        << "calculated: " << swaption.NPV() << "\n"
+                        << "expected:   " << g2Values[i]);
+
+        swaption.setPricingEngine(hwEngine);
+        if (std::fabs(swaption.NPV()-hwValues[i]) > tolerance)
+            BOOST_ERROR("failed to reproduce cached Hull-White "
+                        << "swaption value:\n"
+                        << std::setprecision(8)
+                        << "calculated: " << swaption.NPV() << "\n"
+                        << "expected:   " << hwValues[i]);
+    }
+}
+
+
+void BermudanSwaptionTest::testBatchEngine() {
+
+    BOOST_TEST_MESSAGE("Testing Bermudan swaptions priced in a batch...");
+
+    CommonVars vars;
+
+    vars.today = Date(15, February, 2002);
+
+    Settings::instance().evaluationDate() = vars.today;
+
+    vars.settlement = Date(19, February, 2002);
+    vars.termStructure.linkTo(flatRate(vars.settlement,
+                                          0.04875825,
+                                          Actual365Fixed()));
+
+    Rate atmRate = vars.makeSwap(0.0)->fairRate();
+
+    boost::shared_ptr<VanillaSwap> atmSwap = vars.makeSwap(atmRate);
+    std::vector<Date> exerciseDates;
+    const Leg& leg = atmSwap->fixedLeg();
+    for (Size i=0; i<leg.size(); i++) {
+        boost::shared_ptr<Coupon> coupon =
+            boost::dynamic_pointer_cast<Coupon>(leg[i]);
+        exerciseDates.push_back(coupon->accrualStartDate());
+    }
+    std::vector<Date> earlierDates(exerciseDates);
+    for (Size j=0; j<earlierDates.size(); j++)
+        earlierDates[j] = vars.calendar.adjust(earlierDates[j]-10);
+
+    boost::shared_ptr<Exercise> exercises[] = {
+        boost::shared_ptr<Exercise>(new BermudanExercise(exerciseDates)),
+        boost::shared_ptr<Exercise>(new BermudanExercise(earlierDates)),
+        boost::shared_ptr<Exercise>(
+                                new EuropeanExercise(exerciseDates.back()))
+    };
+    Real moneyness[] = { 0.8, 1.0, 1.2 };
+
+    std::vector<boost::shared_ptr<Swaption> > swaptions;
+    for (Size i=0; i<LENGTH(exercises); i++)
+        for (Size j=0; j<LENGTH(moneyness); j++)
+            swaptions.push_back(boost::shared_ptr<Swaption>(
+                new Swaption(vars.makeSwap(moneyness[j]*atmRate),
+                             exercises[i])));
+
+    boost::shared_ptr<HullWhite> model(new HullWhite(vars.termStructure,
+                                                     0.048696, 0.0058904));
+    const Size timeSteps = 200;
+    boost::shared_ptr<TreeSwaptionBatchEngine> batchEngine(
+                              new TreeSwaptionBatchEngine(model, timeSteps));
+    boost::shared_ptr<PricingEngine> treeEngine(
+                                   new TreeSwaptionEngine(model, timeSteps));
+
+    // a batch of one swaption uses the same grid as the single engine
+    for (Size i=0; i<swaptions.size(); i++) {
+        swaptions[i]->setPricingEngine(treeEngine);
+        Real expected = swaptions[i]->NPV();
+        swaptions[i]->setPricingEngine(boost::shared_ptr<PricingEngine>(
+                            new TreeSwaptionBatchEngine(model, timeSteps)));
+        Real calculated = swaptions[i]->NPV();
+        if (std::fabs(calculated-expected) > 1.0e-10)
+            BOOST_ERROR("failed to reproduce single swaption value:\n"
+                        << std::setprecision(8)
+                        << "calculated: " << calculated << "\n"
+                        << "expected:   " << expected);
+    }
+
+    // the batch is priced on a merged grid
+    batchEngine->addToBatch(swaptions);
+    Real tolerance = 0.02;
+    for (Size k=0; k<2; k++) {
+        for (Size i=0; i<swaptions.size(); i++) {
+            swaptions[i]->setPricingEngine(treeEngine);
+            Real expected = swaptions[i]->NPV();
+            swaptions[i]->setPricingEngine(batchEngine);
+            Real calculated = swaptions[i]->NPV();
+            if (std::fabs(calculated-expected) > tolerance)
+                BOOST_ERROR("failed to reproduce swaption value in batch:\n"
+                            << std::setprecision(8)
+                            << "calculated: " << calculated << "\n"
+                            << "expected:   " << expected);
+        }
+
+        // the batch must be recalculated when the curve changes
+        vars.termStructure.linkTo(flatRate(vars.settlement,
+                                              0.05,
+                                              Actual365Fixed()));
+    }
+}
+
 
 test_suite* BermudanSwaptionTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Bermudan swaption tests");
     suite->add(QUANTLIB_TEST_CASE(&BermudanSwaptionTest::testCachedValues));
+    suite->add(QUANTLIB_TEST_CASE(&BermudanSwaptionTest::testCachedG2Values));
+    suite->add(QUANTLIB_TEST_CASE(&BermudanSwaptionTest::testBatchEngine));
     return suite;
 }
 
@@ -28,6 +28,8 @@
 class BermudanSwaptionTest {
   public:
     static void testCachedValues();
+    static void testCachedG2Values();
+    static void testBatchEngine();
     static boost::unit_test_framework::test_suite* suite();
 };
 
@@ -22,6 +22,8 @@
 #include "blackformula.hpp"
 #include "utilities.hpp"
 #include <ql/pricingengines/blackformula.hpp>
+#include <ql/pricingengines/blackcalculator.hpp>
+#include <ql/pricingengines/blackbatchcalculator.hpp>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -117,6 +119,100 @@ void BlackFormulaTest::testChambersImpliedVol() {
     }
 }
 
+namespace {
+
+    bool sameResult(Real calculated, Real expected, Real tolerance) {
+        if (std::fabs(calculated-expected) <= tolerance)
+            return true;
+        // degenerate inputs must give the same non-finite results
+        return calculated == expected
+            || (calculated != calculated && expected != expected);
+    }
+
+}
+
+void BlackFormulaTest::testBatchCalculator() {
+
+    BOOST_TEST_MESSAGE("Testing batch Black calculator...");
+
+    Option::Type types[] = { Option::Call, Option::Put };
+    Real strikes[] = { 0.0, 1.0e-20, 50.0, 90.0, 100.0, 110.0, 200.0 };
+    Real forwards[] = { 80.0, 100.0, 120.0 };
+    Real stdDevs[] = { 0.0, 1.0e-4, 0.1, 0.3, 1.0 };
+    Real discounts[] = { 0.9, 1.0 };
+    Time maturities[] = { 0.0, 2.0 };
+
+    std::vector<Option::Type> type;
+    std::vector<Real> strike, forward, stdDev, discount, spot;
+    std::vector<Time> maturity;
+    for (Size i1=0; i1<LENGTH(types); ++i1)
+      for (Size i2=0; i2<LENGTH(strikes); ++i2)
+        for (Size i3=0; i3<LENGTH(forwards); ++i3)
+          for (Size i4=0; i4<LENGTH(stdDevs); ++i4)
+            for (Size i5=0; i5<LENGTH(discounts); ++i5)
+              for (Size i6=0; i6<LENGTH(maturities); ++i6) {
+                  type.push_back(types[i1]);
+                  strike.push_back(strikes[i2]);
+                  forward.push_back(forwards[i3]);
+                  stdDev.push_back(stdDevs[i4]);
+                  discount.push_back(discounts[i5]);
+                  spot.push_back(0.97*forwards[i3]);
+                  maturity.push_back(maturities[i6]);
+              }
+
+    BlackBatchCalculator batch(type, strike, forward, stdDev, discount);
+    const std::vector<Real> values = batch.value();
+    const std::vector<Real> deltasForward = batch.deltaForward();
+    const std::vector<Real> deltas = batch.delta(spot);
+    const std::vector<Real> gammasForward = batch.gammaForward();
+    const std::vector<Real> gammas = batch.gamma(spot);
+    const std::vector<Real> vegas = batch.vega(maturity);
+    const std::vector<Real> thetas = batch.theta(spot, maturity);
+
+    const Real tolerance = 1.0e-12;
+    for (Size i=0; i<type.size(); ++i) {
+        BlackCalculator black(type[i], strike[i], forward[i],
+                              stdDev[i], discount[i]);
+
+        std::vector<std::pair<std::string, std::pair<Real,Real> > > results;
+        results.push_back(std::make_pair(std::string("value"),
+                              std::make_pair(values[i], black.value())));
+        // BlackCalculator divides by zero when the variance is null
+        if (stdDev[i] > 0.0) {
+            results.push_back(std::make_pair(std::string("delta forward"),
+                std::make_pair(deltasForward[i], black.deltaForward())));
+            results.push_back(std::make_pair(std::string("delta"),
+                std::make_pair(deltas[i], black.delta(spot[i]))));
+            results.push_back(std::make_pair(std::string("gamma forward"),
+                std::make_pair(gammasForward[i], black.gammaForward())));
+            results.push_back(std::make_pair(std::string("gamma"),
+                std::make_pair(gammas[i], black.gamma(spot[i]))));
+            results.push_back(std::make_pair(std::string("vega"),
+                std::make_pair(vegas[i], black.vega(maturity[i]))));
+            results.push_back(std::make_pair(std::string("theta"),
+                std::make_pair(thetas[i],
+                               black.theta(spot[i], maturity[i]))));
+        }
+
+        for (Size j=0; j<results.size(); ++j) {
+            Real calculated = results[j].second.first;
+            Real expected = results[j].second.second;
+            if (!sameResult(calculated, expected, tolerance))
+                BOOST_ERROR("batch " << results[j].first
+                            << " differs from BlackCalculator for "
+                            << type[i] << " option:"
+                            << "\n    strike:     " << strike[i]
+                            << "\n    forward:    " << forward[i]
+                            << "\n    stdDev:     " << stdDev[i]
+                            << "\n    discount:   " << discount[i]
+                            << "\n    maturity:   " << maturity[i]
+                            << std::setprecision(16)
+                            << "\n    calculated: " << calculated
+                            << "\n    expected:   " << expected);
+        }
+    }
+}
+
 test_suite* BlackFormulaTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Black formula tests");
 
@@ -124,6 +220,8 @@ test_suite* BlackFormulaTest::suite() {
         &BlackFormulaTest::testBachelierImpliedVol));
     suite->add(QUANTLIB_TEST_CASE(
         &BlackFormulaTest::testChambersImpliedVol));
+    suite->add(QUANTLIB_TEST_CASE(
+        &BlackFormulaTest::testBatchCalculator));
 
     return suite;
 }
@@ -20,12 +20,15 @@
 #include "cashflows.hpp"
 #include "utilities.hpp"
 #include <ql/cashflows/cashflows.hpp>
+#include <ql/cashflows/compiledleg.hpp>
 #include <ql/cashflows/simplecashflow.hpp>
 #include <ql/cashflows/fixedratecoupon.hpp>
 #include <ql/cashflows/floatingratecoupon.hpp>
 #include <ql/cashflows/iborcoupon.hpp>
 #include <ql/cashflows/couponpricer.hpp>
 #include <ql/termstructures/volatility/optionlet/constantoptionletvol.hpp>
+#include <ql/termstructures/yield/zerocurve.hpp>
+#include <ql/termstructures/yield/flatforward.hpp>
 #include <ql/quotes/simplequote.hpp>
 #include <ql/time/calendars/target.hpp>
 #include <ql/time/schedule.hpp>
@@ -264,11 +267,175 @@ void CashFlowsTest::testNullFixingDays() {
         .withFixingDays(Null<Natural>());
 }
 
+namespace {
+
+    void checkCompiledLeg(const Leg& leg,
+                          const CompiledLeg& compiled,
+                          const YieldTermStructure& discountCurve,
+                          bool includeSettlementDateFlows,
+                          const Date& settlementDate,
+                          const std::string& name) {
+        Real tolerance = 1.0e-12;
+
+        Real expectedNPV = CashFlows::npv(leg, discountCurve,
+                                          includeSettlementDateFlows,
+                                          settlementDate);
+        Real expectedBPS = CashFlows::bps(leg, discountCurve,
+                                          includeSettlementDateFlows,
+                                          settlementDate);
+
+        Real npv = CashFlows::npv(compiled, discountCurve,
+                                  includeSettlementDateFlows,
+                                  settlementDate);
+        Real bps = CashFlows::bps(compiled, discountCurve,
+                                  includeSettlementDateFlows,
+                                  settlementDate);
+        if (std::fabs(npv - expectedNPV) > tolerance)
+            BOOST_ERROR("failed to reproduce NPV of " << name << " leg"
+                        << std::setprecision(12)
+                        << "\n    settlement: " << settlementDate
+                        << "\n    compiled:   " << npv
+                        << "\n    expected:   " << expectedNPV);
+        if (std::fabs(bps - expectedBPS) > tolerance)
+            BOOST_ERROR("failed to reproduce BPS of " << name << " leg"
+                        << std::setprecision(12)
+                        << "\n    settlement: " << settlementDate
+                        << "\n    compiled:   " << bps
+                        << "\n    expected:   " << expectedBPS);
+
+        CashFlows::npvbps(compiled, discountCurve,
+                          includeSettlementDateFlows,
+                          settlementDate, settlementDate, npv, bps);
+        if (std::fabs(npv - expectedNPV) > tolerance ||
+            std::fabs(bps - expectedBPS) > tolerance)
+            BOOST_ERROR("failed to reproduce NPV and BPS of "
+                        << name << " leg"
+                        << std::setprecision(12)
+                        << "\n    settlement:   " << settlementDate
+                        << "\n    compiled NPV: " << npv
+                        << "\n    expected NPV: " << expectedNPV
+                        << "\n    compiled BPS: " << bps
+                        << "\n    expected BPS: " << expectedBPS);
+    }
+
+}
+
+void CashFlowsTest::testCompiledLegs() {
+    BOOST_TEST_MESSAGE("Testing NPV and BPS of compiled legs...");
+
+    SavedSettings backup;
+    IndexHistoryCleaner cleaner;
+
+    Date today(15, March, 2016);
+    Settings::instance().evaluationDate() = today;
+    Calendar calendar = TARGET();
+
+    std::vector<Date> dates;
+    std::vector<Rate> yields;
+    for (Size i=0; i<=8; ++i) {
+        dates.push_back(today + Period(2*i, Years));
+        yields.push_back(0.01 + 0.002*i);
+    }
+    InterpolatedZeroCurve<Linear> discountCurve(dates, yields,
+                                                Actual365Fixed());
+
+    boost::shared_ptr<SimpleQuote> forecastRate(new SimpleQuote(0.02));
+    Handle<YieldTermStructure> forecastCurve(
+        boost::shared_ptr<YieldTermStructure>(
+            new FlatForward(today, Handle<Quote>(forecastRate),
+                            Actual365Fixed())));
+    boost::shared_ptr<IborIndex> index(new USDLibor(3*Months,
+                                                    forecastCurve));
+
+    Schedule fixedSchedule = MakeSchedule()
+        .from(today - 1*Years).to(today + 10*Years)
+        .withFrequency(Semiannual)
+        .withCalendar(calendar)
+        .withConvention(Following)
+        .backwards();
+    Leg fixedLeg = FixedRateLeg(fixedSchedule)
+        .withNotionals(100.0)
+        .withCouponRates(0.03, Actual360());
+    // a final redemption, which is not a coupon
+    fixedLeg.push_back(boost::shared_ptr<CashFlow>(
+                  new SimpleCashFlow(100.0, fixedLeg.back()->date())));
+
+    Schedule floatingSchedule = MakeSchedule()
+        .from(today - 7*Months).to(today + 10*Years)
+        .withFrequency(Quarterly)
+        .withCalendar(calendar)
+        .withConvention(ModifiedFollowing)
+        .backwards();
+    Leg floatingLeg = IborLeg(floatingSchedule, index)
+        .withNotionals(100.0)
+        .withSpreads(0.001);
+    // only the fixings of the coupons paid from today on are
+    // available; the amounts of the previous ones can't be
+    // calculated, but they are not required.
+    for (Size i=0; i<floatingLeg.size(); ++i) {
+        boost::shared_ptr<FloatingRateCoupon> c =
+            boost::dynamic_pointer_cast<FloatingRateCoupon>(floatingLeg[i]);
+        if (c->fixingDate() < today && c->date() >= today)
+            index->addFixing(c->fixingDate(), 0.015);
+    }
+
+    std::vector<boost::shared_ptr<CompiledLeg> > compiled;
+    compiled.push_back(
+                 boost::shared_ptr<CompiledLeg>(new CompiledLeg(fixedLeg)));
+    compiled.push_back(
+              boost::shared_ptr<CompiledLeg>(new CompiledLeg(floatingLeg)));
+    std::vector<Leg> legs;
+    legs.push_back(fixedLeg);
+    legs.push_back(floatingLeg);
+    std::string names[] = { "fixed-rate", "floating-rate" };
+
+    std::vector<Date> settlementDates;
+    settlementDates.push_back(today);
+    settlementDates.push_back(today + 2);
+    // falls on a payment date
+    settlementDates.push_back(fixedLeg[6]->date());
+    settlementDates.push_back(floatingLeg[9]->date());
+
+    for (Size i=0; i<legs.size(); ++i) {
+        for (Size j=0; j<settlementDates.size(); ++j) {
+            checkCompiledLeg(legs[i], *compiled[i], discountCurve,
+                             false, settlementDates[j], names[i]);
+            checkCompiledLeg(legs[i], *compiled[i], discountCurve,
+                             true, settlementDates[j], names[i]);
+        }
+    }
+
+    // the compiled floating leg must follow the forecast curve
+    forecastRate->setValue(0.025);
+    checkCompiledLeg(floatingLeg, *compiled[1], discountCurve,
+                     false, today, names[1]);
+
+    std::vector<Real> npvs, bps;
+    CashFlows::npvbps(compiled, discountCurve, false, today, today,
+                      npvs, bps);
+    for (Size i=0; i<legs.size(); ++i) {
+        Real expectedNPV = CashFlows::npv(legs[i], discountCurve,
+                                          false, today);
+        Real expectedBPS = CashFlows::bps(legs[i], discountCurve,
+                                          false, today);
+        if (std::fabs(npvs[i] - expectedNPV) > 1.0e-12 ||
+            std::fabs(bps[i] - expectedBPS) > 1.0e-12)
+            BOOST_ERROR("failed to reproduce NPV and BPS of "
+                        << names[i] << " leg in batch"
+                        << std::setprecision(12)
+                        << "\n    compiled NPV: " << npvs[i]
+                        << "\n    expected NPV: " << expectedNPV
+                        << "\n    compiled BPS: " << bps[i]
+                        << "\n    expected BPS: " << expectedBPS);
+    }
+}
+
 test_suite* CashFlowsTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Cash flows tests");
     suite->add(QUANTLIB_TEST_CASE(&CashFlowsTest::testSettings));
     suite->add(QUANTLIB_TEST_CASE(&CashFlowsTest::testAccessViolation));
     suite->add(QUANTLIB_TEST_CASE(&CashFlowsTest::testDefaultSettlementDate));
+    suite->add(QUANTLIB_TEST_CASE(&CashFlowsTest::testCompiledLegs));
     #ifndef QL_USE_INDEXED_COUPON
     suite->add(QUANTLIB_TEST_CASE(&CashFlowsTest::testNullFixingDays));
     #endif
@@ -27,6 +27,7 @@ class CashFlowsTest {
     static void testSettings();
     static void testAccessViolation();
     static void testDefaultSettlementDate();
+    static void testCompiledLegs();
     static void testNullFixingDays();
     static boost::unit_test_framework::test_suite* suite();
 };
@@ -23,6 +23,9 @@
 #include <ql/termstructures/credit/piecewisedefaultcurve.hpp>
 #include <ql/termstructures/credit/defaultprobabilityhelpers.hpp>
 #include <ql/termstructures/credit/flathazardrate.hpp>
+#include <ql/termstructures/credit/interpolatedhazardratecurve.hpp>
+#include <ql/termstructures/credit/interpolateddefaultdensitycurve.hpp>
+#include <ql/termstructures/credit/interpolatedsurvivalprobabilitycurve.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
 #include <ql/instruments/creditdefaultswap.hpp>
 #include <ql/pricingengines/credit/midpointcdsengine.hpp>
@@ -387,6 +390,79 @@ void DefaultProbabilityCurveTest::testUpfrontBootstrap() {
 }
 
 
+namespace {
+
+    void checkBatchedProbabilities(const DefaultProbabilityTermStructure& curve,
+                                   const std::string& name) {
+        // quarterly times, past the last node, sorted and then reversed
+        std::vector<Time> times;
+        for (Size i=0; i<=60; ++i)
+            times.push_back(0.25*i);
+        for (Size i=60; i>0; --i)
+            times.push_back(0.25*i - 0.1);
+
+        std::vector<Probability> p(times.size());
+        curve.survivalProbability(&times[0], &p[0], times.size(), true);
+
+        for (Size i=0; i<times.size(); ++i) {
+            Probability expected = curve.survivalProbability(times[i], true);
+            if (std::fabs(p[i] - expected) > 1.0e-15)
+                BOOST_ERROR("batched survival probability differs from "
+                            "single one for " << name << " curve"
+                            << std::setprecision(15)
+                            << "\n    time:       " << times[i]
+                            << "\n    calculated: " << p[i]
+                            << "\n    expected:   " << expected);
+        }
+    }
+
+}
+
+void DefaultProbabilityCurveTest::testBatchedProbabilities() {
+    BOOST_TEST_MESSAGE("Testing batched survival probabilities...");
+
+    Date today = Settings::instance().evaluationDate();
+    DayCounter dayCounter = Actual360();
+
+    std::vector<Date> dates;
+    dates.push_back(today);
+    dates.push_back(today + 1*Years);
+    dates.push_back(today + 2*Years);
+    dates.push_back(today + 3*Years);
+    dates.push_back(today + 5*Years);
+    dates.push_back(today + 7*Years);
+    dates.push_back(today + 10*Years);
+
+    std::vector<Real> rates, probabilities;
+    Real hazard = 0.01;
+    probabilities.push_back(1.0);
+    for (Size i=0; i<dates.size(); ++i) {
+        rates.push_back(hazard);
+        if (i > 0)
+            probabilities.push_back(probabilities.back()*
+                std::exp(-hazard*dayCounter.yearFraction(dates[i-1],dates[i])));
+        hazard += 0.002;
+    }
+
+    boost::shared_ptr<Quote> jump(new SimpleQuote(0.99));
+    std::vector<Handle<Quote> > jumps(1, Handle<Quote>(jump));
+    std::vector<Date> jumpDates(1, today + 4*Years);
+
+    checkBatchedProbabilities(
+        InterpolatedHazardRateCurve<BackwardFlat>(dates, rates, dayCounter,
+                                                  Calendar(), jumps,
+                                                  jumpDates),
+        "hazard-rate");
+    checkBatchedProbabilities(
+        InterpolatedDefaultDensityCurve<Linear>(dates, rates, dayCounter),
+        "default-density");
+    checkBatchedProbabilities(
+        InterpolatedSurvivalProbabilityCurve<LogLinear>(dates, probabilities,
+                                                        dayCounter),
+        "survival-probability");
+}
+
+
 test_suite* DefaultProbabilityCurveTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Default-probability curve tests");
     suite->add(QUANTLIB_TEST_CASE(
@@ -405,5 +481,7 @@ test_suite* DefaultProbabilityCurveTest::suite() {
                 &DefaultProbabilityCurveTest::testSingleInstrumentBootstrap));
     suite->add(QUANTLIB_TEST_CASE(
                          &DefaultProbabilityCurveTest::testUpfrontBootstrap));
+    suite->add(QUANTLIB_TEST_CASE(
+                     &DefaultProbabilityCurveTest::testBatchedProbabilities));
     return suite;
 }
@@ -24,12 +24,14 @@
 #include <ql/time/calendars/target.hpp>
 #include <ql/time/daycounters/actual360.hpp>
 #include <ql/instruments/europeanoption.hpp>
+#include <ql/instruments/impliedvolatility.hpp>
 #include <ql/math/randomnumbers/rngtraits.hpp>
 #include <ql/math/interpolations/bicubicsplineinterpolation.hpp>
 #include <ql/math/interpolations/bilinearinterpolation.hpp>
 #include <ql/pricingengines/vanilla/analyticeuropeanengine.hpp>
 #include <ql/pricingengines/vanilla/binomialengine.hpp>
 #include <ql/pricingengines/vanilla/fdblackscholesvanillaengine.hpp>
+#include <ql/pricingengines/vanilla/fdblackscholesbatchengine.hpp>
 #include <ql/experimental/variancegamma/fftvanillaengine.hpp>
 #include <ql/pricingengines/vanilla/fdeuropeanengine.hpp>
 #include <ql/pricingengines/vanilla/mceuropeanengine.hpp>
@@ -894,6 +896,138 @@ void EuropeanOptionTest::testImpliedVol() {
 }
 
 
+void EuropeanOptionTest::testBatchImpliedVol() {
+
+    BOOST_TEST_MESSAGE("Testing batch European option implied volatility...");
+
+    SavedSettings backup;
+
+    Real tolerance = 1.0e-6;
+
+    Option::Type types[] = { Option::Call, Option::Put };
+    Real strikes[] = { 70.0, 90.0, 99.5, 100.0, 100.5, 110.0, 140.0 };
+    Integer lengths[] = { 36, 180, 360, 1080 };
+    Volatility vols[] = { 0.05, 0.20, 0.30, 0.70, 0.90 };
+
+    DayCounter dc = Actual360();
+    Date today = Date::todaysDate();
+
+    boost::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    boost::shared_ptr<SimpleQuote> vol(new SimpleQuote(0.0));
+    boost::shared_ptr<BlackVolTermStructure> volTS = flatVol(today, vol, dc);
+    boost::shared_ptr<YieldTermStructure> qTS = flatRate(today, 0.03, dc);
+    boost::shared_ptr<YieldTermStructure> rTS = flatRate(today, 0.06, dc);
+    boost::shared_ptr<GeneralizedBlackScholesProcess> process =
+        makeProcess(spot, qTS, rTS, volTS);
+
+    std::vector<Option::Type> type;
+    std::vector<Real> strike, value;
+    std::vector<Date> exerciseDate;
+    std::vector<Volatility> volatility;
+    std::vector<boost::shared_ptr<VanillaOption> > options;
+
+    for (Size i=0; i<LENGTH(types); i++) {
+      for (Size j=0; j<LENGTH(strikes); j++) {
+        for (Size k=0; k<LENGTH(lengths); k++) {
+          Date exDate = today + lengths[k];
+          boost::shared_ptr<Exercise> exercise(new EuropeanExercise(exDate));
+          boost::shared_ptr<StrikedTypePayoff> payoff(
+                                new PlainVanillaPayoff(types[i], strikes[j]));
+          boost::shared_ptr<VanillaOption> option =
+              makeOption(payoff, exercise, spot, qTS, rTS, volTS,
+                         Analytic, Null<Size>(), Null<Size>());
+          for (Size l=0; l<LENGTH(vols); l++) {
+              vol->setValue(vols[l]);
+              Real npv = option->NPV();
+              // flat price vs vol --- pointless (and numerically
+              // unstable) to solve
+              vol->setValue(vols[l]*0.5);
+              if (std::fabs(npv-option->NPV()) <= 1.0e-12)
+                  continue;
+
+              type.push_back(types[i]);
+              strike.push_back(strikes[j]);
+              exerciseDate.push_back(exDate);
+              value.push_back(npv);
+              volatility.push_back(vols[l]);
+              options.push_back(option);
+          }
+        }
+      }
+    }
+
+    // no solution for these
+    type.push_back(Option::Call);
+    strike.push_back(100.0);
+    exerciseDate.push_back(today + 360);
+    value.push_back(120.0);
+    type.push_back(Option::Put);
+    strike.push_back(140.0);
+    exerciseDate.push_back(today + 360);
+    value.push_back(1.0);
+    // invalid quotes, which must not abort the batch
+    type.push_back(Option::Call);
+    strike.push_back(100.0);
+    exerciseDate.push_back(today + 360);
+    value.push_back(-1.0);
+    type.push_back(Option::Put);
+    strike.push_back(-10.0);
+    exerciseDate.push_back(today + 360);
+    value.push_back(1.0);
+    type.push_back(Option::Call);
+    strike.push_back(100.0);
+    exerciseDate.push_back(today - 1);
+    value.push_back(5.0);
+
+    std::vector<bool> converged;
+    std::vector<Volatility> implVols =
+        detail::ImpliedVolatilityHelper::calculate(type, strike, exerciseDate,
+                                                   value, process, converged,
+                                                   1.0e-10, 100);
+
+    for (Size i=0; i<options.size(); ++i) {
+        Volatility implVol = implVols[i];
+        if (!converged[i]) {
+            BOOST_ERROR("batch implied vol calculation failed:"
+                        << "\n    option:     " << type[i]
+                        << "\n    strike:     " << strike[i]
+                        << "\n    maturity:   " << exerciseDate[i]
+                        << "\n    volatility: " << io::volatility(volatility[i])
+                        << "\n    value:      " << value[i]);
+            continue;
+        }
+
+        Volatility expected = options[i]->impliedVolatility(value[i], process,
+                                                            tolerance, 100);
+        if (std::fabs(implVol-expected) > tolerance) {
+            // the difference might not matter
+            vol->setValue(implVol);
+            Real value2 = options[i]->NPV();
+            Real error = relativeError(value[i], value2, spot->value());
+            if (error > tolerance)
+                BOOST_ERROR(type[i] << " option:"
+                    << "\n    strike:              " << strike[i]
+                    << "\n    maturity:            " << exerciseDate[i]
+                    << "\n    original volatility: "
+                    << io::volatility(volatility[i])
+                    << "\n    price:               " << value[i]
+                    << "\n    implied volatility:  " << io::volatility(implVol)
+                    << "\n    expected:            " << io::volatility(expected)
+                    << "\n    corresponding price: " << value2
+                    << "\n    error:               " << error);
+        }
+    }
+
+    for (Size i=options.size(); i<type.size(); ++i) {
+        if (converged[i] || implVols[i] != Null<Real>())
+            BOOST_ERROR("implied volatility returned for " << type[i]
+                        << " option with no solution:"
+                        << "\n    strike:     " << strike[i]
+                        << "\n    value:      " << value[i]
+                        << "\n    volatility: " << implVols[i]);
+    }
+}
+
 void EuropeanOptionTest::testImpliedVolContainment() {
 
     BOOST_TEST_MESSAGE("Testing self-containment of "
@@ -1265,6 +1399,88 @@ void EuropeanOptionTest::testQmcEngines() {
     testEngineConsistency(engine,steps,samples,relativeTol);
 }
 
+void EuropeanOptionTest::testMcEnginesWithThreads() {
+
+    BOOST_TEST_MESSAGE("Testing multi-threaded Monte Carlo European "
+                       "engines...");
+
+    SavedSettings backup;
+
+    DayCounter dc = Actual360();
+    Date today = Date::todaysDate();
+
+    boost::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    boost::shared_ptr<YieldTermStructure> qTS = flatRate(today, 0.02, dc);
+    boost::shared_ptr<YieldTermStructure> rTS = flatRate(today, 0.05, dc);
+    boost::shared_ptr<BlackVolTermStructure> volTS = flatVol(today, 0.20, dc);
+    boost::shared_ptr<GeneralizedBlackScholesProcess> process =
+        makeProcess(spot, qTS, rTS, volTS);
+
+    boost::shared_ptr<StrikedTypePayoff> payoff(
+                                 new PlainVanillaPayoff(Option::Call, 105.0));
+    boost::shared_ptr<Exercise> exercise(
+                                 new EuropeanExercise(today + 360));
+    EuropeanOption option(payoff, exercise);
+
+    option.setPricingEngine(boost::shared_ptr<PricingEngine>(
+                                     new AnalyticEuropeanEngine(process)));
+    Real expected = option.NPV();
+
+    // a number of samples which is not a multiple of the stream size
+    Size samples = 10000;
+    Size threads[] = { 2, 3, 8 };
+
+    option.setPricingEngine(MakeMCEuropeanEngine<PseudoRandom>(process)
+                            .withSteps(4)
+                            .withSamples(samples)
+                            .withSeed(42)
+                            .withThreads(threads[0]));
+    Real reference = option.NPV();
+    Real error = option.errorEstimate();
+
+    if (std::fabs(reference-expected) > 3.0*error)
+        BOOST_ERROR("failed to reproduce analytic value"
+                    << "\n    calculated: " << reference
+                    << "\n    expected:   " << expected
+                    << "\n    error estimate: " << error);
+
+    for (Size i=1; i<LENGTH(threads); ++i) {
+        option.setPricingEngine(MakeMCEuropeanEngine<PseudoRandom>(process)
+                                .withSteps(4)
+                                .withSamples(samples)
+                                .withSeed(42)
+                                .withThreads(threads[i]));
+        Real calculated = option.NPV();
+        if (std::fabs(calculated-reference) > 1.0e-12)
+            BOOST_ERROR("pseudo-random results depend on number of threads"
+                        << "\n    threads:    " << threads[i]
+                        << "\n    calculated: " << calculated
+                        << "\n    expected:   " << reference);
+    }
+
+    // Sobol streams are contiguous chunks of the sequence, therefore
+    // the single-threaded results are reproduced
+    option.setPricingEngine(MakeMCEuropeanEngine<LowDiscrepancy>(process)
+                            .withSteps(4)
+                            .withSamples(samples)
+                            .withSeed(42));
+    reference = option.NPV();
+
+    for (Size i=0; i<LENGTH(threads); ++i) {
+        option.setPricingEngine(MakeMCEuropeanEngine<LowDiscrepancy>(process)
+                                .withSteps(4)
+                                .withSamples(samples)
+                                .withSeed(42)
+                                .withThreads(threads[i]));
+        Real calculated = option.NPV();
+        if (std::fabs(calculated-reference) > 1.0e-12)
+            BOOST_ERROR("low-discrepancy results depend on number of threads"
+                        << "\n    threads:    " << threads[i]
+                        << "\n    calculated: " << calculated
+                        << "\n    expected:   " << reference);
+    }
+}
+
 void EuropeanOptionTest::testFFTEngines() {
 
     BOOST_TEST_MESSAGE("Testing FFT European engines "
@@ -1514,12 +1730,142 @@ void EuropeanOptionTest::testLocalVolatility() {
 }
 
 
+void EuropeanOptionTest::testFdBatchEngine() {
+    BOOST_TEST_MESSAGE("Testing finite-differences batch engine...");
+
+    SavedSettings backup;
+
+    const Date today(28, March, 2016);
+    Settings::instance().evaluationDate() = today;
+
+    const DayCounter dayCounter = Actual365Fixed();
+    const Calendar calendar = TARGET();
+
+    const boost::shared_ptr<Quote> s0(new SimpleQuote(100.0));
+    const boost::shared_ptr<YieldTermStructure> rTS(
+                                        flatRate(today, 0.05, dayCounter));
+    const boost::shared_ptr<YieldTermStructure> qTS(
+                                        flatRate(today, 0.02, dayCounter));
+
+    // a volatility smile, so that each option sees a different volatility
+    Real tmp[] = { 60.0, 80.0, 100.0, 120.0, 140.0 };
+    const std::vector<Real> surfaceStrikes(tmp, tmp+LENGTH(tmp));
+    std::vector<Date> surfaceDates;
+    surfaceDates.push_back(today + Period(3, Months));
+    surfaceDates.push_back(today + Period(1, Years));
+    surfaceDates.push_back(today + Period(2, Years));
+
+    Volatility v[] = { 0.35, 0.32, 0.30,
+                       0.28, 0.27, 0.26,
+                       0.22, 0.22, 0.22,
+                       0.24, 0.23, 0.23,
+                       0.30, 0.28, 0.27 };
+    Matrix blackVolMatrix(surfaceStrikes.size(), surfaceDates.size());
+    for (Size i=0; i < surfaceStrikes.size(); ++i)
+        for (Size j=0; j < surfaceDates.size(); ++j)
+            blackVolMatrix[i][j] = v[i*surfaceDates.size()+j];
+
+    const boost::shared_ptr<BlackVolTermStructure> volTS(
+        new BlackVarianceSurface(today, calendar, surfaceDates,
+                                 surfaceStrikes, blackVolMatrix, dayCounter));
+    const boost::shared_ptr<GeneralizedBlackScholesProcess> process =
+                                             makeProcess(s0, qTS, rTS, volTS);
+
+    const Size tGrid = 100, xGrid = 200;
+    const boost::shared_ptr<FdBlackScholesBatchEngine> batchEngine(
+                     new FdBlackScholesBatchEngine(process, tGrid, xGrid));
+
+    Real strikes[] = { 70.0, 85.0, 95.0, 100.0, 110.0, 120.0 };
+    Period maturities[] = { Period(6, Months), Period(18, Months) };
+    Option::Type types[] = { Option::Call, Option::Put };
+
+    std::vector<boost::shared_ptr<VanillaOption> > options;
+    for (Size i=0; i < LENGTH(maturities); ++i) {
+        const Date exDate = today + maturities[i];
+        const boost::shared_ptr<Exercise> exercises[] = {
+            boost::shared_ptr<Exercise>(new EuropeanExercise(exDate)),
+            boost::shared_ptr<Exercise>(new AmericanExercise(today, exDate))
+        };
+        for (Size j=0; j < LENGTH(exercises); ++j)
+            for (Size k=0; k < LENGTH(types); ++k)
+                for (Size l=0; l < LENGTH(strikes); ++l) {
+                    const boost::shared_ptr<StrikedTypePayoff> payoff(
+                               new PlainVanillaPayoff(types[k], strikes[l]));
+                    options.push_back(boost::shared_ptr<VanillaOption>(
+                                   new VanillaOption(payoff, exercises[j])));
+                    options.back()->setPricingEngine(batchEngine);
+                }
+    }
+    batchEngine->addToBatch(options);
+
+    const boost::shared_ptr<PricingEngine> singleEngine(
+                   new FdBlackScholesVanillaEngine(process, tGrid, xGrid));
+
+    const Real tol = 0.01;
+    for (Size i=0; i < options.size(); ++i) {
+        const boost::shared_ptr<VanillaOption>& option = options[i];
+        const Real calculatedNPV   = option->NPV();
+        const Real calculatedDelta = option->delta();
+        const Real calculatedGamma = option->gamma();
+        const Real calculatedTheta = option->theta();
+
+        option->setPricingEngine(singleEngine);
+        const Real expectedNPV   = option->NPV();
+        const Real expectedDelta = option->delta();
+        const Real expectedGamma = option->gamma();
+        const Real expectedTheta = option->theta();
+
+        const boost::shared_ptr<StrikedTypePayoff> payoff =
+            boost::dynamic_pointer_cast<StrikedTypePayoff>(option->payoff());
+
+        if (std::fabs(calculatedNPV - expectedNPV) > tol
+            || std::fabs(calculatedDelta - expectedDelta) > 0.1*tol
+            || std::fabs(calculatedGamma - expectedGamma) > 0.2*tol
+            || std::fabs(calculatedTheta - expectedTheta) > tol) {
+            BOOST_FAIL("Failed to reproduce option results for "
+                       << "\n    type:       " << payoff->optionType()
+                       << "\n    strike:     " << payoff->strike()
+                       << "\n    exercise:   "
+                       << (option->exercise()->type() == Exercise::European
+                           ? "European" : "American")
+                       << "\n    maturity:   "
+                       << option->exercise()->lastDate()
+                       << "\n    value:      " << calculatedNPV
+                       << " (expected " << expectedNPV << ")"
+                       << "\n    delta:      " << calculatedDelta
+                       << " (expected " << expectedDelta << ")"
+                       << "\n    gamma:      " << calculatedGamma
+                       << " (expected " << expectedGamma << ")"
+                       << "\n    theta:      " << calculatedTheta
+                       << " (expected " << expectedTheta << ")");
+        }
+    }
+
+    // batch results must be recalculated when the process changes
+    const boost::shared_ptr<VanillaOption>& option = options.front();
+    option->setPricingEngine(batchEngine);
+    const Real initialNPV = option->NPV();
+    boost::dynamic_pointer_cast<SimpleQuote>(s0)->setValue(101.0);
+    const Real calculatedNPV = option->NPV();
+    option->setPricingEngine(singleEngine);
+    const Real expectedNPV = option->NPV();
+    if (std::fabs(calculatedNPV - expectedNPV) > tol
+        || std::fabs(calculatedNPV - initialNPV) < tol) {
+        BOOST_FAIL("Failed to update batch results after spot change"
+                   << "\n    initial value:    " << initialNPV
+                   << "\n    calculated value: " << calculatedNPV
+                   << "\n    expected value:   " << expectedNPV);
+    }
+}
+
+
 test_suite* EuropeanOptionTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("European option tests");
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testValues));
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testGreekValues));
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testGreeks));
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testImpliedVol));
+    suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testBatchImpliedVol));
     suite->add(QUANTLIB_TEST_CASE(
                            &EuropeanOptionTest::testImpliedVolContainment));
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testJRBinomialEngines));
@@ -1537,10 +1883,13 @@ test_suite* EuropeanOptionTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testIntegralEngines));
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testMcEngines));
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testQmcEngines));
+    suite->add(QUANTLIB_TEST_CASE(
+                              &EuropeanOptionTest::testMcEnginesWithThreads));
 
     // FLOATING_POINT_EXCEPTION
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testPriceCurve));
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testLocalVolatility));
+    suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testFdBatchEngine));
 
     return suite;
 }
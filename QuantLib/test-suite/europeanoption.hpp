@@ -33,6 +33,7 @@ class EuropeanOptionTest {
     static void testGreeks();
     static void testImpliedVol();
     static void testImpliedVolContainment();
+    static void testBatchImpliedVol();
     static void testJRBinomialEngines();
     static void testCRRBinomialEngines();
     static void testEQPBinomialEngines();
@@ -44,9 +45,11 @@ class EuropeanOptionTest {
     static void testIntegralEngines();
     static void testQmcEngines();
     static void testMcEngines();
+    static void testMcEnginesWithThreads();
     static void testFFTEngines();
     static void testPriceCurve();
     static void testLocalVolatility();
+    static void testFdBatchEngine();
     static boost::unit_test_framework::test_suite* suite();
     static boost::unit_test_framework::test_suite* experimental();
 };
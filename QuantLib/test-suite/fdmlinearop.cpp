@@ -37,14 +37,19 @@
 #include <ql/math/randomnumbers/rngtraits.hpp>
 #include <ql/models/equity/hestonmodel.hpp>
 #include <ql/termstructures/yield/zerocurve.hpp>
+#include <ql/instruments/vanillaoption.hpp>
 #include <ql/pricingengines/vanilla/analyticeuropeanengine.hpp>
+#include <ql/pricingengines/vanilla/fdblackscholesvanillaengine.hpp>
 #include <ql/pricingengines/vanilla/mchestonhullwhiteengine.hpp>
 #include <ql/methods/finitedifferences/finitedifferencemodel.hpp>
 #include <ql/math/matrixutilities/bicgstab.hpp>
+#include <ql/math/matrixutilities/gmres.hpp>
 #include <ql/methods/finitedifferences/schemes/douglasscheme.hpp>
 #include <ql/methods/finitedifferences/schemes/hundsdorferscheme.hpp>
 #include <ql/methods/finitedifferences/schemes/impliciteulerscheme.hpp>
 #include <ql/methods/finitedifferences/schemes/craigsneydscheme.hpp>
+#include <ql/methods/finitedifferences/schemes/modifiedcraigsneydscheme.hpp>
+#include <ql/methods/finitedifferences/schemes/cranknicolsonscheme.hpp>
 #include <ql/methods/finitedifferences/meshers/uniformgridmesher.hpp>
 #include <ql/methods/finitedifferences/meshers/uniform1dmesher.hpp>
 #include <ql/methods/finitedifferences/meshers/concentrating1dmesher.hpp>
@@ -70,6 +75,7 @@
 #include <ql/methods/finitedifferences/operators/secondderivativeop.hpp>
 #include <ql/methods/finitedifferences/operators/secondordermixedderivativeop.hpp>
 #include <ql/math/matrixutilities/sparseilupreconditioner.hpp>
+#include <ql/math/matrixutilities/bandedludecomposition.hpp>
 #if defined(__GNUC__) && (((__GNUC__ == 4) && (__GNUC_MINOR__ >= 8)) || (__GNUC__ > 4))
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wunused-local-typedefs"
@@ -757,6 +763,49 @@ void FdmLinearOpTest::testTripleBandMapSolve() {
 }
 
 
+void FdmLinearOpTest::testTripleBandMapSolveOnLines() {
+
+    BOOST_TEST_MESSAGE("Testing triple-band map solution "
+                       "on three-dimensional grids...");
+
+    // the sizes are chosen so that the lines along the second and
+    // third direction are solved in blocks of different lengths
+    Size dims[] = {7, 37, 9};
+    const std::vector<Size> dim(dims, dims+LENGTH(dims));
+
+    boost::shared_ptr<FdmLinearOpLayout> layout(new FdmLinearOpLayout(dim));
+
+    std::vector<std::pair<Real, Real> > boundaries;
+    boundaries.push_back(std::pair<Real, Real>(-1.0, 1.0));
+    boundaries.push_back(std::pair<Real, Real>( 0.0, 2.0));
+    boundaries.push_back(std::pair<Real, Real>( 0.5, 1.5));
+
+    boost::shared_ptr<FdmMesher> mesher(
+        new UniformGridMesher(layout, boundaries));
+
+    Array r(layout->size());
+    for (Size i=0; i < layout->size(); ++i)
+        r[i] = std::sin(0.1*i)+std::cos(0.35*i);
+
+    const Real a = -0.3, b = 1.0;
+    for (Size d=0; d < dim.size(); ++d) {
+        SecondDerivativeOp op(d, mesher);
+        op.axpyb(Array(1, 0.5), op, FirstDerivativeOp(d, mesher), Array());
+
+        const Array x = op.solve_splitting(r, a, b);
+        const Array y = a*op.apply(x) + b*x;
+        for (Size i=0; i < r.size(); ++i) {
+            if (std::fabs(y[i] - r[i]) > 1e-10) {
+                BOOST_FAIL("solve and apply are not consistent "
+                           << "\n direction     : " << d
+                           << "\n index         : " << i
+                           << "\n expected      : " << r[i]
+                           << "\n calculated    : " << y[i]);
+            }
+        }
+    }
+}
+
 void FdmLinearOpTest::testFdmHestonBarrier() {
 
     BOOST_TEST_MESSAGE("Testing FDM with barrier option in Heston model...");
@@ -1252,6 +1301,148 @@ namespace {
 #endif
 
 
+namespace {
+
+    // the operator-splitting steps, as written in the original papers
+    Disposable<Array> splittingStep(
+                        const boost::shared_ptr<FdmLinearOpComposite>& map,
+                        Size scheme, const Array& a, Time t, Time dt,
+                        Real theta, Real mu) {
+        map->setTime(std::max(0.0, t-dt), t);
+
+        Array y = a + dt*map->apply(a);
+        const Array y0 = y;
+        for (Size i=0; i < map->size(); ++i) {
+            Array rhs = y - theta*dt*map->apply_direction(i, a);
+            y = map->solve_splitting(i, rhs, -theta*dt);
+        }
+        if (scheme == 0)
+            return y;
+
+        Array yt;
+        if (scheme == 1)
+            yt = y0 + mu*dt*map->apply_mixed(y-a);
+        else if (scheme == 2)
+            yt = y0 + mu*dt*map->apply_mixed(y-a)
+                    + (0.5-mu)*dt*map->apply(y-a);
+        else
+            yt = y0 + mu*dt*map->apply(y-a);
+
+        const Array& u = (scheme == 3) ? y : a;
+        for (Size i=0; i < map->size(); ++i) {
+            Array rhs = yt - theta*dt*map->apply_direction(i, u);
+            yt = map->solve_splitting(i, rhs, -theta*dt);
+        }
+        return yt;
+    }
+}
+
+void FdmLinearOpTest::testSplittingSchemes() {
+    BOOST_TEST_MESSAGE("Testing operator-splitting schemes "
+                       "with Heston Hull-White operator...");
+
+    SavedSettings backup;
+
+    const Date today = Date(28, March, 2004);
+    Settings::instance().evaluationDate() = today;
+
+    const Time maturity = 1.0;
+    Size dims[] = {21, 11, 9};
+    const std::vector<Size> dim(dims, dims+LENGTH(dims));
+
+    boost::shared_ptr<HybridHestonHullWhiteProcess> jointProcess
+                                            = createHestonHullWhite(maturity);
+    const FdmSolverDesc desc = createSolverDesc(dim, jointProcess);
+    const boost::shared_ptr<FdmMesher> mesher = desc.mesher;
+
+    boost::shared_ptr<HullWhiteProcess> hwProcess(
+        new HullWhiteProcess(jointProcess->hestonProcess()->riskFreeRate(),
+                             jointProcess->hullWhiteProcess()->a(),
+                             jointProcess->hullWhiteProcess()->sigma()));
+
+    const boost::shared_ptr<FdmLinearOpComposite> op(
+        new FdmHestonHullWhiteOp(mesher, jointProcess->hestonProcess(),
+                                 hwProcess, jointProcess->eta()));
+
+    Array initial(mesher->layout()->size());
+    const FdmLinearOpIterator endIter = mesher->layout()->end();
+    for (FdmLinearOpIterator iter = mesher->layout()->begin();
+         iter != endIter; ++iter) {
+        initial[iter.index()] =
+            desc.calculator->avgInnerValue(iter, maturity);
+    }
+
+    const Real theta = 0.5+std::sqrt(3.0)/6.0, mu = 0.5;
+    const Size steps = 5;
+    const Time dt = 0.1;
+    const Real tol = 1e-12;
+    const std::string names[] = { "Douglas", "Craig-Sneyd",
+                                  "modified Craig-Sneyd", "Hundsdorfer" };
+
+    for (Size scheme=0; scheme < LENGTH(names); ++scheme) {
+        DouglasScheme douglas(theta, op);
+        CraigSneydScheme craigSneyd(theta, mu, op);
+        ModifiedCraigSneydScheme modifiedCraigSneyd(theta, mu, op);
+        HundsdorferScheme hundsdorfer(theta, mu, op);
+
+        Array a = initial, expected = initial;
+        for (Size i=0; i < steps; ++i) {
+            const Time t = maturity - i*dt;
+            expected = splittingStep(op, scheme, expected, t, dt, theta, mu);
+            switch (scheme) {
+              case 0:
+                douglas.setStep(dt);
+                douglas.step(a, t);
+                break;
+              case 1:
+                craigSneyd.setStep(dt);
+                craigSneyd.step(a, t);
+                break;
+              case 2:
+                modifiedCraigSneyd.setStep(dt);
+                modifiedCraigSneyd.step(a, t);
+                break;
+              default:
+                hundsdorfer.setStep(dt);
+                hundsdorfer.step(a, t);
+            }
+        }
+
+        const Real scale =
+            std::max(1.0, std::fabs(*std::max_element(expected.begin(),
+                                                      expected.end())));
+        for (Size i=0; i < a.size(); ++i) {
+            if (std::fabs(a[i] - expected[i]) > tol*scale)
+                BOOST_FAIL("failed to reproduce the " << names[scheme]
+                           << " scheme"
+                           << "\n    index:      " << i
+                           << "\n    expected:   " << expected[i]
+                           << "\n    calculated: " << a[i]);
+        }
+    }
+
+    // the results must not depend on the number of threads
+    std::vector<Real> x(3);
+    x[0] = std::log(100.0);
+    x[1] = jointProcess->hestonProcess()->v0();
+    x[2] = 0.0;
+
+    const Size threads[] = { 1, 2, 4 };
+    std::vector<Real> npvs;
+    for (Size i=0; i < LENGTH(threads); ++i) {
+        FdmNdimSolver<3> solver(desc, FdmSchemeDesc::CraigSneyd(), op,
+                                threads[i]);
+        npvs.push_back(solver.interpolateAt(x));
+    }
+    for (Size i=1; i < npvs.size(); ++i) {
+        if (npvs[i] != npvs.front())
+            BOOST_FAIL("results depend on the number of threads"
+                       << "\n    threads:    " << threads[i]
+                       << "\n    expected:   " << npvs.front()
+                       << "\n    calculated: " << npvs[i]);
+    }
+}
+
 void FdmLinearOpTest::testBiCGstab() {
 #if !defined(QL_NO_UBLAS_SUPPORT)
     BOOST_TEST_MESSAGE("Testing bi-conjugated gradient stabilized algorithm "
@@ -1310,6 +1501,354 @@ void FdmLinearOpTest::testBiCGstab() {
 #endif
 }
 
+void FdmLinearOpTest::testGMRES() {
+#if !defined(QL_NO_UBLAS_SUPPORT)
+    BOOST_TEST_MESSAGE("Testing GMRES algorithm with Heston operator...");
+
+    const Size n=41, m=21;
+    const Real theta = 1.0;
+    boost::numeric::ublas::compressed_matrix<Real> a(n*m, n*m);
+
+    for (Size i=0; i < n; ++i) {
+        for (Size j=0; j < m; ++j) {
+            const Size k = i*m+j;
+            a(k,k)=1.0;
+
+            if (i > 0 && j > 0 && i <n-1 && j < m-1) {
+                const Size im1 = i-1;
+                const Size ip1 = i+1;
+                const Size jm1 = j-1;
+                const Size jp1 = j+1;
+                const Real delta = theta/((ip1-im1)*(jp1-jm1));
+
+                a(k,im1*m+jm1) =  delta;
+                a(k,im1*m+jp1) = -delta;
+                a(k,ip1*m+jm1) = -delta;
+                a(k,ip1*m+jp1) =  delta;
+            }
+        }
+    }
+
+    boost::function<Disposable<Array>(const Array&)> matmult(
+                                                    boost::bind(&axpy, a, _1));
+
+    SparseILUPreconditioner ilu(a, 4);
+    boost::function<Disposable<Array>(const Array&)> precond(
+         boost::bind(&SparseILUPreconditioner::apply, &ilu, _1));
+
+    Array b(n*m);
+    MersenneTwisterUniformRng rng(1234);
+    for (Size i=0; i < b.size(); ++i) {
+        b[i] = rng.next().value;
+    }
+
+    const Real tol = 1e-10;
+
+    const GMRES gmres(matmult, n*m, tol, precond);
+    const GMRESResult result = gmres.solve(b);
+    Array x = result.x;
+
+    Real error = std::sqrt(DotProduct(b-axpy(a, x),
+                           b-axpy(a, x))/DotProduct(b,b));
+
+    if (error > tol) {
+        BOOST_FAIL("Error calculating the inverse using GMRES" <<
+                "\n tolerance:  " << tol <<
+                "\n error:      " << error);
+    }
+    if (std::fabs(result.errors.back() - error) > 10*QL_EPSILON) {
+        BOOST_FAIL("Error reported by GMRES is inconsistent" <<
+                "\n reported:   " << result.errors.back() <<
+                "\n calculated: " << error);
+    }
+    if (result.iterations != result.errors.size()-1) {
+        BOOST_FAIL("Number of iterations reported by GMRES is inconsistent" <<
+                "\n reported:   " << result.iterations <<
+                "\n errors:     " << result.errors.size());
+    }
+
+    // without preconditioner and with restarts
+    const Size maxIter = 10;
+    const GMRES gmresRestart(matmult, maxIter, tol);
+    const GMRESResult restartResult = gmresRestart.solveWithRestart(100, b);
+    x = restartResult.x;
+
+    // each cycle but the last one runs maxIter iterations
+    // and adds the error of its initial guess
+    const Size cycles = (restartResult.iterations + maxIter - 1)/maxIter;
+    if (cycles < 2
+        || restartResult.iterations + cycles != restartResult.errors.size()) {
+        BOOST_FAIL("Number of iterations reported by GMRES with restarts "
+                   "is inconsistent" <<
+                   "\n reported:   " << restartResult.iterations <<
+                   "\n errors:     " << restartResult.errors.size());
+    }
+
+    error = std::sqrt(DotProduct(b-axpy(a, x),
+                      b-axpy(a, x))/DotProduct(b,b));
+
+    if (error > tol) {
+        BOOST_FAIL("Error calculating the inverse using GMRES with restarts" <<
+                "\n tolerance:  " << tol <<
+                "\n error:      " << error);
+    }
+#endif
+}
+
+void FdmLinearOpTest::testImplicitEulerSolvers() {
+
+    BOOST_TEST_MESSAGE("Testing linear solvers of the implicit Euler scheme "
+                       "with Heston operator...");
+
+    SavedSettings backup;
+
+    const DayCounter dc = Actual365Fixed();
+    const Date today = Date(21, April, 2015);
+    Settings::instance().evaluationDate() = today;
+
+    const Handle<Quote> spot(boost::shared_ptr<Quote>(new SimpleQuote(100.0)));
+    const Handle<YieldTermStructure> rTS(flatRate(today, 0.05, dc));
+    const Handle<YieldTermStructure> qTS(flatRate(today, 0.02, dc));
+
+    const boost::shared_ptr<HestonProcess> hestonProcess(
+        new HestonProcess(rTS, qTS, spot, 0.04, 1.0, 0.04, 0.4, -0.7));
+
+    const Size xGrid = 41, vGrid = 21;
+    const boost::shared_ptr<Fdm1dMesher> equityMesher(
+        new Uniform1dMesher(std::log(50.0), std::log(200.0), xGrid));
+    const boost::shared_ptr<Fdm1dMesher> varianceMesher(
+        new Uniform1dMesher(0.0, 0.5, vGrid));
+    const boost::shared_ptr<FdmMesher> mesher(
+        new FdmMesherComposite(equityMesher, varianceMesher));
+
+    const boost::shared_ptr<FdmLinearOpComposite> op(
+        new FdmHestonOp(mesher, hestonProcess));
+
+    Array initial(mesher->layout()->size());
+    const FdmLinearOpIterator endIter = mesher->layout()->end();
+    for (FdmLinearOpIterator iter = mesher->layout()->begin();
+         iter != endIter; ++iter) {
+        initial[iter.index()] =
+            std::max(std::exp(mesher->location(iter, 0)) - 100.0, 0.0);
+    }
+
+    const Time maturity = 1.0;
+    const Size timeSteps = 10;
+    const Real relTol = 1e-10;
+
+    ImplicitEulerScheme::SolverType solverTypes[] = {
+        ImplicitEulerScheme::BiCGstab, ImplicitEulerScheme::GMRES };
+
+    std::vector<Array> results;
+    for (Size i=0; i < LENGTH(solverTypes); ++i) {
+        FiniteDifferenceModel<ImplicitEulerScheme> model(
+            ImplicitEulerScheme(op, FdmBoundaryConditionSet(),
+                                relTol, solverTypes[i]));
+
+        Array a = initial;
+        model.rollback(a, maturity, 0.0, timeSteps);
+        results.push_back(a);
+
+        const Size iterations = model.evolver().numberOfIterations();
+        if (iterations == 0 || iterations > 100*timeSteps)
+            BOOST_FAIL("unexpected number of iterations"
+                       << "\n solver:     " << i
+                       << "\n iterations: " << iterations);
+    }
+
+    const Real tol = 1e-6;
+    for (Size i=0; i < initial.size(); ++i) {
+        if (std::fabs(results[0][i] - results[1][i]) > tol)
+            BOOST_FAIL("BiCGstab and GMRES results are inconsistent"
+                       << "\n index:      " << i
+                       << "\n BiCGstab:   " << results[0][i]
+                       << "\n GMRES:      " << results[1][i]);
+    }
+}
+
+void FdmLinearOpTest::testBandedLUSolver() {
+#if !defined(QL_NO_UBLAS_SUPPORT)
+    BOOST_TEST_MESSAGE("Testing banded LU solver of the implicit Euler "
+                       "and Crank-Nicolson schemes...");
+
+    SavedSettings backup;
+
+    // a banded system which needs row interchanges
+    const Size n = 40, kl = 3, ku = 5;
+    SparseMatrix m(n, n);
+    MersenneTwisterUniformRng rng(1234);
+    for (Size i=0; i < n; ++i) {
+        for (Size j=((i > kl) ? i-kl : 0); j <= std::min(n-1, i+ku); ++j) {
+            m(i, j) = rng.next().value - 0.5;
+        }
+        if (i % 3 == 0)
+            m(i, i) = 1e-3*m(i, i);
+    }
+
+    Array x(n);
+    for (Size i=0; i < n; ++i)
+        x[i] = rng.next().value;
+
+    const BandedLUDecomposition lu(m);
+    const Array calculated = lu.solve(prod(m, x));
+    if (lu.lowerBandwidth() != kl || lu.upperBandwidth() != ku)
+        BOOST_FAIL("wrong bandwidth of the banded LU decomposition"
+                   << "\n lower:      " << lu.lowerBandwidth()
+                   << "\n upper:      " << lu.upperBandwidth());
+    for (Size i=0; i < n; ++i) {
+        if (std::fabs(calculated[i] - x[i]) > 1e-10)
+            BOOST_FAIL("banded LU decomposition failed to solve the system"
+                       << "\n index:      " << i
+                       << "\n expected:   " << x[i]
+                       << "\n calculated: " << calculated[i]);
+    }
+
+    const DayCounter dc = Actual365Fixed();
+    const Date today = Date(21, April, 2015);
+    Settings::instance().evaluationDate() = today;
+
+    const Handle<Quote> spot(boost::shared_ptr<Quote>(new SimpleQuote(100.0)));
+    const Handle<YieldTermStructure> qTS(flatRate(today, 0.02, dc));
+
+    std::vector<Date> dates;
+    dates.push_back(today);
+    dates.push_back(today + Period(2, Years));
+    std::vector<Rate> rates;
+    rates.push_back(0.01);
+    rates.push_back(0.08);
+
+    // flat rates give a time-homogeneous operator, a steep
+    // zero curve one that changes at every step
+    const Handle<YieldTermStructure> rTS[] = {
+        Handle<YieldTermStructure>(flatRate(today, 0.05, dc)),
+        Handle<YieldTermStructure>(
+            boost::shared_ptr<YieldTermStructure>(
+                                         new ZeroCurve(dates, rates, dc)))
+    };
+
+    const Size xGrid = 41, vGrid = 21;
+    const boost::shared_ptr<FdmMesher> mesher(
+        new FdmMesherComposite(
+            boost::shared_ptr<Fdm1dMesher>(
+                new Uniform1dMesher(std::log(50.0), std::log(200.0), xGrid)),
+            boost::shared_ptr<Fdm1dMesher>(
+                new Uniform1dMesher(0.0, 0.5, vGrid))));
+
+    Array initial(mesher->layout()->size());
+    const FdmLinearOpIterator endIter = mesher->layout()->end();
+    for (FdmLinearOpIterator iter = mesher->layout()->begin();
+         iter != endIter; ++iter) {
+        initial[iter.index()] =
+            std::max(std::exp(mesher->location(iter, 0)) - 100.0, 0.0);
+    }
+
+    const Time maturity = 1.0;
+    const Size timeSteps = 10;
+    const Real relTol = 1e-10;
+    const Real tol = 1e-6;
+
+    for (Size i=0; i < LENGTH(rTS); ++i) {
+        const boost::shared_ptr<FdmLinearOpComposite> op(
+            new FdmHestonOp(mesher, boost::shared_ptr<HestonProcess>(
+                new HestonProcess(rTS[i], qTS, spot,
+                                  0.04, 1.0, 0.04, 0.4, -0.7))));
+
+        const Size expectedFactorizations = (i == 0) ? 1 : timeSteps;
+
+        FiniteDifferenceModel<ImplicitEulerScheme> iterative(
+            ImplicitEulerScheme(op, FdmBoundaryConditionSet(),
+                                relTol, ImplicitEulerScheme::BiCGstab));
+        FiniteDifferenceModel<ImplicitEulerScheme> direct(
+            ImplicitEulerScheme(op, FdmBoundaryConditionSet(),
+                                relTol, ImplicitEulerScheme::BandedLU));
+
+        Array expected = initial, calculated = initial;
+        iterative.rollback(expected, maturity, 0.0, timeSteps);
+        direct.rollback(calculated, maturity, 0.0, timeSteps);
+
+        const Size factorizations = direct.evolver().numberOfFactorizations();
+        if (factorizations != expectedFactorizations)
+            BOOST_FAIL("unexpected number of factorizations for the "
+                       "implicit Euler scheme"
+                       << "\n curve:      " << i
+                       << "\n expected:   " << expectedFactorizations
+                       << "\n calculated: " << factorizations);
+
+        for (Size j=0; j < initial.size(); ++j) {
+            if (std::fabs(expected[j] - calculated[j]) > tol)
+                BOOST_FAIL("banded LU and BiCGstab results of the implicit "
+                           "Euler scheme are inconsistent"
+                           << "\n curve:      " << i
+                           << "\n index:      " << j
+                           << "\n BiCGstab:   " << expected[j]
+                           << "\n banded LU:  " << calculated[j]);
+        }
+
+        // in one dimension, the Douglas scheme with theta=0.5
+        // is the Crank-Nicolson scheme
+        const boost::shared_ptr<FdmMesher> bsMesher(
+            new FdmMesherComposite(boost::shared_ptr<Fdm1dMesher>(
+                new Uniform1dMesher(std::log(50.0), std::log(200.0), 101))));
+        const boost::shared_ptr<FdmLinearOpComposite> bsOp(
+            new FdmBlackScholesOp(bsMesher,
+                boost::shared_ptr<GeneralizedBlackScholesProcess>(
+                    new BlackScholesMertonProcess(
+                        spot, qTS, rTS[i],
+                        Handle<BlackVolTermStructure>(
+                                            flatVol(today, 0.25, dc)))),
+                100.0));
+
+        Array bsInitial(bsMesher->layout()->size());
+        const FdmLinearOpIterator bsEndIter = bsMesher->layout()->end();
+        for (FdmLinearOpIterator iter = bsMesher->layout()->begin();
+             iter != bsEndIter; ++iter) {
+            bsInitial[iter.index()] =
+                std::max(std::exp(bsMesher->location(iter, 0)) - 100.0, 0.0);
+        }
+
+        expected = bsInitial;
+        FdmBackwardSolver(bsOp, FdmBoundaryConditionSet(),
+                          boost::shared_ptr<FdmStepConditionComposite>(),
+                          FdmSchemeDesc::Douglas())
+            .rollback(expected, maturity, 0.0, timeSteps, 0);
+
+        FiniteDifferenceModel<CrankNicolsonScheme> cnDirect(
+            CrankNicolsonScheme(0.5, bsOp, FdmBoundaryConditionSet(),
+                                relTol, ImplicitEulerScheme::BandedLU));
+        calculated = bsInitial;
+        cnDirect.rollback(calculated, maturity, 0.0, timeSteps);
+
+        // the scheme description of the backward solver
+        Array cnSolved = bsInitial;
+        FdmBackwardSolver(bsOp, FdmBoundaryConditionSet(),
+                          boost::shared_ptr<FdmStepConditionComposite>(),
+                          FdmSchemeDesc::CrankNicolson())
+            .rollback(cnSolved, maturity, 0.0, timeSteps, 0);
+
+        const Size cnFactorizations =
+            cnDirect.evolver().numberOfFactorizations();
+        if (cnFactorizations != expectedFactorizations)
+            BOOST_FAIL("unexpected number of factorizations for the "
+                       "Crank-Nicolson scheme"
+                       << "\n curve:      " << i
+                       << "\n expected:   " << expectedFactorizations
+                       << "\n calculated: " << cnFactorizations);
+
+        for (Size j=0; j < bsInitial.size(); ++j) {
+            if (std::fabs(expected[j] - calculated[j]) > tol
+                || std::fabs(expected[j] - cnSolved[j]) > tol)
+                BOOST_FAIL("Crank-Nicolson and Douglas results "
+                           "are inconsistent"
+                           << "\n curve:      " << i
+                           << "\n index:      " << j
+                           << "\n Douglas:    " << expected[j]
+                           << "\n banded LU:  " << calculated[j]
+                           << "\n BiCGstab:   " << cnSolved[j]);
+        }
+    }
+#endif
+}
+
 void FdmLinearOpTest::testCrankNicolsonWithDamping() {
 
     BOOST_TEST_MESSAGE("Testing Crank-Nicolson with initial implicit damping steps "
@@ -1402,6 +1941,153 @@ void FdmLinearOpTest::testCrankNicolsonWithDamping() {
     }
 }
 
+void FdmLinearOpTest::testAdaptiveTimeStepping() {
+
+    BOOST_TEST_MESSAGE("Testing adaptive time stepping and Richardson "
+                       "extrapolation of the backward solver...");
+
+    SavedSettings backup;
+
+    DayCounter dc = Actual360();
+    Date today = Date::todaysDate();
+
+    boost::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    boost::shared_ptr<YieldTermStructure> qTS = flatRate(today, 0.02, dc);
+    boost::shared_ptr<YieldTermStructure> rTS = flatRate(today, 0.05, dc);
+    boost::shared_ptr<BlackVolTermStructure> volTS = flatVol(today, 0.25, dc);
+
+    boost::shared_ptr<BlackScholesMertonProcess> process(new
+        BlackScholesMertonProcess(Handle<Quote>(spot),
+                                  Handle<YieldTermStructure>(qTS),
+                                  Handle<YieldTermStructure>(rTS),
+                                  Handle<BlackVolTermStructure>(volTS)));
+
+    boost::shared_ptr<StrikedTypePayoff> payoff(
+                                   new PlainVanillaPayoff(Option::Put, 105));
+    const Time maturity = 1.0;
+
+    const Size xGrid = 200, dampingSteps = 2;
+    const boost::shared_ptr<Fdm1dMesher> equityMesher(
+        new FdmBlackScholesMesher(
+                xGrid, process, maturity, payoff->strike(),
+                Null<Real>(), Null<Real>(), 0.0001, 1.5,
+                std::pair<Real, Real>(payoff->strike(), 0.1)));
+    const boost::shared_ptr<FdmMesher> mesher(
+                                    new FdmMesherComposite(equityMesher));
+    const boost::shared_ptr<FdmLinearOpLayout> layout = mesher->layout();
+
+    boost::shared_ptr<FdmBlackScholesOp> map(
+                     new FdmBlackScholesOp(mesher, process, payoff->strike()));
+
+    boost::shared_ptr<FdmInnerValueCalculator> calculator(
+                                  new FdmLogInnerValue(payoff, mesher, 0));
+
+    Array initialValues(layout->size());
+    const FdmLinearOpIterator endIter = layout->end();
+    for (FdmLinearOpIterator iter = layout->begin(); iter != endIter;
+         ++iter) {
+        initialValues[iter.index()]
+            = calculator->avgInnerValue(iter, maturity);
+    }
+    const std::vector<Real>& x = equityMesher->locations();
+    const Real logSpot = std::log(spot->value());
+
+    FdmBackwardSolver solver(map, FdmBoundaryConditionSet(),
+                             boost::shared_ptr<FdmStepConditionComposite>(),
+                             FdmSchemeDesc::Douglas());
+
+    // reference values, converged in time on the given spatial grid
+    Array rhs = initialValues;
+    solver.rollback(rhs, maturity, 0.0, 2000, dampingSteps);
+    const Real expected = MonotonicCubicNaturalSpline(
+                                x.begin(), x.end(), rhs.begin())(logSpot);
+
+    const Size fixedSteps = 50;
+    rhs = initialValues;
+    solver.rollback(rhs, maturity, 0.0, fixedSteps, dampingSteps);
+    const Real fixedError = std::fabs(expected - MonotonicCubicNaturalSpline(
+                                x.begin(), x.end(), rhs.begin())(logSpot));
+
+    // extrapolation from half the steps must do much better
+    rhs = initialValues;
+    solver.rollbackExtrapolated(rhs, maturity, 0.0,
+                                fixedSteps/2, dampingSteps/2);
+    const Real extrapolatedError = std::fabs(expected
+        - MonotonicCubicNaturalSpline(x.begin(), x.end(), rhs.begin())(logSpot));
+
+    if (extrapolatedError > 0.1*fixedError) {
+        BOOST_FAIL("Richardson extrapolation failed to reduce the error"
+                   << "\n    steps:                " << fixedSteps
+                   << "\n    error without:        " << fixedError
+                   << "\n    error with:           " << extrapolatedError);
+    }
+
+    const Real tol = 1e-5;
+    rhs = initialValues;
+    solver.rollbackAdaptive(rhs, maturity, 0.0, tol, 10, dampingSteps);
+    const Real adaptiveError = std::fabs(expected
+        - MonotonicCubicNaturalSpline(x.begin(), x.end(), rhs.begin())(logSpot));
+
+    if (adaptiveError > tol*payoff->strike()
+        || solver.numberOfSteps() > 4*fixedSteps) {
+        BOOST_FAIL("Adaptive time stepping failed to reach the "
+                   "given tolerance efficiently"
+                   << "\n    tolerance:   " << tol
+                   << "\n    error:       " << adaptiveError
+                   << "\n    steps taken: " << solver.numberOfSteps());
+    }
+
+    // the same time stepping through the solver description of an engine
+    VanillaOption option(payoff, boost::shared_ptr<Exercise>(
+                new EuropeanExercise(today + Period(360, Days))));
+
+    option.setPricingEngine(boost::shared_ptr<PricingEngine>(
+        new FdBlackScholesVanillaEngine(process, 2000, xGrid, dampingSteps)));
+    const Real expectedNPV = option.NPV();
+
+    option.setPricingEngine(boost::shared_ptr<PricingEngine>(
+        new FdBlackScholesVanillaEngine(process, fixedSteps, xGrid,
+                                        dampingSteps)));
+    const Real fixedNPVError = std::fabs(option.NPV() - expectedNPV);
+    if (option.result<Size>("timeSteps") != fixedSteps + dampingSteps) {
+        BOOST_FAIL("wrong number of time steps reported by the engine"
+                   << "\n    expected:   " << fixedSteps + dampingSteps
+                   << "\n    calculated: "
+                   << option.result<Size>("timeSteps"));
+    }
+
+    option.setPricingEngine(boost::shared_ptr<PricingEngine>(
+        new FdBlackScholesVanillaEngine(process, fixedSteps/2, xGrid,
+                                        dampingSteps/2,
+                                        FdmSchemeDesc::Douglas(), false,
+                                        -Null<Real>(),
+                                        FdmSolverDesc::ExtrapolatedSteps)));
+    const Real extrapolatedNPVError = std::fabs(option.NPV() - expectedNPV);
+    if (extrapolatedNPVError > 0.1*fixedNPVError) {
+        BOOST_FAIL("Richardson extrapolation failed to reduce the error "
+                   "of the engine"
+                   << "\n    steps:                " << fixedSteps
+                   << "\n    error without:        " << fixedNPVError
+                   << "\n    error with:           " << extrapolatedNPVError);
+    }
+
+    option.setPricingEngine(boost::shared_ptr<PricingEngine>(
+        new FdBlackScholesVanillaEngine(process, 10, xGrid, dampingSteps,
+                                        FdmSchemeDesc::Douglas(), false,
+                                        -Null<Real>(),
+                                        FdmSolverDesc::AdaptiveSteps, tol)));
+    const Real adaptiveNPVError = std::fabs(option.NPV() - expectedNPV);
+    const Size adaptiveSteps = option.result<Size>("timeSteps");
+    if (adaptiveNPVError > tol*payoff->strike()
+        || adaptiveSteps > 4*fixedSteps) {
+        BOOST_FAIL("Adaptive time stepping of the engine failed to reach "
+                   "the given tolerance efficiently"
+                   << "\n    tolerance:   " << tol
+                   << "\n    error:       " << adaptiveNPVError
+                   << "\n    steps taken: " << adaptiveSteps);
+    }
+}
+
 void FdmLinearOpTest::testSpareMatrixReference() {
 #ifndef QL_NO_UBLAS_SUPPORT
     BOOST_TEST_MESSAGE("Testing SparseMatrixReference type...");
@@ -1483,6 +2169,53 @@ void FdmLinearOpTest::testSparseMatrixZeroAssignment() {
 #endif
 }
 
+void FdmLinearOpTest::testInnerValues() {
+    BOOST_TEST_MESSAGE("Testing inner values on whole grids...");
+
+    const boost::shared_ptr<FdmMesherComposite> mesher(
+        new FdmMesherComposite(
+            boost::shared_ptr<Fdm1dMesher>(new Uniform1dMesher(0.0, 1.0, 5)),
+            boost::shared_ptr<Fdm1dMesher>(new Concentrating1dMesher(
+                std::log(50.0), std::log(200.0), 31,
+                std::pair<Real, Real>(std::log(100.0), 0.1))),
+            boost::shared_ptr<Fdm1dMesher>(new Uniform1dMesher(0.0, 1.0, 3))));
+    const boost::shared_ptr<FdmLinearOpLayout> layout = mesher->layout();
+
+    const boost::shared_ptr<Payoff> payoff(
+                                new PlainVanillaPayoff(Option::Put, 100.0));
+    const boost::shared_ptr<FdmInnerValueCalculator> calculator(
+                                new FdmLogInnerValue(payoff, mesher, 1));
+
+    Array a(layout->size());
+    for (FdmLinearOpIterator iter = layout->begin();
+         iter != layout->end(); ++iter) {
+        a[iter.index()] = 10.0*mesher->location(iter, 0);
+    }
+    Array b(a);
+    FdmAmericanStepCondition(mesher, calculator).applyTo(b, 0.5);
+
+    const Array innerValues = calculator->innerValues(layout, 0.5);
+
+    const Real tol = 1e-14;
+    for (FdmLinearOpIterator iter = layout->begin();
+         iter != layout->end(); ++iter) {
+        const Size i = iter.index();
+        const Real expected
+            = (*payoff)(std::exp(mesher->location(iter, 1)));
+
+        if (std::fabs(innerValues[i] - expected) > tol
+            || std::fabs(calculator->innerValue(iter, 0.5) - expected) > tol
+            || std::fabs(b[i] - std::max(a[i], expected)) > tol) {
+            BOOST_FAIL("inner value mismatch at index " << i
+                       << "\n    expected:        " << expected
+                       << "\n    on the grid:     " << innerValues[i]
+                       << "\n    at the point:    "
+                       << calculator->innerValue(iter, 0.5)
+                       << "\n    after exercise:  " << b[i]);
+        }
+    }
+}
+
 void FdmLinearOpTest::testFdmMesherIntegral() {
     BOOST_TEST_MESSAGE("Testing integrals over meshers functions...");
 
@@ -1539,6 +2272,61 @@ void FdmLinearOpTest::testFdmMesherIntegral() {
 }
 
 
+void FdmLinearOpTest::testApplyInto() {
+
+    BOOST_TEST_MESSAGE("Testing in-place application of linear operators...");
+
+    Size dims[] = {20, 15};
+    const std::vector<Size> dim(dims, dims+LENGTH(dims));
+
+    boost::shared_ptr<FdmLinearOpLayout> index(new FdmLinearOpLayout(dim));
+
+    std::vector<std::pair<Real, Real> > boundaries;
+    boundaries.push_back(std::pair<Real, Real>(-1.0, 1.0));
+    boundaries.push_back(std::pair<Real, Real>( 0.0, 2.0));
+
+    boost::shared_ptr<FdmMesher> mesher(
+        new UniformGridMesher(index, boundaries));
+
+    Array r(index->size());
+    const FdmLinearOpIterator endIter = index->end();
+    for (FdmLinearOpIterator iter = index->begin(); iter != endIter; ++iter) {
+        const Real x = mesher->location(iter, 0);
+        const Real y = mesher->location(iter, 1);
+        r[iter.index()] = std::sin(x)*std::exp(y);
+    }
+
+    std::vector<boost::shared_ptr<FdmLinearOp> > ops;
+    ops.push_back(boost::shared_ptr<FdmLinearOp>(
+                                        new FirstDerivativeOp(0, mesher)));
+    ops.push_back(boost::shared_ptr<FdmLinearOp>(
+                                        new SecondDerivativeOp(1, mesher)));
+    ops.push_back(boost::shared_ptr<FdmLinearOp>(
+                            new SecondOrderMixedDerivativeOp(0, 1, mesher)));
+
+    for (Size i=0; i < ops.size(); ++i) {
+        const Array expected = ops[i]->apply(r);
+
+        // empty, wrongly sized and correctly sized results
+        Array results[] = { Array(), Array(3, 1.0), Array(r.size(), 1.0) };
+        for (Size j=0; j < LENGTH(results); ++j) {
+            ops[i]->apply_into(r, results[j]);
+            if (results[j].size() != expected.size())
+                BOOST_FAIL("wrong result size for operator " << i
+                           << "\n    expected:   " << expected.size()
+                           << "\n    calculated: " << results[j].size());
+            for (Size k=0; k < expected.size(); ++k) {
+                if (results[j][k] != expected[k])
+                    BOOST_FAIL("apply_into differs from apply "
+                               "for operator " << i
+                               << "\n    index:      " << k
+                               << "\n    expected:   " << expected[k]
+                               << "\n    calculated: " << results[j][k]);
+            }
+        }
+    }
+}
+
 test_suite* FdmLinearOpTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("linear operator tests");
 
@@ -1556,18 +2344,29 @@ test_suite* FdmLinearOpTest::suite() {
         &FdmLinearOpTest::testSecondOrderMixedDerivativesMapApply));
     suite->add(
         QUANTLIB_TEST_CASE(&FdmLinearOpTest::testTripleBandMapSolve));
+    suite->add(
+        QUANTLIB_TEST_CASE(&FdmLinearOpTest::testTripleBandMapSolveOnLines));
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testFdmHestonBarrier));
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testFdmHestonAmerican));
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testFdmHestonExpress));
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testFdmHestonHullWhiteOp));
+    suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testSplittingSchemes));
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testBiCGstab));
+    suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testGMRES));
+    suite->add(
+        QUANTLIB_TEST_CASE(&FdmLinearOpTest::testImplicitEulerSolvers));
+    suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testBandedLUSolver));
     suite->add(
         QUANTLIB_TEST_CASE(&FdmLinearOpTest::testCrankNicolsonWithDamping));
+    suite->add(
+        QUANTLIB_TEST_CASE(&FdmLinearOpTest::testAdaptiveTimeStepping));
     suite->add(
         QUANTLIB_TEST_CASE(&FdmLinearOpTest::testSpareMatrixReference));
     suite->add(
         QUANTLIB_TEST_CASE(&FdmLinearOpTest::testSparseMatrixZeroAssignment));
+    suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testInnerValues));
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testFdmMesherIntegral));
+    suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testApplyInto));
 
     return suite;
     
@@ -36,15 +36,23 @@ public:
     static void testDerivativeWeightsOnNonUniformGrids();
     static void testSecondOrderMixedDerivativesMapApply();
     static void testTripleBandMapSolve();
+    static void testTripleBandMapSolveOnLines();
     static void testFdmHestonBarrier();
     static void testFdmHestonAmerican();
     static void testFdmHestonExpress();
     static void testFdmHestonHullWhiteOp();
+    static void testSplittingSchemes();
     static void testBiCGstab();
+    static void testGMRES();
+    static void testImplicitEulerSolvers();
+    static void testBandedLUSolver();
     static void testCrankNicolsonWithDamping();
+    static void testAdaptiveTimeStepping();
     static void testSpareMatrixReference();
     static void testSparseMatrixZeroAssignment();
+    static void testInnerValues();
     static void testFdmMesherIntegral();
+    static void testApplyInto();
 
     static boost::unit_test_framework::test_suite* suite();
 };
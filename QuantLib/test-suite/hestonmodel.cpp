@@ -28,6 +28,7 @@
 #include <ql/models/equity/piecewisetimedependenthestonmodel.hpp>
 #include <ql/pricingengines/vanilla/analyticdividendeuropeanengine.hpp>
 #include <ql/pricingengines/vanilla/analytichestonengine.hpp>
+#include <ql/pricingengines/vanilla/coshestonengine.hpp>
 #include <ql/pricingengines/vanilla/hestonexpansionengine.hpp>
 #include <ql/pricingengines/vanilla/fdamericanengine.hpp>
 #include <ql/pricingengines/vanilla/fddividendeuropeanengine.hpp>
@@ -1505,6 +1506,218 @@ void HestonModelTest::testExpansionOnFordeReference() {
     }
 }
 
+void HestonModelTest::testStrikeStripCaching() {
+    BOOST_TEST_MESSAGE("Testing cached Heston pricing of strike strips...");
+
+    SavedSettings backup;
+
+    const Date settlementDate(27, December, 2004);
+    Settings::instance().evaluationDate() = settlementDate;
+
+    const DayCounter dayCounter = ActualActual();
+
+    Handle<YieldTermStructure> riskFreeTS(flatRate(0.05, dayCounter));
+    Handle<YieldTermStructure> dividendTS(flatRate(0.03, dayCounter));
+    Handle<Quote> s0(boost::shared_ptr<Quote>(new SimpleQuote(1.0)));
+
+    boost::shared_ptr<HestonProcess> process(new HestonProcess(
+        riskFreeTS, dividendTS, s0, 0.07, 2.0, 0.04, 0.55, -0.8));
+    boost::shared_ptr<HestonModel> model(new HestonModel(process));
+
+    const Real strikes[] = { 0.5, 0.7, 1.0, 1.25, 1.5, 2.0 };
+    const Integer maturities[] = { 1, 3, 12, 60 };
+    const Option::Type types[] ={ Option::Put, Option::Call };
+
+    std::vector<AnalyticHestonEngine::Integration> integrations;
+    std::vector<AnalyticHestonEngine::ComplexLogFormula> formulas;
+    integrations.push_back(
+        AnalyticHestonEngine::Integration::gaussLaguerre(128));
+    formulas.push_back(AnalyticHestonEngine::Gatheral);
+    integrations.push_back(
+        AnalyticHestonEngine::Integration::gaussLaguerre(128));
+    formulas.push_back(AnalyticHestonEngine::BranchCorrection);
+    integrations.push_back(
+        AnalyticHestonEngine::Integration::gaussLegendre(256));
+    formulas.push_back(AnalyticHestonEngine::Gatheral);
+
+    const Real tol = 1e-12;
+    for (Size l=0; l < integrations.size(); ++l) {
+        boost::shared_ptr<AnalyticHestonEngine> engine(
+            new AnalyticHestonEngine(model, formulas[l], integrations[l]));
+
+        for (Size n=0; n < 2; ++n) {
+            for (Size i=0; i < LENGTH(maturities); ++i) {
+                const Date maturityDate =
+                    settlementDate + Period(maturities[i], Months);
+                boost::shared_ptr<Exercise> exercise(
+                                        new EuropeanExercise(maturityDate));
+                const Real term = process->time(maturityDate);
+
+                for (Size j=0; j < LENGTH(strikes); ++j) {
+                    for (Size k=0; k < LENGTH(types); ++k) {
+                        boost::shared_ptr<PlainVanillaPayoff> payoff(
+                            new PlainVanillaPayoff(types[k], strikes[j]));
+
+                        VanillaOption option(payoff, exercise);
+                        option.setPricingEngine(engine);
+                        const Real calculated = option.NPV();
+
+                        // only the first option of each maturity
+                        // evaluates the integrands
+                        if ((j != 0 || k != 0)
+                            && engine->numberOfEvaluations() != 0)
+                            BOOST_ERROR("characteristic function "
+                                        "evaluated for cached maturity"
+                                        << "\n    evaluations: "
+                                        << engine->numberOfEvaluations());
+
+                        Real expected;
+                        Size evaluations;
+                        AnalyticHestonEngine::doCalculation(
+                            riskFreeTS->discount(maturityDate),
+                            dividendTS->discount(maturityDate),
+                            s0->value(), strikes[j], term,
+                            model->kappa(), model->theta(), model->sigma(),
+                            model->v0(), model->rho(), *payoff,
+                            integrations[l], formulas[l], 0,
+                            expected, evaluations);
+
+                        if (std::fabs(calculated-expected) > tol) {
+                            BOOST_ERROR("failed to reproduce uncached "
+                                        "Heston price"
+                                        << "\n    integration: " << l
+                                        << "\n    maturity:    "
+                                        << maturityDate
+                                        << "\n    strike:      "
+                                        << strikes[j]
+                                        << "\n    type:        " << types[k]
+                                        << QL_SCIENTIFIC
+                                        << "\n    calculated:  " << calculated
+                                        << "\n    expected:    " << expected
+                                        << "\n    difference:  "
+                                        << calculated-expected);
+                        }
+                    }
+                }
+            }
+
+            // the cached values must be dropped when the model changes
+            Array params = model->params();
+            params[3] = -0.5;
+            model->setParams(params);
+        }
+        Array params = model->params();
+        params[3] = -0.8;
+        model->setParams(params);
+    }
+}
+
+void HestonModelTest::testCOSHestonEngine() {
+    BOOST_TEST_MESSAGE("Testing Heston COS engine against analytic values...");
+
+    SavedSettings backup;
+
+    const Date settlementDate(27, December, 2004);
+    Settings::instance().evaluationDate() = settlementDate;
+
+    const DayCounter dayCounter = ActualActual();
+
+    Handle<YieldTermStructure> riskFreeTS(flatRate(0.05, dayCounter));
+    Handle<YieldTermStructure> dividendTS(flatRate(0.03, dayCounter));
+    Handle<Quote> s0(boost::shared_ptr<Quote>(new SimpleQuote(100.0)));
+
+    const Real strikes[] = { 60.0, 80.0, 90.0, 100.0, 110.0, 125.0, 150.0 };
+    const Integer maturities[] = { 1, 3, 12, 60, 120 };
+    const Option::Type types[] ={ Option::Put, Option::Call };
+
+    const HestonParameter equityfx     = { 0.07, 2.0, 0.04, 0.55, -0.8 };
+    const HestonParameter lowVolOfVol  = { 0.07, 1.0, 0.04, 0.025, -0.75 };
+    const HestonParameter highVolOfVol = { 0.04, 1.5, 0.04, 1.0, -0.6 };
+
+    std::vector<HestonParameter> params;
+    params.push_back(equityfx);
+    params.push_back(lowVolOfVol);
+    params.push_back(highVolOfVol);
+
+    // heavier tails need a wider truncation range and more terms
+    const Real L[] = { 16, 16, 32 };
+    const Size N[] = { 200, 200, 1000 };
+
+    const Real tol = 1e-6;
+    for (Size l=0; l < params.size(); ++l) {
+        boost::shared_ptr<HestonModel> model(new HestonModel(
+            boost::shared_ptr<HestonProcess>(new HestonProcess(
+                riskFreeTS, dividendTS, s0, params[l].v0, params[l].kappa,
+                params[l].theta, params[l].sigma, params[l].rho))));
+
+        boost::shared_ptr<PricingEngine> cosEngine(
+                                    new COSHestonEngine(model, L[l], N[l]));
+        boost::shared_ptr<PricingEngine> analyticEngine(
+                                    new AnalyticHestonEngine(model, 192));
+
+        for (Size i=0; i < LENGTH(maturities); ++i) {
+            boost::shared_ptr<Exercise> exercise(
+                new EuropeanExercise(settlementDate
+                                     + Period(maturities[i], Months)));
+
+            for (Size j=0; j < LENGTH(strikes); ++j) {
+                for (Size k=0; k < LENGTH(types); ++k) {
+                    VanillaOption option(
+                        boost::shared_ptr<StrikedTypePayoff>(
+                            new PlainVanillaPayoff(types[k], strikes[j])),
+                        exercise);
+
+                    option.setPricingEngine(cosEngine);
+                    const Real calculated = option.NPV();
+
+                    option.setPricingEngine(analyticEngine);
+                    const Real expected = option.NPV();
+
+                    if (std::fabs(calculated-expected) > tol) {
+                        BOOST_ERROR("failed to reproduce analytic Heston "
+                                    "price with COS engine"
+                                    << "\n    parameters: " << l
+                                    << "\n    maturity:   "
+                                    << exercise->lastDate()
+                                    << "\n    strike:     " << strikes[j]
+                                    << "\n    type:       " << types[k]
+                                    << QL_SCIENTIFIC
+                                    << "\n    calculated: " << calculated
+                                    << "\n    expected:   " << expected
+                                    << "\n    difference: "
+                                    << calculated-expected);
+                    }
+                }
+            }
+        }
+    }
+
+    // a truncation range not containing the forward is rejected
+    // each time, not only at the first attempt
+    boost::shared_ptr<HestonModel> model(new HestonModel(
+        boost::shared_ptr<HestonProcess>(new HestonProcess(
+            riskFreeTS, dividendTS, s0, equityfx.v0, equityfx.kappa,
+            equityfx.theta, equityfx.sigma, equityfx.rho))));
+    VanillaOption option(
+        boost::shared_ptr<StrikedTypePayoff>(
+                                new PlainVanillaPayoff(Option::Put, 100.0)),
+        boost::shared_ptr<Exercise>(
+                    new EuropeanExercise(settlementDate + 1*Years)));
+    option.setPricingEngine(boost::shared_ptr<PricingEngine>(
+                                      new COSHestonEngine(model, 1.0e-4)));
+    for (Size k=0; k<2; ++k) {
+        bool failed = false;
+        try {
+            option.NPV();
+        } catch (Error&) {
+            failed = true;
+        }
+        if (!failed)
+            BOOST_ERROR("invalid truncation range not detected at "
+                        << io::ordinal(k+1) << " attempt");
+    }
+}
+
 test_suite* HestonModelTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Heston model tests");
 
@@ -1531,6 +1744,8 @@ test_suite* HestonModelTest::suite() {
                     &HestonModelTest::testExpansionOnAlanLewisReference));
     suite->add(QUANTLIB_TEST_CASE(
                     &HestonModelTest::testExpansionOnFordeReference));
+    suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testStrikeStripCaching));
+    suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testCOSHestonEngine));
     return suite;
 }
 
@@ -43,6 +43,8 @@ class HestonModelTest {
     static void testAnalyticPDFHestonEngine();
     static void testExpansionOnAlanLewisReference();
     static void testExpansionOnFordeReference();
+    static void testStrikeStripCaching();
+    static void testCOSHestonEngine();
     static boost::unit_test_framework::test_suite* suite();
     static boost::unit_test_framework::test_suite* experimental();
 };
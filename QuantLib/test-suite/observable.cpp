@@ -20,7 +20,13 @@
 #include "observable.hpp"
 #include "utilities.hpp"
 #include <ql/patterns/observable.hpp>
+#include <ql/patterns/lazyobjectscheduler.hpp>
 #include <ql/quotes/simplequote.hpp>
+#include <ql/instruments/vanillaoption.hpp>
+#include <ql/pricingengines/vanilla/binomialengine.hpp>
+#include <ql/processes/blackscholesprocess.hpp>
+#include <ql/time/daycounters/actual360.hpp>
+#include <ql/utilities/dataformatters.hpp>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -36,6 +42,52 @@ namespace {
       private:
         Size counter_;
     };
+
+    class ForwardingCounter : public Observer, public Observable {
+      public:
+        ForwardingCounter() : counter_(0) {}
+        void update() {
+            ++counter_;
+            notifyObservers();
+        }
+        Size counter() { return counter_; }
+      private:
+        Size counter_;
+    };
+
+    // sums the values of its inputs and records when it was calculated
+    class LazySum : public LazyObject {
+      public:
+        LazySum(const std::vector<boost::shared_ptr<Observable> >& inputs,
+                Size& clock)
+        : clock_(clock), stamp_(0) {
+            for (Size i=0; i<inputs.size(); ++i) {
+                registerWith(inputs[i]);
+                inputs_.push_back(inputs[i]);
+            }
+        }
+        Real value() const {
+            calculate();
+            return value_;
+        }
+        Size stamp() const { return stamp_; }
+      private:
+        void performCalculations() const {
+            value_ = 0.0;
+            for (Size i=0; i<inputs_.size(); ++i) {
+                boost::shared_ptr<Quote> q =
+                    boost::dynamic_pointer_cast<Quote>(inputs_[i]);
+                boost::shared_ptr<LazySum> s =
+                    boost::dynamic_pointer_cast<LazySum>(inputs_[i]);
+                value_ += q ? q->value() : s->value();
+            }
+            stamp_ = ++clock_;
+        }
+        std::vector<boost::shared_ptr<Observable> > inputs_;
+        Size& clock_;
+        mutable Size stamp_;
+        mutable Real value_;
+    };
 }
 
 void ObservableTest::testObservableSettings() {
@@ -90,6 +142,273 @@ void ObservableTest::testObservableSettings() {
    }
 }
 
+void ObservableTest::testDeferredUpdatesPropagation() {
+
+    BOOST_TEST_MESSAGE("Testing propagation of deferred updates...");
+
+    const boost::shared_ptr<SimpleQuote> q1(new SimpleQuote(100.0));
+    const boost::shared_ptr<SimpleQuote> q2(new SimpleQuote(100.0));
+
+    // q1 and q2 both feed a; q1 also feeds b; a and b feed the sink.
+    const boost::shared_ptr<ForwardingCounter> a(new ForwardingCounter);
+    const boost::shared_ptr<ForwardingCounter> b(new ForwardingCounter);
+    UpdateCounter sink;
+    a->registerWith(q1);
+    a->registerWith(q2);
+    b->registerWith(q1);
+    sink.registerWith(a);
+    sink.registerWith(b);
+
+    q1->setValue(1.0);
+    q2->setValue(1.0);
+    if (a->counter() != 2 || b->counter() != 1 || sink.counter() != 3)
+        BOOST_FAIL("unexpected number of cascading updates:"
+                   << "\n    a:    " << a->counter()
+                   << "\n    b:    " << b->counter()
+                   << "\n    sink: " << sink.counter());
+
+    ObservableSettings::instance().disableUpdates(true);
+    for (Size i=0; i<10; ++i) {
+        q1->setValue(Real(i));
+        q2->setValue(Real(i));
+    }
+    if (a->counter() != 2 || b->counter() != 1 || sink.counter() != 3)
+        BOOST_FAIL("updates not deferred");
+    ObservableSettings::instance().enableUpdates();
+    if (a->counter() != 3 || b->counter() != 2 || sink.counter() != 4)
+        BOOST_FAIL("deferred updates not coalesced:"
+                   << "\n    a:    " << a->counter() << " (expected 3)"
+                   << "\n    b:    " << b->counter() << " (expected 2)"
+                   << "\n    sink: " << sink.counter() << " (expected 4)");
+
+    // observers that are not notified during the pass are left alone
+    ObservableSettings::instance().disableUpdates(true);
+    q2->setValue(42.0);
+    ObservableSettings::instance().enableUpdates();
+    if (a->counter() != 4 || b->counter() != 2 || sink.counter() != 5)
+        BOOST_FAIL("unexpected deferred updates:"
+                   << "\n    a:    " << a->counter() << " (expected 4)"
+                   << "\n    b:    " << b->counter() << " (expected 2)"
+                   << "\n    sink: " << sink.counter() << " (expected 5)");
+}
+
+void ObservableTest::testLazyObjectScheduler() {
+
+    BOOST_TEST_MESSAGE("Testing scheduled recalculation of lazy objects...");
+
+    Size clock = 0;
+    const boost::shared_ptr<SimpleQuote> q1(new SimpleQuote(1.0));
+    const boost::shared_ptr<SimpleQuote> q2(new SimpleQuote(2.0));
+
+    // a and b depend on the quotes; c depends on a and is notified
+    // of changes in b through a handle.
+    std::vector<boost::shared_ptr<Observable> > inputs(1, q1);
+    const boost::shared_ptr<LazySum> a(new LazySum(inputs, clock));
+    inputs[0] = q2;
+    const boost::shared_ptr<LazySum> b(new LazySum(inputs, clock));
+    RelinkableHandle<Observable> h(b);
+    inputs[0] = a;
+    const boost::shared_ptr<LazySum> c(new LazySum(inputs, clock));
+    c->registerWith(h);
+
+    LazyObjectScheduler scheduler;
+    scheduler.add(c);
+    scheduler.calculate();
+
+    const std::vector<LazyObjectScheduler::Node>& nodes = scheduler.nodes();
+    if (nodes.size() != 3)
+        BOOST_FAIL(nodes.size() << " lazy objects found (3 expected)");
+    if (nodes[0].level != 0 || nodes[1].level != 0 || nodes[2].level != 1
+        || nodes[2].object != c)
+        BOOST_FAIL("wrong levels assigned");
+    if (scheduler.calculated() != 3)
+        BOOST_FAIL(scheduler.calculated()
+                   << " objects calculated (3 expected)");
+    if (c->stamp() != 3 || a->stamp() > 2 || b->stamp() > 2)
+        BOOST_FAIL("objects not calculated in dependency order");
+    if (c->value() != 1.0)
+        BOOST_FAIL("wrong value calculated: " << c->value());
+
+    // nothing to do if nothing changed...
+    scheduler.calculate();
+    if (scheduler.calculated() != 0)
+        BOOST_FAIL(scheduler.calculated()
+                   << " objects recalculated (none expected)");
+
+    // ...and only the affected objects are recalculated otherwise
+    Size stamp = a->stamp();
+    q2->setValue(3.0);
+    scheduler.calculate();
+    if (scheduler.calculated() != 2 || !nodes[2].calculated)
+        BOOST_FAIL(scheduler.calculated()
+                   << " objects recalculated (2 expected)");
+    if (a->stamp() != stamp || b->stamp() != 4 || c->stamp() != 5)
+        BOOST_FAIL("objects not recalculated in dependency order");
+    if (b->value() != 3.0)
+        BOOST_FAIL("wrong value calculated: " << b->value());
+}
+
+void ObservableTest::testLazyObjectSchedulerWithSharedEngine() {
+
+    BOOST_TEST_MESSAGE("Testing scheduled recalculation of instruments "
+                       "sharing an engine...");
+
+    SavedSettings backup;
+
+    Date today(15, May, 2015);
+    Settings::instance().evaluationDate() = today;
+    DayCounter dc = Actual360();
+
+    boost::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    boost::shared_ptr<BlackScholesMertonProcess> process(
+        new BlackScholesMertonProcess(
+            Handle<Quote>(spot),
+            Handle<YieldTermStructure>(flatRate(today, 0.02, dc)),
+            Handle<YieldTermStructure>(flatRate(today, 0.05, dc)),
+            Handle<BlackVolTermStructure>(flatVol(today, 0.20, dc))));
+    boost::shared_ptr<PricingEngine> engine(
+              new BinomialVanillaEngine<CoxRossRubinstein>(process, 800));
+
+    boost::shared_ptr<Exercise> exercise(
+                                  new EuropeanExercise(today + 1*Years));
+
+    // all the options are in the same level; with a shared engine,
+    // calculating them concurrently would mix up their results
+    Size n = 100;
+    std::vector<boost::shared_ptr<StrikedTypePayoff> > payoffs(n);
+    std::vector<boost::shared_ptr<VanillaOption> > options(n);
+    LazyObjectScheduler scheduler(4);
+    for (Size i=0; i<n; ++i) {
+        payoffs[i] = boost::shared_ptr<StrikedTypePayoff>(
+                          new PlainVanillaPayoff(Option::Call, 50.0 + i));
+        options[i] = boost::shared_ptr<VanillaOption>(
+                                    new VanillaOption(payoffs[i], exercise));
+        options[i]->setPricingEngine(engine);
+        scheduler.add(options[i]);
+    }
+
+    for (Size k=0; k<2; ++k) {
+        spot->setValue(100.0 + 5.0*k);
+        scheduler.calculate();
+
+        for (Size i=0; i<n; ++i) {
+            Real calculated = options[i]->NPV();
+            VanillaOption reference(payoffs[i], exercise);
+            reference.setPricingEngine(engine);
+            Real expected = reference.NPV();
+            if (std::fabs(calculated - expected) > 1.0e-12)
+                BOOST_ERROR("wrong value calculated for option "
+                            << io::ordinal(i+1)
+                            << std::setprecision(12)
+                            << "\n    spot:       " << spot->value()
+                            << "\n    strike:     " << payoffs[i]->strike()
+                            << "\n    calculated: " << calculated
+                            << "\n    expected:   " << expected);
+        }
+    }
+}
+
+
+#ifdef QL_ENABLE_EVALUATION_CONTEXTS
+
+#include <ql/evaluationcontext.hpp>
+#include <ql/indexes/indexmanager.hpp>
+#include <ql/math/randomnumbers/seedgenerator.hpp>
+#include <boost/thread/thread.hpp>
+
+namespace {
+
+    class ContextWorker {
+      public:
+        ContextWorker(const EvaluationContext& context, const Date& d,
+                      Date& evaluationDate, Real& fixing)
+        : context_(context), d_(d),
+          evaluationDate_(evaluationDate), fixing_(fixing) {}
+        void operator()() {
+            ScopedEvaluationContext scope(context_);
+            for (Size i=0; i<1000; ++i) {
+                Settings::instance().evaluationDate() = d_ + (i%2);
+                Settings::instance().evaluationDate() = d_;
+                boost::this_thread::yield();
+            }
+            evaluationDate_ = Settings::instance().evaluationDate();
+            fixing_ = IndexManager::instance().getHistory("TestIndex")[d_-1];
+        }
+      private:
+        const EvaluationContext& context_;
+        Date d_;
+        Date& evaluationDate_;
+        Real& fixing_;
+    };
+
+}
+
+void ObservableTest::testEvaluationContexts() {
+
+    BOOST_TEST_MESSAGE("Testing evaluation contexts...");
+
+    SavedSettings backup;
+    IndexHistoryCleaner cleaner;
+
+    Date today(26, April, 2016);
+    Settings::instance().evaluationDate() = today;
+    TimeSeries<Real> fixings;
+    for (Size i=1; i<=10; ++i)
+        fixings[today-i] = 0.01*i;
+    IndexManager::instance().setHistory("TestIndex", fixings);
+
+    EvaluationContext c1, c2;
+    Date d1 = today-2, d2 = today-5;
+    Date calculated1, calculated2;
+    Real fixing1 = 0.0, fixing2 = 0.0;
+
+    boost::thread t1((ContextWorker(c1, d1, calculated1, fixing1)));
+    boost::thread t2((ContextWorker(c2, d2, calculated2, fixing2)));
+    t1.join();
+    t2.join();
+
+    if (calculated1 != d1 || calculated2 != d2)
+        BOOST_FAIL("evaluation dates mixed between contexts:"
+                   << "\n    first context:  " << calculated1
+                   << " (expected " << d1 << ")"
+                   << "\n    second context: " << calculated2
+                   << " (expected " << d2 << ")");
+    if (fixing1 != 0.03 || fixing2 != 0.06)
+        BOOST_FAIL("fixings not inherited by contexts:"
+                   << "\n    first context:  " << fixing1
+                   << " (expected 0.03)"
+                   << "\n    second context: " << fixing2
+                   << " (expected 0.06)");
+    if (Settings::instance().evaluationDate() != today)
+        BOOST_FAIL("evaluation date of the default context modified");
+
+    {
+        ScopedEvaluationContext scope(c1);
+        if (Settings::instance().evaluationDate() != d1)
+            BOOST_FAIL("context settings not preserved");
+        IndexManager::instance().clearHistory("TestIndex");
+    }
+    if (!IndexManager::instance().hasHistory("TestIndex"))
+        BOOST_FAIL("fixings of the default context modified");
+
+    // other singletons are shared, so that e.g. contexts created
+    // together don't get the same sequence of seeds
+    EvaluationContext c3, c4;
+    BigNatural seed3, seed4;
+    {
+        ScopedEvaluationContext scope(c3);
+        seed3 = SeedGenerator::instance().get();
+    }
+    {
+        ScopedEvaluationContext scope(c4);
+        seed4 = SeedGenerator::instance().get();
+    }
+    if (seed3 == seed4)
+        BOOST_FAIL("same seed (" << seed3 << ") returned in "
+                   "different contexts");
+}
+
+#endif
 
 #ifdef QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
 
@@ -255,6 +574,17 @@ test_suite* ObservableTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Observer tests");
 
     suite->add(QUANTLIB_TEST_CASE(&ObservableTest::testObservableSettings));
+    suite->add(QUANTLIB_TEST_CASE(&ObservableTest::testLazyObjectScheduler));
+    suite->add(QUANTLIB_TEST_CASE(
+                  &ObservableTest::testLazyObjectSchedulerWithSharedEngine));
+#ifndef QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
+    suite->add(QUANTLIB_TEST_CASE(
+                           &ObservableTest::testDeferredUpdatesPropagation));
+#endif
+
+#ifdef QL_ENABLE_EVALUATION_CONTEXTS
+    suite->add(QUANTLIB_TEST_CASE(&ObservableTest::testEvaluationContexts));
+#endif
 
 #ifdef QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
     suite->add(QUANTLIB_TEST_CASE(&ObservableTest::testAsyncGarbagCollector));
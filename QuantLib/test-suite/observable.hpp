@@ -28,6 +28,10 @@
 class ObservableTest {
   public:
     static void testObservableSettings();
+    static void testDeferredUpdatesPropagation();
+    static void testLazyObjectScheduler();
+    static void testLazyObjectSchedulerWithSharedEngine();
+    static void testEvaluationContexts();
     static void testAsyncGarbagCollector();
     static void testMultiThreadingGlobalSettings();
 
@@ -22,6 +22,7 @@
 #include <ql/methods/montecarlo/mctraits.hpp>
 #include <ql/processes/blackscholesprocess.hpp>
 #include <ql/processes/geometricbrownianprocess.hpp>
+#include <ql/processes/hestonprocess.hpp>
 #include <ql/processes/ornsteinuhlenbeckprocess.hpp>
 #include <ql/processes/squarerootprocess.hpp>
 #include <ql/processes/stochasticprocessarray.hpp>
@@ -138,6 +139,119 @@ namespace {
         }
     }
 
+    void testSingleBlock(const boost::shared_ptr<StochasticProcess1D>& process,
+                         const std::string& tag, bool brownianBridge) {
+        typedef PseudoRandom::rsg_type rsg_type;
+        typedef PathGenerator<rsg_type>::sample_type sample_type;
+
+        BigNatural seed = 42;
+        TimeGrid grid(10.0, 12);
+        Size paths = 17;
+        rsg_type rsg = PseudoRandom::make_sequence_generator(grid.size()-1,
+                                                             seed);
+        PathGenerator<rsg_type> generator(process, grid, rsg, brownianBridge);
+        PathGenerator<rsg_type> blockGenerator(process, grid, rsg,
+                                               brownianBridge);
+
+        PathBlock block(1, paths, grid), antithetic(1, paths, grid);
+        blockGenerator.next(block);
+        blockGenerator.antithetic(antithetic);
+
+        Real tolerance = 1.0e-12;
+        for (Size k=0; k<paths; k++) {
+            sample_type sample = generator.next();
+            for (Size i=0; i<grid.size(); i++) {
+                Real expected = sample.value[i];
+                Real calculated = block.value(k,i);
+                if (std::fabs(calculated-expected) > tolerance) {
+                    BOOST_FAIL("using " << tag << " process "
+                               << (brownianBridge ? "with " : "without ")
+                               << "brownian bridge:\n"
+                               << std::setprecision(13)
+                               << "    path:       " << k << "\n"
+                               << "    time step:  " << i << "\n"
+                               << "    block:      " << calculated << "\n"
+                               << "    single:     " << expected);
+                }
+            }
+            sample = generator.antithetic();
+            for (Size i=0; i<grid.size(); i++) {
+                Real expected = sample.value[i];
+                Real calculated = antithetic.value(k,i);
+                if (std::fabs(calculated-expected) > tolerance) {
+                    BOOST_FAIL("using " << tag << " process "
+                               << (brownianBridge ? "with " : "without ")
+                               << "brownian bridge:\n"
+                               << "antithetic sample:\n"
+                               << std::setprecision(13)
+                               << "    path:       " << k << "\n"
+                               << "    time step:  " << i << "\n"
+                               << "    block:      " << calculated << "\n"
+                               << "    single:     " << expected);
+                }
+            }
+        }
+    }
+
+    void testMultipleBlock(const boost::shared_ptr<StochasticProcess>& process,
+                           const std::string& tag,
+                           bool brownianBridge = false) {
+        typedef PseudoRandom::rsg_type rsg_type;
+        typedef MultiPathGenerator<rsg_type>::sample_type sample_type;
+
+        BigNatural seed = 42;
+        TimeGrid grid(10.0, 12);
+        Size paths = 17;
+        Size assets = process->size();
+        rsg_type rsg = PseudoRandom::make_sequence_generator(
+                                (grid.size()-1)*process->factors(), seed);
+        MultiPathGenerator<rsg_type> generator(process, grid, rsg,
+                                               brownianBridge);
+        MultiPathGenerator<rsg_type> blockGenerator(process, grid, rsg,
+                                                    brownianBridge);
+
+        PathBlock block(assets, paths, grid), antithetic(assets, paths, grid);
+        blockGenerator.next(block);
+        blockGenerator.antithetic(antithetic);
+
+        Real tolerance = 1.0e-12;
+        for (Size k=0; k<paths; k++) {
+            sample_type sample = generator.next();
+            for (Size j=0; j<assets; j++) {
+                for (Size i=0; i<grid.size(); i++) {
+                    Real expected = sample.value[j][i];
+                    Real calculated = block.value(k,i,j);
+                    if (std::fabs(calculated-expected) > tolerance) {
+                        BOOST_FAIL("using " << tag << " process "
+                                   << "(" << io::ordinal(j+1) << " asset:)\n"
+                                   << std::setprecision(13)
+                                   << "    path:       " << k << "\n"
+                                   << "    time step:  " << i << "\n"
+                                   << "    block:      " << calculated << "\n"
+                                   << "    single:     " << expected);
+                    }
+                }
+            }
+            sample = generator.antithetic();
+            for (Size j=0; j<assets; j++) {
+                for (Size i=0; i<grid.size(); i++) {
+                    Real expected = sample.value[j][i];
+                    Real calculated = antithetic.value(k,i,j);
+                    if (std::fabs(calculated-expected) > tolerance) {
+                        BOOST_FAIL("using " << tag << " process "
+                                   << "(" << io::ordinal(j+1) << " asset:)\n"
+                                   << "antithetic sample:\n"
+                                   << std::setprecision(13)
+                                   << "    path:       " << k << "\n"
+                                   << "    time step:  " << i << "\n"
+                                   << "    block:      " << calculated << "\n"
+                                   << "    single:     " << expected);
+                    }
+                }
+            }
+        }
+    }
+
 }
 
 
@@ -290,11 +404,157 @@ void PathGeneratorTest::testMultiPathGenerator() {
 }
 
 
+void PathGeneratorTest::testBlockGeneration() {
+
+    BOOST_TEST_MESSAGE("Testing path generation in blocks...");
+
+    SavedSettings backup;
+
+    Settings::instance().evaluationDate() = Date(26,April,2005);
+
+    Handle<Quote> x0(boost::shared_ptr<Quote>(new SimpleQuote(100.0)));
+    Handle<YieldTermStructure> r(flatRate(0.05, Actual360()));
+    Handle<YieldTermStructure> q(flatRate(0.02, Actual360()));
+    Handle<BlackVolTermStructure> sigma(flatVol(0.20, Actual360()));
+
+    boost::shared_ptr<StochasticProcess1D> bsProcess(
+                                 new BlackScholesMertonProcess(x0,q,r,sigma));
+    testSingleBlock(bsProcess, "Black-Scholes", false);
+    testSingleBlock(bsProcess, "Black-Scholes", true);
+    testSingleBlock(boost::shared_ptr<StochasticProcess1D>(
+                                 new SquareRootProcess(0.1, 0.1, 0.20, 10.0)),
+                    "square-root", false);
+
+    Matrix correlation(3,3);
+    correlation[0][0] = 1.0; correlation[0][1] = 0.9; correlation[0][2] = 0.7;
+    correlation[1][0] = 0.9; correlation[1][1] = 1.0; correlation[1][2] = 0.4;
+    correlation[2][0] = 0.7; correlation[2][1] = 0.4; correlation[2][2] = 1.0;
+
+    std::vector<boost::shared_ptr<StochasticProcess1D> > processes(3);
+    processes[0] = bsProcess;
+    processes[1] = bsProcess;
+    processes[2] = boost::shared_ptr<StochasticProcess1D>(
+                                     new OrnsteinUhlenbeckProcess(0.1, 0.20));
+    testMultipleBlock(boost::shared_ptr<StochasticProcess>(
+                           new StochasticProcessArray(processes,correlation)),
+                      "process-array");
+
+    HestonProcess::Discretization schemes[] = {
+        HestonProcess::PartialTruncation,
+        HestonProcess::FullTruncation,
+        HestonProcess::Reflection,
+        HestonProcess::QuadraticExponential,
+        HestonProcess::QuadraticExponentialMartingale,
+        HestonProcess::NonCentralChiSquareVariance
+    };
+    std::string tags[] = {
+        "partial-truncation Heston", "full-truncation Heston",
+        "reflection Heston", "quadratic-exponential Heston",
+        "martingale quadratic-exponential Heston", "non-central chi-square Heston"
+    };
+    for (Size i=0; i<LENGTH(schemes); i++) {
+        testMultipleBlock(boost::shared_ptr<StochasticProcess>(
+                              new HestonProcess(r, q, x0, 0.04, 1.5, 0.04,
+                                                0.3, -0.7, schemes[i])),
+                          tags[i]);
+    }
+}
+
+
+void PathGeneratorTest::testMultiPathBrownianBridge() {
+
+    BOOST_TEST_MESSAGE("Testing n-D path generation with Brownian bridge...");
+
+    SavedSettings backup;
+
+    Settings::instance().evaluationDate() = Date(26,April,2005);
+
+    Handle<Quote> x0(boost::shared_ptr<Quote>(new SimpleQuote(100.0)));
+    Handle<YieldTermStructure> r(flatRate(0.05, Actual360()));
+    Handle<YieldTermStructure> q(flatRate(0.02, Actual360()));
+
+    Volatility vols[] = { 0.10, 0.20, 0.30 };
+    Size assets = LENGTH(vols);
+    std::vector<boost::shared_ptr<StochasticProcess1D> > processes(assets);
+    for (Size j=0; j<assets; j++)
+        processes[j] = boost::shared_ptr<StochasticProcess1D>(
+                new BlackScholesMertonProcess(x0, q, r,
+                                              Handle<BlackVolTermStructure>(
+                                                flatVol(vols[j], Actual360()))));
+    Matrix correlation(assets, assets, 0.0);
+    for (Size j=0; j<assets; j++)
+        correlation[j][j] = 1.0;
+    boost::shared_ptr<StochasticProcess> process(
+                          new StochasticProcessArray(processes, correlation));
+
+    typedef PseudoRandom::rsg_type rsg_type;
+    typedef MultiPathGenerator<rsg_type>::sample_type sample_type;
+
+    BigNatural seed = 42;
+    Time length = 10.0;
+    TimeGrid grid(length, 12);
+    rsg_type rsg = PseudoRandom::make_sequence_generator(
+                                           assets*(grid.size()-1), seed);
+    MultiPathGenerator<rsg_type> generator(process, grid, rsg, true);
+
+    // with the Brownian bridge, the first dimension allocated to
+    // each factor determines the final value of its path
+    Real tolerance = 1.0e-8;
+    for (Size i=0; i<10; i++) {
+        const std::vector<Real>& z = rsg.nextSequence().value;
+        sample_type sample = generator.next();
+        for (Size j=0; j<assets; j++) {
+            Real expected = x0->value() *
+                std::exp(r->zeroRate(length, Continuous).rate()*length
+                         - q->zeroRate(length, Continuous).rate()*length
+                         - 0.5*vols[j]*vols[j]*length
+                         + vols[j]*std::sqrt(length)*z[j]);
+            Real calculated = sample.value[j].back();
+            if (std::fabs(calculated-expected) > tolerance*expected)
+                BOOST_FAIL("final value of " << io::ordinal(j+1)
+                           << " asset not determined by the first dimensions"
+                           << std::setprecision(13)
+                           << "\n    calculated: " << calculated
+                           << "\n    expected:   " << expected);
+        }
+    }
+
+    // block and single generation must agree
+    testMultipleBlock(process, "Brownian-bridge", true);
+
+    // with a single factor, the bridge must reproduce the one used
+    // by the 1-D generator
+    boost::shared_ptr<StochasticProcess> singleAsset(
+                          new StochasticProcessArray(
+                              std::vector<boost::shared_ptr<StochasticProcess1D> >(
+                                                           1, processes[1]),
+                              Matrix(1, 1, 1.0)));
+    rsg_type rsg1 = PseudoRandom::make_sequence_generator(grid.size()-1, seed);
+    MultiPathGenerator<rsg_type> multiGenerator(singleAsset, grid, rsg1, true);
+    PathGenerator<rsg_type> singleGenerator(processes[1], grid, rsg1, true);
+    for (Size i=0; i<10; i++) {
+        const Path& expected = singleGenerator.next().value;
+        const Path& calculated = multiGenerator.next().value[0];
+        for (Size k=0; k<grid.size(); k++) {
+            if (std::fabs(calculated[k]-expected[k]) > 1.0e-12)
+                BOOST_FAIL("single-factor multipath differs from path"
+                           << std::setprecision(13)
+                           << "\n    time step:  " << k
+                           << "\n    multipath:  " << calculated[k]
+                           << "\n    path:       " << expected[k]);
+        }
+    }
+}
+
+
 test_suite* PathGeneratorTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Path generation tests");
     suite->add(QUANTLIB_TEST_CASE(&PathGeneratorTest::testPathGenerator));
     // FLOATING_POINT_EXCEPTION
     suite->add(QUANTLIB_TEST_CASE(&PathGeneratorTest::testMultiPathGenerator));
+    suite->add(QUANTLIB_TEST_CASE(&PathGeneratorTest::testBlockGeneration));
+    suite->add(QUANTLIB_TEST_CASE(
+                          &PathGeneratorTest::testMultiPathBrownianBridge));
     return suite;
 }
 
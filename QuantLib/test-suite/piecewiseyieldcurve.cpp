@@ -20,18 +20,23 @@
 #include "piecewiseyieldcurve.hpp"
 #include "utilities.hpp"
 #include <ql/termstructures/yield/piecewiseyieldcurve.hpp>
+#include <ql/termstructures/globalbootstrap.hpp>
+#include <ql/termstructures/jointbootstrap.hpp>
 #include <ql/termstructures/yield/ratehelpers.hpp>
 #include <ql/termstructures/yield/bondhelpers.hpp>
+#include <ql/termstructures/yield/oisratehelper.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
 #include <ql/time/calendars/target.hpp>
 #include <ql/time/calendars/japan.hpp>
 #include <ql/time/calendars/jointcalendar.hpp>
 #include <ql/time/daycounters/actual360.hpp>
+#include <ql/time/daycounters/actual365fixed.hpp>
 #include <ql/time/daycounters/actualactual.hpp>
 #include <ql/time/daycounters/thirty360.hpp>
 #include <ql/time/imm.hpp>
 #include <ql/time/asx.hpp>
 #include <ql/indexes/ibor/euribor.hpp>
+#include <ql/indexes/ibor/eonia.hpp>
 #include <ql/indexes/ibor/usdlibor.hpp>
 #include <ql/indexes/ibor/jpylibor.hpp>
 #include <ql/indexes/bmaindex.hpp>
@@ -759,6 +764,517 @@ void PiecewiseYieldCurveTest::testLocalBootstrapConsistency() {
 }
 
 
+void PiecewiseYieldCurveTest::testGlobalBootstrapConsistency() {
+    BOOST_TEST_MESSAGE(
+        "Testing consistency of global-bootstrap algorithm...");
+
+    CommonVars vars;
+    testCurveConsistency<ZeroYield,Cubic,GlobalBootstrap>(
+                   vars,
+                   Cubic(CubicInterpolation::Spline, true,
+                         CubicInterpolation::SecondDerivative, 0.0,
+                         CubicInterpolation::SecondDerivative, 0.0));
+    testCurveConsistency<Discount,LogLinear,GlobalBootstrap>(vars);
+    testCurveConsistency<ForwardRate,ConvexMonotone,GlobalBootstrap>(vars);
+    testBMACurveConsistency<ForwardRate,ConvexMonotone,GlobalBootstrap>(vars);
+}
+
+
+void PiecewiseYieldCurveTest::testGlobalBootstrapSensitivities() {
+    BOOST_TEST_MESSAGE(
+        "Testing quote sensitivities of global-bootstrap algorithm...");
+
+    CommonVars vars;
+
+    Cubic interpolator(CubicInterpolation::Spline, true,
+                       CubicInterpolation::SecondDerivative, 0.0,
+                       CubicInterpolation::SecondDerivative, 0.0);
+    typedef PiecewiseYieldCurve<ZeroYield,Cubic,GlobalBootstrap> Curve;
+    boost::shared_ptr<Curve> curve(new Curve(vars.settlement,
+                                             vars.instruments,
+                                             Actual360(),
+                                             interpolator));
+
+    std::vector<Real> data = curve->data();
+    Matrix sensitivities = curve->bootstrap().quoteSensitivities();
+
+    Real bump = 1.0e-6;
+    Real tolerance = 1.0e-3;
+    for (Size j=0; j<vars.rates.size(); j+=3) {
+        Rate rate = vars.rates[j]->value();
+
+        // the bumped curve is bootstrapped starting from the
+        // previous solution...
+        vars.rates[j]->setValue(rate+bump);
+        std::vector<Real> bumped = curve->data();
+
+        // ...and must agree with a curve bootstrapped from scratch
+        PiecewiseYieldCurve<ZeroYield,Cubic,IterativeBootstrap>
+            reference(vars.settlement, vars.instruments, Actual360(),
+                      interpolator);
+        for (Size i=1; i<data.size(); ++i) {
+            Real error = std::fabs(bumped[i] - reference.data()[i]);
+            if (error > 1.0e-10)
+                BOOST_ERROR("failed to reproduce bootstrapped curve "
+                            "after bumping " << io::ordinal(j+1) << " quote"
+                            << std::setprecision(12)
+                            << "\n    node:        " << i
+                            << "\n    calculated:  " << bumped[i]
+                            << "\n    expected:    " << reference.data()[i]);
+        }
+
+        for (Size i=1; i<data.size(); ++i) {
+            Real expected = (bumped[i] - data[i])/bump;
+            Real calculated = sensitivities[i-1][j];
+            if (std::fabs(calculated - expected) >
+                tolerance*std::max(std::fabs(expected), 1.0))
+                BOOST_ERROR("failed to reproduce sensitivity of "
+                            << io::ordinal(i) << " node to "
+                            << io::ordinal(j+1) << " quote"
+                            << std::setprecision(8)
+                            << "\n    calculated: " << calculated
+                            << "\n    expected:   " << expected);
+        }
+
+        vars.rates[j]->setValue(rate);
+    }
+}
+
+
+namespace {
+
+    template <class T, class I>
+    void testIncrementalCurve(CommonVars& vars) {
+
+        PiecewiseYieldCurve<T,I> curve(vars.settlement, vars.instruments,
+                                       Actual360());
+
+        for (Size j=0; j<vars.rates.size(); ++j) {
+            std::vector<Real> data = curve.data();
+            std::vector<Date> dates = curve.dates();
+
+            Rate rate = vars.rates[j]->value();
+            vars.rates[j]->setValue(rate + 0.0001);
+            std::vector<Real> bumped = curve.data();
+
+            // the bumped curve is bootstrapped again from the changed
+            // pillar only, or from an earlier one whose helper reaches
+            // beyond it; the previous ones must not move...
+            Date pillar = vars.instruments[j]->pillarDate();
+            Size first = j+1;
+            while (first > 1 && vars.instruments[first-2]->latestRelevantDate()
+                                                          > dates[first-1])
+                --first;
+            for (Size i=1; i<first; ++i) {
+                if (bumped[i] != data[i])
+                    BOOST_ERROR("node " << dates[i] << " moved after "
+                                "bumping the quote with pillar " << pillar
+                                << std::setprecision(12)
+                                << "\n    before: " << data[i]
+                                << "\n    after:  " << bumped[i]);
+            }
+
+            // ...and the result must agree with a full bootstrap
+            PiecewiseYieldCurve<T,I> reference(vars.settlement,
+                                               vars.instruments,
+                                               Actual360());
+            for (Size i=1; i<bumped.size(); ++i) {
+                Real error = std::fabs(bumped[i] - reference.data()[i]);
+                if (error > 1.0e-10)
+                    BOOST_ERROR("failed to reproduce full bootstrap after "
+                                "bumping the quote with pillar " << pillar
+                                << std::setprecision(12)
+                                << "\n    node:       " << dates[i]
+                                << "\n    calculated: " << bumped[i]
+                                << "\n    expected:   "
+                                << reference.data()[i]);
+            }
+
+            vars.rates[j]->setValue(rate);
+        }
+    }
+
+    // counts the evaluations of its implied quote
+    class CountingDepositRateHelper : public DepositRateHelper {
+      public:
+        CountingDepositRateHelper(const Handle<Quote>& rate,
+                                  const Period& tenor,
+                                  Natural fixingDays,
+                                  const Calendar& calendar,
+                                  BusinessDayConvention convention,
+                                  bool endOfMonth,
+                                  const DayCounter& dayCounter)
+        : DepositRateHelper(rate, tenor, fixingDays, calendar,
+                            convention, endOfMonth, dayCounter),
+          evaluations(0) {}
+        Real impliedQuote() const {
+            ++evaluations;
+            return DepositRateHelper::impliedQuote();
+        }
+        mutable Size evaluations;
+    };
+
+    template <class T, class I>
+    void checkFullBootstrap(const PiecewiseYieldCurve<T,I>& curve,
+                            CommonVars& vars,
+                            const std::vector<Handle<Quote> >& jumps,
+                            const std::vector<Date>& jumpDates,
+                            const std::string& change) {
+        PiecewiseYieldCurve<T,I> reference(vars.settlementDays,
+                                           vars.calendar,
+                                           vars.instruments,
+                                           Actual360(),
+                                           jumps, jumpDates);
+        if (curve.dates() != reference.dates())
+            BOOST_FAIL("failed to reproduce pillar dates after "
+                       << change);
+        for (Size i=1; i<curve.data().size(); ++i) {
+            Real error = std::fabs(curve.data()[i] - reference.data()[i]);
+            if (error > 1.0e-10)
+                BOOST_ERROR("failed to reproduce full bootstrap after "
+                            << change
+                            << std::setprecision(12)
+                            << "\n    node:       " << curve.dates()[i]
+                            << "\n    calculated: " << curve.data()[i]
+                            << "\n    expected:   " << reference.data()[i]);
+        }
+    }
+
+    template <class T, class I>
+    void testIncrementalMovingCurve(CommonVars& vars) {
+
+        boost::shared_ptr<SimpleQuote> jump(new SimpleQuote(0.999));
+        std::vector<Handle<Quote> > jumps(1, Handle<Quote>(jump));
+        std::vector<Date> jumpDates(1, vars.today + 18*Months);
+
+        // the first helper records whether its pillar is bootstrapped
+        boost::shared_ptr<IborIndex> euribor6m(new Euribor6M);
+        boost::shared_ptr<CountingDepositRateHelper> first(
+            new CountingDepositRateHelper(
+                       Handle<Quote>(vars.rates[0]),
+                       depositData[0].n*depositData[0].units,
+                       euribor6m->fixingDays(), vars.calendar,
+                       euribor6m->businessDayConvention(),
+                       euribor6m->endOfMonth(),
+                       euribor6m->dayCounter()));
+        std::vector<boost::shared_ptr<RateHelper> > instruments =
+                                                            vars.instruments;
+        instruments[0] = first;
+
+        PiecewiseYieldCurve<T,I> curve(vars.settlementDays, vars.calendar,
+                                       instruments, Actual360(),
+                                       jumps, jumpDates);
+
+        // a quote change only moves the following pillars...
+        Size j = vars.rates.size()/2;
+        std::vector<Real> data = curve.data();
+        first->evaluations = 0;
+        Rate rate = vars.rates[j]->value();
+        vars.rates[j]->setValue(rate + 0.0001);
+        std::vector<Real> bumped = curve.data();
+        if (first->evaluations != 0)
+            BOOST_ERROR("first pillar of moving curve bootstrapped again "
+                        "after bumping the quote with pillar "
+                        << vars.instruments[j]->pillarDate());
+        Size firstPillar = j+1;
+        while (firstPillar > 1 &&
+               vars.instruments[firstPillar-2]->latestRelevantDate()
+                                             > curve.dates()[firstPillar-1])
+            --firstPillar;
+        for (Size i=1; i<firstPillar; ++i) {
+            if (bumped[i] != data[i])
+                BOOST_ERROR("node " << curve.dates()[i] << " of moving "
+                            "curve moved after bumping the quote with "
+                            "pillar " << vars.instruments[j]->pillarDate()
+                            << std::setprecision(12)
+                            << "\n    before: " << data[i]
+                            << "\n    after:  " << bumped[i]);
+        }
+        checkFullBootstrap(curve, vars, jumps, jumpDates,
+                           "bumping a quote of a moving curve");
+        vars.rates[j]->setValue(rate);
+
+        // ...while changes of the jumps or of the evaluation date
+        // require all of them to be bootstrapped again
+        jump->setValue(0.998);
+        checkFullBootstrap(curve, vars, jumps, jumpDates,
+                           "changing a jump");
+
+        Settings::instance().evaluationDate() =
+            vars.calendar.advance(vars.today, 1, Weeks);
+        checkFullBootstrap(curve, vars, jumps, jumpDates,
+                           "changing the evaluation date");
+
+        // both together with a quote change
+        Settings::instance().evaluationDate() = vars.today;
+        vars.rates[j]->setValue(rate + 0.0001);
+        checkFullBootstrap(curve, vars, jumps, jumpDates,
+                           "changing the evaluation date and a quote");
+
+        vars.rates[j]->setValue(rate);
+        jump->setValue(0.999);
+        checkFullBootstrap(curve, vars, jumps, jumpDates,
+                           "changing a jump and a quote");
+    }
+
+}
+
+
+void PiecewiseYieldCurveTest::testIncrementalBootstrap() {
+    BOOST_TEST_MESSAGE(
+        "Testing incremental bootstrap after a quote change...");
+
+    CommonVars vars;
+    testIncrementalCurve<Discount,LogLinear>(vars);
+    testIncrementalCurve<ZeroYield,Linear>(vars);
+    testIncrementalCurve<ForwardRate,BackwardFlat>(vars);
+
+    testIncrementalMovingCurve<Discount,LogLinear>(vars);
+    testIncrementalMovingCurve<ZeroYield,Linear>(vars);
+    testIncrementalMovingCurve<ForwardRate,BackwardFlat>(vars);
+}
+
+
+namespace {
+
+    Real maxQuoteError(
+                 const std::vector<boost::shared_ptr<RateHelper> >& helpers) {
+        Real error = 0.0;
+        for (Size i=0; i<helpers.size(); ++i)
+            error = std::max(error, std::fabs(helpers[i]->quoteError()));
+        return error;
+    }
+
+}
+
+
+void PiecewiseYieldCurveTest::testMultiCurveBootstrap() {
+    BOOST_TEST_MESSAGE("Testing multi-curve bootstrap of dependent curves...");
+
+    CommonVars vars;
+
+    Datum oisData[] = {
+        {  1, Months, 4.05 },
+        {  3, Months, 4.10 },
+        {  6, Months, 4.13 },
+        {  1, Years,  4.16 },
+        {  2, Years,  4.25 },
+        {  3, Years,  4.37 },
+        {  5, Years,  4.60 },
+        {  7, Years,  4.83 },
+        { 10, Years,  5.10 }
+    };
+    Spread basis = 0.0010;
+    Size swaps = 10;
+
+    // the independent curve is compared with a usual one
+    PiecewiseYieldCurve<Discount,LogLinear> reference(vars.settlement,
+                                                      vars.instruments,
+                                                      Actual360());
+    std::vector<Real> expected = reference.data();
+
+    RelinkableHandle<YieldTermStructure> oisHandle, euribor6MHandle;
+
+    std::vector<boost::shared_ptr<SimpleQuote> > euribor6MQuotes;
+    std::vector<boost::shared_ptr<RateHelper> > oisHelpers,
+                                                euribor6MHelpers,
+                                                euribor3MHelpers;
+
+    // an OIS curve; in order to have a mutual dependency, the
+    // longer swaps are discounted on the 6-months curve, which
+    // discounts on the OIS curve.
+    boost::shared_ptr<OvernightIndex> eonia(new Eonia);
+    for (Size i=0; i<LENGTH(oisData); ++i) {
+        Handle<Quote> rate(boost::shared_ptr<Quote>(
+                                 new SimpleQuote(oisData[i].rate/100)));
+        Period tenor = oisData[i].n*oisData[i].units;
+        Handle<YieldTermStructure> discountCurve;
+        if (tenor > 2*Years)
+            discountCurve = euribor6MHandle;
+        oisHelpers.push_back(boost::shared_ptr<RateHelper>(
+                new OISRateHelper(2, tenor, rate, eonia, discountCurve)));
+    }
+
+    // 6-months and 3-months curves discounting on the OIS curve
+    boost::shared_ptr<IborIndex> euribor6M(new Euribor6M);
+    boost::shared_ptr<IborIndex> euribor3M(new Euribor3M);
+    euribor6MHelpers.push_back(boost::shared_ptr<RateHelper>(
+        new DepositRateHelper(depositData[4].rate/100, euribor6M)));
+    euribor3MHelpers.push_back(boost::shared_ptr<RateHelper>(
+        new DepositRateHelper(depositData[3].rate/100, euribor3M)));
+    for (Size i=0; i<swaps; ++i) {
+        Period tenor = swapData[i].n*swapData[i].units;
+        boost::shared_ptr<SimpleQuote> rate(
+                                 new SimpleQuote(swapData[i].rate/100));
+        euribor6MQuotes.push_back(rate);
+        euribor6MHelpers.push_back(boost::shared_ptr<RateHelper>(
+            new SwapRateHelper(Handle<Quote>(rate), tenor, vars.calendar,
+                               vars.fixedLegFrequency,
+                               vars.fixedLegConvention,
+                               vars.fixedLegDayCounter, euribor6M,
+                               Handle<Quote>(), 0*Days, oisHandle)));
+        Handle<Quote> basisRate(boost::shared_ptr<Quote>(
+                             new SimpleQuote(swapData[i].rate/100-basis)));
+        euribor3MHelpers.push_back(boost::shared_ptr<RateHelper>(
+            new SwapRateHelper(basisRate, tenor, vars.calendar,
+                               vars.fixedLegFrequency,
+                               vars.fixedLegConvention,
+                               vars.fixedLegDayCounter, euribor3M,
+                               Handle<Quote>(), 0*Days, oisHandle)));
+    }
+
+    typedef PiecewiseYieldCurve<Discount,LogLinear,JointBootstrap> Curve;
+    boost::shared_ptr<MultiCurveBootstrap> multiCurve(
+                                                  new MultiCurveBootstrap);
+    boost::shared_ptr<Curve> ois(
+        new Curve(vars.settlement, oisHelpers, Actual365Fixed(),
+                  LogLinear(), JointBootstrap<Curve>(multiCurve)));
+    boost::shared_ptr<Curve> euribor6MCurve(
+        new Curve(vars.settlement, euribor6MHelpers, Actual365Fixed(),
+                  LogLinear(), JointBootstrap<Curve>(multiCurve)));
+    boost::shared_ptr<Curve> euribor3MCurve(
+        new Curve(vars.settlement, euribor3MHelpers, Actual365Fixed(),
+                  LogLinear(), JointBootstrap<Curve>(multiCurve)));
+    boost::shared_ptr<Curve> independent(
+        new Curve(vars.settlement, vars.instruments, Actual360(),
+                  LogLinear(), JointBootstrap<Curve>(multiCurve)));
+    oisHandle.linkTo(ois);
+    euribor6MHandle.linkTo(euribor6MCurve);
+
+    // the OIS and 6-months curves are solved together, the 3-months
+    // curve after them; the last curve is independent.
+    std::vector<std::vector<Size> > components = multiCurve->components();
+    std::vector<Size> first(1, 0), second(1, 2), third(1, 3);
+    first.push_back(1);
+    std::vector<std::vector<Size> >::iterator i1 =
+        std::find(components.begin(), components.end(), first);
+    std::vector<std::vector<Size> >::iterator i2 =
+        std::find(components.begin(), components.end(), second);
+    std::vector<std::vector<Size> >::iterator i3 =
+        std::find(components.begin(), components.end(), third);
+    if (components.size() != 3 || i1 == components.end() ||
+        i2 == components.end() || i3 == components.end() || i2 < i1)
+        BOOST_ERROR("unexpected dependencies between curves"
+                    "\n    number of groups: " << components.size());
+
+    Real tolerance = 1.0e-10;
+    for (Size k=0; k<2; ++k) {
+        Real error = maxQuoteError(oisHelpers);
+        if (error > tolerance)
+            BOOST_ERROR("failed to reprice OIS helpers"
+                        << "\n    max error: " << error);
+        error = maxQuoteError(euribor6MHelpers);
+        if (error > tolerance)
+            BOOST_ERROR("failed to reprice 6-months helpers"
+                        << "\n    max error: " << error);
+        error = maxQuoteError(euribor3MHelpers);
+        if (error > tolerance)
+            BOOST_ERROR("failed to reprice 3-months helpers"
+                        << "\n    max error: " << error);
+        error = maxQuoteError(vars.instruments);
+        if (error > tolerance)
+            BOOST_ERROR("failed to reprice independent helpers"
+                        << "\n    max error: " << error);
+
+        // a change in the 6-months quotes moves the OIS curve, too
+        Real previous = ois->data().back();
+        euribor6MQuotes.back()->setValue(euribor6MQuotes.back()->value()
+                                         + 0.0001);
+        if (ois->data().back() == previous)
+            BOOST_ERROR("OIS curve not updated after quote change");
+    }
+
+    const std::vector<Real>& data = independent->data();
+    for (Size i=0; i<data.size(); ++i) {
+        if (std::fabs(data[i] - expected[i]) > tolerance)
+            BOOST_ERROR("failed to reproduce independent curve"
+                        << std::setprecision(12)
+                        << "\n    node:       " << i
+                        << "\n    calculated: " << data[i]
+                        << "\n    expected:   " << expected[i]);
+    }
+
+    // when the bootstrap fails, no curve keeps the data it had
+    // when the failure occurred...
+    Rate rate = vars.rates.back()->value();
+    vars.rates.back()->setValue(Null<Real>());
+    boost::shared_ptr<Curve> curves[] = {
+        ois, euribor6MCurve, euribor3MCurve, independent
+    };
+    for (Size i=0; i<LENGTH(curves); ++i) {
+        bool failed = false;
+        try {
+            curves[i]->data();
+        } catch (Error&) {
+            failed = true;
+        }
+        if (!failed)
+            BOOST_ERROR(io::ordinal(i+1) << " curve kept its data "
+                        "after a failed bootstrap");
+    }
+
+    // ...and all of them are bootstrapped again afterwards
+    vars.rates.back()->setValue(rate);
+    multiCurve->bootstrap();
+    Real error = maxQuoteError(oisHelpers);
+    error = std::max(error, maxQuoteError(euribor6MHelpers));
+    error = std::max(error, maxQuoteError(euribor3MHelpers));
+    error = std::max(error, maxQuoteError(vars.instruments));
+    if (error > tolerance)
+        BOOST_ERROR("failed to reprice helpers after failed bootstrap"
+                    << "\n    max error: " << error);
+}
+
+
+namespace {
+
+    template <class T, class I>
+    void testBatchedCurve(CommonVars& vars) {
+
+        boost::shared_ptr<Quote> jump(new SimpleQuote(0.995));
+        std::vector<Handle<Quote> > jumps(1, Handle<Quote>(jump));
+        std::vector<Date> jumpDates(1, vars.settlement + 2*Years);
+        PiecewiseYieldCurve<T,I> curve(vars.settlement, vars.instruments,
+                                       Actual360(), jumps, jumpDates);
+        curve.enableExtrapolation();
+
+        // quarterly times, past the last node, sorted and then reversed
+        std::vector<Time> times;
+        for (Size i=0; i<=200; ++i)
+            times.push_back(0.25*i);
+        for (Size i=200; i>0; --i)
+            times.push_back(0.25*i - 0.1);
+
+        std::vector<DiscountFactor> discounts(times.size());
+        curve.discount(&times[0], &discounts[0], times.size());
+
+        for (Size i=0; i<times.size(); ++i) {
+            DiscountFactor expected = curve.discount(times[i]);
+            if (std::fabs(discounts[i] - expected) > 1.0e-15)
+                BOOST_ERROR("batched discount differs from single one"
+                            << std::setprecision(15)
+                            << "\n    time:       " << times[i]
+                            << "\n    calculated: " << discounts[i]
+                            << "\n    expected:   " << expected);
+        }
+    }
+
+}
+
+
+void PiecewiseYieldCurveTest::testBatchedDiscounts() {
+    BOOST_TEST_MESSAGE("Testing batched discount factors...");
+
+    CommonVars vars;
+    testBatchedCurve<Discount,LogLinear>(vars);
+    testBatchedCurve<Discount,Cubic>(vars);
+    testBatchedCurve<ZeroYield,Linear>(vars);
+    testBatchedCurve<ZeroYield,Cubic>(vars);
+    testBatchedCurve<ForwardRate,BackwardFlat>(vars);
+    testBatchedCurve<ForwardRate,Linear>(vars);
+}
+
+
 void PiecewiseYieldCurveTest::testObservability() {
 
     BOOST_TEST_MESSAGE("Testing observability of piecewise yield curve...");
@@ -1066,6 +1582,16 @@ test_suite* PiecewiseYieldCurveTest::suite() {
              &PiecewiseYieldCurveTest::testConvexMonotoneForwardConsistency));
     suite->add(QUANTLIB_TEST_CASE(
              &PiecewiseYieldCurveTest::testLocalBootstrapConsistency));
+    suite->add(QUANTLIB_TEST_CASE(
+             &PiecewiseYieldCurveTest::testGlobalBootstrapConsistency));
+    suite->add(QUANTLIB_TEST_CASE(
+             &PiecewiseYieldCurveTest::testGlobalBootstrapSensitivities));
+    suite->add(QUANTLIB_TEST_CASE(
+             &PiecewiseYieldCurveTest::testIncrementalBootstrap));
+    suite->add(QUANTLIB_TEST_CASE(
+             &PiecewiseYieldCurveTest::testMultiCurveBootstrap));
+    suite->add(QUANTLIB_TEST_CASE(
+             &PiecewiseYieldCurveTest::testBatchedDiscounts));
 
     suite->add(QUANTLIB_TEST_CASE(&PiecewiseYieldCurveTest::testObservability));
     suite->add(QUANTLIB_TEST_CASE(&PiecewiseYieldCurveTest::testLiborFixing));
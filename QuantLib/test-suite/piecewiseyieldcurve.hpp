@@ -41,6 +41,11 @@ class PiecewiseYieldCurveTest {
 
     static void testConvexMonotoneForwardConsistency();
     static void testLocalBootstrapConsistency();
+    static void testGlobalBootstrapConsistency();
+    static void testGlobalBootstrapSensitivities();
+    static void testIncrementalBootstrap();
+    static void testMultiCurveBootstrap();
+    static void testBatchedDiscounts();
 
     static void testObservability();
     static void testLiborFixing();
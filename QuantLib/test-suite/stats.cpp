@@ -27,6 +27,7 @@
 #include <ql/math/statistics/gaussianstatistics.hpp>
 #include <ql/math/statistics/sequencestatistics.hpp>
 #include <ql/math/statistics/convergencestatistics.hpp>
+#include <ql/math/statistics/streamingstatistics.hpp>
 #include <ql/math/randomnumbers/mt19937uniformrng.hpp>
 #include <ql/math/randomnumbers/inversecumulativerng.hpp>
 #include <ql/math/distributions/normaldistribution.hpp>
@@ -124,6 +125,7 @@ void StatisticsTest::testStatistics() {
     check<IncrementalStatistics>(
         std::string("IncrementalStatistics"));
     check<Statistics>(std::string("Statistics"));
+    check<StreamingRiskStatistics>(std::string("StreamingStatistics"));
 }
 
 
@@ -244,6 +246,8 @@ void StatisticsTest::testSequenceStatistics() {
     checkSequence<IncrementalStatistics>(
         std::string("IncrementalStatistics"),5);
     checkSequence<Statistics>(std::string("Statistics"),5);
+    checkSequence<StreamingRiskStatistics>(
+        std::string("StreamingStatistics"),5);
 }
 
 
@@ -389,11 +393,89 @@ void StatisticsTest::testIncrementalStatistics() {
                                  << tol);
 }
 
+namespace {
+
+    void checkStreaming(const std::string& name,
+                        const StreamingRiskStatistics& calculated,
+                        const Statistics& expected) {
+
+        #define CHECK_STREAMING(expr, tolerance) \
+        if (std::fabs(calculated.expr-expected.expr) > tolerance) \
+            BOOST_ERROR(name << ": wrong " << #expr << "\n" \
+                        << std::setprecision(12) \
+                        << "    calculated: " << calculated.expr << "\n" \
+                        << "    expected:   " << expected.expr);
+
+        if (calculated.samples() != expected.samples())
+            BOOST_ERROR(name << ": wrong number of samples\n"
+                        << "    calculated: " << calculated.samples() << "\n"
+                        << "    expected:   " << expected.samples());
+
+        // moments are exact up to rounding
+        CHECK_STREAMING(weightSum(), 1.0e-7);
+        CHECK_STREAMING(mean(), 1.0e-10);
+        CHECK_STREAMING(variance(), 1.0e-10);
+        CHECK_STREAMING(skewness(), 1.0e-10);
+        CHECK_STREAMING(kurtosis(), 1.0e-10);
+        CHECK_STREAMING(min(), 0.0);
+        CHECK_STREAMING(max(), 0.0);
+
+        // tails are stored exactly
+        CHECK_STREAMING(percentile(0.005), 1.0e-12);
+        CHECK_STREAMING(percentile(0.99), 1.0e-12);
+        CHECK_STREAMING(topPercentile(0.01), 1.0e-12);
+        CHECK_STREAMING(valueAtRisk(0.99), 1.0e-12);
+        CHECK_STREAMING(expectedShortfall(0.99), 1.0e-10);
+        CHECK_STREAMING(shortfall(-0.35), 1.0e-12);
+
+        // the center of the distribution is approximated
+        CHECK_STREAMING(percentile(0.5), 1.0e-3);
+        CHECK_STREAMING(percentile(0.25), 1.0e-3);
+        CHECK_STREAMING(percentile(0.9), 1.0e-3);
+
+        #undef CHECK_STREAMING
+    }
+
+}
+
+
+void StatisticsTest::testStreamingStatistics() {
+
+    BOOST_TEST_MESSAGE("Testing streaming statistics...");
+
+    // the default tail buffers hold more than 1% of the samples
+    const Size samples = 50000, parts = 4;
+
+    MersenneTwisterUniformRng mt(42);
+    InverseCumulativeRng<MersenneTwisterUniformRng,
+                         InverseCumulativeNormal> gen(mt);
+
+    Statistics expected;
+    StreamingRiskStatistics calculated;
+    std::vector<StreamingRiskStatistics> partial(parts);
+    for (Size i=0; i<samples; ++i) {
+        Real x = 0.1 + 0.2*gen.next().value;
+        Real w = 0.5 + mt.nextReal();
+        expected.add(x, w);
+        calculated.add(x, w);
+        partial[i % parts].add(x, w);
+    }
+
+    checkStreaming("single accumulator", calculated, expected);
+
+    StreamingRiskStatistics merged;
+    for (Size i=0; i<parts; ++i)
+        merged.merge(partial[i]);
+
+    checkStreaming("merged accumulators", merged, expected);
+}
+
 test_suite* StatisticsTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Statistics tests");
     suite->add(QUANTLIB_TEST_CASE(&StatisticsTest::testStatistics));
     suite->add(QUANTLIB_TEST_CASE(&StatisticsTest::testSequenceStatistics));
     suite->add(QUANTLIB_TEST_CASE(&StatisticsTest::testConvergenceStatistics));
     suite->add(QUANTLIB_TEST_CASE(&StatisticsTest::testIncrementalStatistics));
+    suite->add(QUANTLIB_TEST_CASE(&StatisticsTest::testStreamingStatistics));
     return suite;
 }